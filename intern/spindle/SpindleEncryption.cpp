@@ -33,6 +33,28 @@
 #include <fstream>
 #include <iostream>
 #include <cstdlib>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+/* One pass of the cipher with a 16 bits part of a key, the data is split in pieces
+ * of pieceSize bits and all the bytes of a piece are shifted by the same value. */
+struct SpindleRound
+{
+	unsigned long long pieceSize;
+	unsigned long long offset;
+	int index;
+};
+
+struct SpindleCipher
+{
+	std::vector<SpindleRound> rounds;
+};
+
+/// Blocks smaller than this size are decrypted by the calling thread only.
+static const int parallelBlockSize = 1 << 20;
+/// Size of the blocks decrypted with all the rounds at once.
+static const unsigned long long cacheBlockSize = 1 << 15;
 
 char *staticKey = NULL;
 char *dynamicKey = NULL;
@@ -42,11 +64,15 @@ const unsigned int currentSupportedVersion = 0;
 // Static functions declaration
 // Encryption & Decryption
 static void spindle_encrypt(char *data, int dataSize, const unsigned long long key);
-static void spindle_decrypt(char *data, int dataSize, const unsigned long long key);
 static void spindle_encrypt_hex_64(char *data, int dataSize, const char *key);
-static void spindle_decrypt_hex_64(char *data, int dataSize, const char *key);
 static void spindle_encrypt_hex(char *data, int dataSize, const char *key);
-static void spindle_decrypt_hex(char *data, int dataSize, const char *key);
+static unsigned long long spindle_hex_to_key(const char *key);
+static void spindle_add_rounds(SpindleCipher *cipher, int dataSize, const unsigned long long key);
+static void spindle_decrypt_round(const SpindleRound& round, unsigned char *data,
+                                  unsigned long long start, unsigned long long end);
+static void spindle_decrypt_range(const SpindleCipher *cipher, unsigned char *data,
+                                  unsigned long long start, unsigned long long end);
+static void spindle_decrypt_data(char *data, int dataSize, int typeEncryption, const char *key);
 // Encryption keys
 static void spindle_set_static_encryption_key(const char *hexKey);
 static void spindle_set_dynamic_encryption_key(const char *hexKey);
@@ -118,7 +144,7 @@ char *SPINDLE_DecryptFromFile(const char *filename, int *fileSize, const char *e
 		inFile.read(fileData, *fileSize);
 		inFile.close();
 		if ((fileData[0] != 'B')||(fileData[1] != 'L')||(fileData[2] != 'E')||(fileData[3] != 'N')||(fileData[4] != 'D')) {
-			spindle_decrypt_hex(fileData, *fileSize, encryptKey);
+			spindle_decrypt_data(fileData, *fileSize, typeEncryption, encryptKey);
 			return fileData;
 		}
 		delete[] fileData;
@@ -132,22 +158,13 @@ char *SPINDLE_DecryptFromFile(const char *filename, int *fileSize, const char *e
 			inFile.close();
 			return fileData;
 		}
-		else if (typeEncryption == SPINDLE_STATIC_ENCRYPTION) {
-			inFile.seekg(5, std::ios::beg);
-			*fileSize -= 5;
-			char *fileData = new char[*fileSize];
-			inFile.read(fileData, *fileSize);
-			inFile.close();
-			spindle_decrypt_hex(fileData, *fileSize, staticKey);
-			return fileData;
-		}
-		else if (typeEncryption == SPINDLE_DYNAMIC_ENCRYPTION) {
-			inFile.seekg(5, std::ios::beg);
-			*fileSize -= 5;
+		else if ((typeEncryption == SPINDLE_STATIC_ENCRYPTION) || (typeEncryption == SPINDLE_DYNAMIC_ENCRYPTION)) {
+			inFile.seekg(SPINDLE_HEADER_SIZE, std::ios::beg);
+			*fileSize -= SPINDLE_HEADER_SIZE;
 			char *fileData = new char[*fileSize];
 			inFile.read(fileData, *fileSize);
 			inFile.close();
-			spindle_decrypt_hex(fileData, *fileSize, dynamicKey);
+			spindle_decrypt_data(fileData, *fileSize, typeEncryption, NULL);
 			return fileData;
 		}
 		else {
@@ -156,6 +173,75 @@ char *SPINDLE_DecryptFromFile(const char *filename, int *fileSize, const char *e
 	}
 }
 
+SpindleCipher *SPINDLE_CipherCreate(int typeEncryption, const char *encryptKey, int dataSize)
+{
+	const char *key = encryptKey;
+	if (key == NULL) {
+		if (typeEncryption == SPINDLE_STATIC_ENCRYPTION)
+			key = staticKey;
+		else if (typeEncryption == SPINDLE_DYNAMIC_ENCRYPTION)
+			key = dynamicKey;
+	}
+	if (key == NULL)
+		return NULL;
+
+	SpindleCipher *cipher = new SpindleCipher();
+
+	/* Keys longer than 16 characters are split in 64 bits keys,
+	 * applied from the first to the last. */
+	const int keySize = spindle_secure_function_strlen(key);
+	if (keySize <= 16) {
+		spindle_add_rounds(cipher, dataSize, spindle_hex_to_key(key));
+	}
+	else {
+		char tempKey[17];
+		for (int charPos = 0; charPos < keySize; charPos += 16) {
+			const int size = std::min(16, keySize - charPos);
+			spindle_secure_function_memcpy(tempKey, (void *)&key[charPos], size);
+			tempKey[size] = 0;
+			spindle_add_rounds(cipher, dataSize, spindle_hex_to_key(tempKey));
+		}
+		spindle_secure_function_memset(tempKey, 0, sizeof(tempKey));
+	}
+
+	return cipher;
+}
+
+void SPINDLE_CipherFree(SpindleCipher *cipher)
+{
+	delete cipher;
+}
+
+void SPINDLE_DecryptBlock(const SpindleCipher *cipher, char *data, long long offset, int size)
+{
+	if (size <= 0)
+		return;
+
+	unsigned char *bytes = (unsigned char *)data;
+	const unsigned long long start = offset;
+	const unsigned long long end = start + size;
+
+	const int numThreads = std::min((int)std::thread::hardware_concurrency(), size / parallelBlockSize);
+	if (numThreads <= 1) {
+		spindle_decrypt_range(cipher, bytes, start, end);
+		return;
+	}
+
+	// Each thread decrypts a contiguous part of the block, the calling thread the last one.
+	const unsigned long long partSize = (size + numThreads - 1) / numThreads;
+	std::vector<std::thread> threads;
+	for (int i = 0; i < numThreads - 1; i++) {
+		const unsigned long long partStart = start + i * partSize;
+		threads.emplace_back(spindle_decrypt_range, cipher, bytes + i * partSize, partStart, partStart + partSize);
+	}
+	const unsigned long long lastStart = start + (numThreads - 1) * partSize;
+	spindle_decrypt_range(cipher, bytes + (numThreads - 1) * partSize, lastStart, end);
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
 int SPINDLE_CheckEncryptionFromFile(const char *filepath)
 {
 	int keyType = SPINDLE_NO_ENCRYPTION; // -1 = invalid, 0 = blend, 1 = static key, 2 = dynamic key
@@ -253,47 +339,68 @@ static void spindle_encrypt(char *data, int dataSize, const unsigned long long k
 	}
 }
 
-static void spindle_decrypt(char *data, int dataSize, const unsigned long long key)
+
+/* The decryption only subtracts from each byte a value depending on its position and
+ * the size of the data, any block of the data can then be decrypted independently. */
+static void spindle_add_rounds(SpindleCipher *cipher, int dataSize, const unsigned long long key)
 {
 	const int keySize = sizeof(key) * 8;
-	unsigned long long pieceSize, offset, chunkSize = 0, max = ((unsigned long long)(dataSize) << 3);
-	unsigned int p, t, ii;
-	unsigned long long i;
+	unsigned int p;
 	int iii;
-	char h;
 
 	for (iii = (keySize >> 4) - 1; iii >= 0; iii--) {
 		p = iii * 16;
-		pieceSize = (((key >> p) % (1 << 8)) + 3) * (dataSize / 256 / 400 + 1);
-		offset = ((key >> (p + 8)) % (1 << 8));
-		if (offset == 0) {
-			offset++;
+		SpindleRound round;
+		round.pieceSize = (((key >> p) % (1 << 8)) + 3) * (dataSize / 256 / 400 + 1);
+		round.offset = ((key >> (p + 8)) % (1 << 8));
+		if (round.offset == 0) {
+			round.offset++;
 		}
-		chunkSize = pieceSize;
-		//cout << "(Decrypt) pieceSize: " << pieceSize << " offset: " << offset << " " << p << "\n";
-		for (i = 0; i < max; i += chunkSize) {
-			if (i + chunkSize >= max ) {
-				chunkSize = (((unsigned long long)(dataSize)) << 3) - i;
-			}
-			//cout << "   N: " << i << " " << i + chunkSize << "\n";
-			t = (unsigned int)(((unsigned long long)(i + chunkSize)) >> 3);
-			ii = (unsigned int)(i >> 3);
-			h = ((char)offset) * ((char)i) + ((char)i) - ((char)(pieceSize&i)) + (((char)(offset)) | ((char)(i))) + ((((char)(iii)) | pieceSize)&255);
-			while (ii < t) {
-				data[ii] -= h + (((char)offset) | ((char)ii));
-				ii++;
-			}
+		round.index = iii;
+		cipher->rounds.push_back(round);
+	}
+}
+
+static void spindle_decrypt_round(const SpindleRound& round, unsigned char *data,
+                                  unsigned long long start, unsigned long long end)
+{
+	const unsigned long long pieceSize = round.pieceSize;
+	const unsigned long long offset = round.offset;
+	const int iii = round.index;
+	const unsigned char offsetByte = (unsigned char)offset;
+	unsigned char *bytes = data - start;
+
+	// Bit position of the piece containing the first byte.
+	unsigned long long i = ((start << 3) + 7) / pieceSize * pieceSize;
+	unsigned long long ii = start;
+	while (ii < end) {
+		const unsigned long long t = std::min((i + pieceSize) >> 3, end);
+		const char h = ((char)offset) * ((char)i) + ((char)i) - ((char)(pieceSize&i)) + (((char)(offset)) | ((char)(i))) + ((((char)(iii)) | pieceSize)&255);
+		const unsigned char hByte = (unsigned char)h;
+		// Without dependency between bytes, the compiler can vectorize this loop.
+		for (; ii < t; ii++) {
+			bytes[ii] -= (unsigned char)(hByte + (offsetByte | (unsigned char)ii));
 		}
-		chunkSize = pieceSize;
+		i += pieceSize;
 	}
 }
 
-static void spindle_encrypt_hex_64(char *data, int dataSize, const char *key)
+static void spindle_decrypt_range(const SpindleCipher *cipher, unsigned char *data,
+                                  unsigned long long start, unsigned long long end)
+{
+	// All the rounds are applied to a small block at once to keep it in the cache.
+	for (unsigned long long blockStart = start; blockStart < end; blockStart += cacheBlockSize) {
+		const unsigned long long blockEnd = std::min(blockStart + cacheBlockSize, end);
+		for (const SpindleRound& round : cipher->rounds) {
+			spindle_decrypt_round(round, data + (blockStart - start), blockStart, blockEnd);
+		}
+	}
+}
+
+static unsigned long long spindle_hex_to_key(const char *key)
 {
 	int keySize = 0, i;
 	unsigned long long realKey = 0, s;
-	if (key == NULL)
-		return;
 	keySize = spindle_secure_function_strlen(key);
 	for (i = 0; i < keySize; i++) {
 		s = keySize - 1 - i;
@@ -306,30 +413,17 @@ static void spindle_encrypt_hex_64(char *data, int dataSize, const char *key)
 		else
 			realKey += ((unsigned long long)(key[i]) << (s << 2));
 	}
-	spindle_encrypt(data, dataSize, realKey);
+	return realKey;
 }
 
-static void spindle_decrypt_hex_64(char *data, int dataSize, const char *key)
+static void spindle_encrypt_hex_64(char *data, int dataSize, const char *key)
 {
-	int keySize = 0, i;
-	unsigned long long realKey = 0, s;
 	if (key == NULL)
 		return;
-	keySize = spindle_secure_function_strlen(key);
-	for (i = 0; i < keySize; i++) {
-		s = keySize - 1 - i;
-		if ((key[i] >= '0') && (key[i] <= '9'))
-			realKey += ((unsigned long long)(key[i] - '0') << (s << 2));
-		else if ((key[i] >= 'a') && (key[i] <= 'f'))
-			realKey += ((unsigned long long)(key[i] - 'a' + 10) << (s << 2));
-		else if ((key[i] >= 'A') && (key[i] <= 'F'))
-			realKey += ((unsigned long long)(key[i] - 'A' + 10) << (s << 2));
-		else
-			realKey += ((unsigned long long)(key[i]) << (s << 2));
-	}
-	spindle_decrypt(data, dataSize, realKey);
+	spindle_encrypt(data, dataSize, spindle_hex_to_key(key));
 }
 
+
 static void spindle_encrypt_hex(char *data, int dataSize, const char *key)
 {
 	int keySize = 0, charPos, i;
@@ -355,26 +449,13 @@ static void spindle_encrypt_hex(char *data, int dataSize, const char *key)
 	}
 }
 
-static void spindle_decrypt_hex(char *data, int dataSize, const char *key)
+static void spindle_decrypt_data(char *data, int dataSize, int typeEncryption, const char *key)
 {
-	int keySize = 0, charPos = 0, i;
-	if (key == NULL)
+	SpindleCipher *cipher = SPINDLE_CipherCreate(typeEncryption, key, dataSize);
+	if (cipher == NULL)
 		return;
-	keySize = spindle_secure_function_strlen(key);
-	if (keySize <= 16) {
-		spindle_decrypt_hex_64(data, dataSize, key);
-	}
-	else {
-		char tempKey[17];
-		tempKey[16] = 0;
-		while (charPos < keySize) {
-			for (i = 0; ((i < 16) && (i < keySize)); i++) {
-				tempKey[i] = key[i + charPos];
-			}
-			charPos += 16;
-			spindle_decrypt_hex_64(data, dataSize, tempKey);
-		}
-	}
+	SPINDLE_DecryptBlock(cipher, data, 0, dataSize);
+	SPINDLE_CipherFree(cipher);
 }
 
 static void spindle_set_static_encryption_key(const char *hexKey)
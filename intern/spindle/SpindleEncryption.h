@@ -36,6 +36,9 @@
 #define SPINDLE_STATIC_ENCRYPTION	1
 #define SPINDLE_DYNAMIC_ENCRYPTION	2
 
+/* Size of the header preceding the encrypted data in static and dynamic encrypted files. */
+#define SPINDLE_HEADER_SIZE			5
+
 
 #ifdef __cplusplus
 #include <string>
@@ -44,11 +47,22 @@ void SPINDLE_SetFilePath(std::string path);
 
 extern "C" {
 #endif
+/* Key stream of encrypted data, used to decrypt it block by block. */
+typedef struct SpindleCipher SpindleCipher;
+
 char *SPINDLE_DecryptFromFile(const char *filename, int *fileSize, const char *encryptKey, int typeEncryption);
 int SPINDLE_CheckEncryptionFromFile(const char *filepath);
 void SPINDLE_SetFilePath(const char *filepath);
 const char *SPINDLE_GetFilePath(void);
 
+/* Create the key stream of dataSize bytes encrypted with encryptKey, or if NULL with
+ * the static or dynamic key depending on typeEncryption. Return NULL without key. */
+SpindleCipher *SPINDLE_CipherCreate(int typeEncryption, const char *encryptKey, int dataSize);
+void SPINDLE_CipherFree(SpindleCipher *cipher);
+/* Decrypt in place size bytes starting at offset in the encrypted data,
+ * the blocks can be decrypted in any order and large blocks are decrypted in parallel. */
+void SPINDLE_DecryptBlock(const SpindleCipher *cipher, char *data, long long offset, int size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -380,6 +380,15 @@ class SCENE_PT_game_physics(SceneButtonsPanel, Panel):
             sub = col.row()
             sub.prop(gs, "deactivation_time", text="Time")
 
+            col = layout.column()
+            col.prop(gs, "use_occlusion_culling", text="Culling")
+            sub = col.column()
+            sub.active = gs.use_occlusion_culling
+            sub.prop(gs, "occlusion_culling_resolution", text="Occlusion Resolution")
+
+            col = layout.column()
+            col.prop(gs, "use_character_batching")
+
         else:
             split = layout.split()
 
@@ -474,6 +483,10 @@ class SCENE_PT_game_navmesh(SceneButtonsPanel, Panel):
         row.prop(rd, "sample_dist")
         row.prop(rd, "sample_max_error")
 
+        col = layout.column()
+        col.label(text="Runtime:")
+        col.prop(rd, "tile_size")
+
 
 class SCENE_PT_game_hysteresis(SceneButtonsPanel, Panel):
     bl_label = "Level of Detail"
@@ -98,6 +98,8 @@ class RENDER_PT_game_resolution(RenderButtonsPanel, Panel):
         row = layout.row()
         col = row.column()
         col.prop(gs, "use_viewport_render")
+        col.prop(gs, "use_batch_skinning")
+        col.prop(gs, "use_action_baking")
 
 class RENDER_PT_game_debug(RenderButtonsPanel, Panel):
     bl_label = "Game Debug"
@@ -112,6 +114,9 @@ class RENDER_PT_game_debug(RenderButtonsPanel, Panel):
         row = col.row()
         col = row.column()
         col.prop(gs, "use_frame_rate")
+        sub = col.column()
+        sub.active = gs.use_frame_rate
+        sub.prop(gs, "use_transform_interpolation")
 
         row = layout.row()
         row.prop(gs, "vsync")
@@ -1182,6 +1182,77 @@ static int fd_read_gzip_from_file(FileData *filedata, void *buffer, uint size)
   return (readsize);
 }
 
+#ifdef WITH_GAMEENGINE_BPPLAYER
+/* Encrypted file reading, the data is decrypted block by block as it is read. */
+
+static int fd_read_spindle_from_file(FileData *filedata, void *buffer, uint size)
+{
+  int readsize = read(filedata->filedes, buffer, size);
+
+  if (readsize < 0) {
+    readsize = EOF;
+  }
+  else {
+    SPINDLE_DecryptBlock(filedata->spindle, buffer, filedata->file_offset, readsize);
+    filedata->file_offset += readsize;
+  }
+
+  return (readsize);
+}
+
+static off64_t fd_seek_spindle_from_file(FileData *filedata, off64_t offset, int whence)
+{
+  /* Offsets are relative to the encrypted data, after the header. */
+  if (whence == SEEK_SET) {
+    offset += SPINDLE_HEADER_SIZE;
+  }
+
+  const off64_t seek = lseek(filedata->filedes, offset, whence);
+  filedata->file_offset = (seek == -1) ? -1 : seek - SPINDLE_HEADER_SIZE;
+  return filedata->file_offset;
+}
+
+/* Size of the encrypted chunks decrypted before their decompression. */
+#define SPINDLE_GZIP_CHUNK_SIZE (64 * 1024)
+
+static int fd_read_spindle_gzip_from_file(FileData *filedata, void *buffer, uint size)
+{
+  z_stream *strm = &filedata->strm;
+
+  strm->next_out = (Bytef *)buffer;
+  strm->avail_out = size;
+
+  while (strm->avail_out > 0) {
+    if (strm->avail_in == 0) {
+      /* Offset in the encrypted data, after the header. */
+      const off64_t offset = lseek(filedata->filedes, 0, SEEK_CUR) - SPINDLE_HEADER_SIZE;
+      char *chunk = (char *)filedata->buffer;
+      const int readsize = read(filedata->filedes, chunk, SPINDLE_GZIP_CHUNK_SIZE);
+      if (readsize <= 0) {
+        break;
+      }
+      SPINDLE_DecryptBlock(filedata->spindle, chunk, offset, readsize);
+      strm->next_in = (Bytef *)chunk;
+      strm->avail_in = readsize;
+    }
+
+    const int err = inflate(strm, Z_SYNC_FLUSH);
+    if (err == Z_STREAM_END) {
+      break;
+    }
+    else if (err != Z_OK) {
+      printf("fd_read_spindle_gzip_from_file: zlib error\n");
+      return 0;
+    }
+  }
+
+  const int readsize = size - strm->avail_out;
+  filedata->file_offset += readsize;
+
+  return readsize;
+}
+#endif  // WITH_GAMEENGINE_BPPLAYER
+
 /* Memory reading. */
 
 static int fd_read_from_memory(FileData *filedata, void *buffer, uint size)
@@ -1375,10 +1446,64 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
 #ifdef WITH_GAMEENGINE_BPPLAYER
     }
     else {
-      int filesize = 0;
-      const char *decrypteddata = SPINDLE_DecryptFromFile(filepath, &filesize, NULL, typeencryption);
+      /* Encrypted file, never loaded entirely in memory. */
+      const size_t filesize = BLI_file_descriptor_size(file);
+      SpindleCipher *cipher = SPINDLE_CipherCreate(
+          typeencryption, NULL, (int)(filesize - SPINDLE_HEADER_SIZE));
+      errno = 0;
+      if ((cipher == NULL) || (lseek(file, SPINDLE_HEADER_SIZE, SEEK_SET) == -1)) {
+        BKE_reportf(reports,
+                    RPT_WARNING,
+                    "Unable to read '%s': %s",
+                    filepath,
+                    errno ? strerror(errno) : TIP_("invalid encrypted file"));
+        if (cipher) {
+          SPINDLE_CipherFree(cipher);
+        }
+        return NULL;
+      }
       SPINDLE_SetFilePath(filepath);
-      return blo_filedata_from_memory(decrypteddata, filesize, reports);
+
+      /* Check the gzip header magic of the decrypted data. */
+      char magic[2] = {0, 0};
+      if (read(file, magic, sizeof(magic)) == sizeof(magic)) {
+        SPINDLE_DecryptBlock(cipher, magic, 0, sizeof(magic));
+      }
+      lseek(file, SPINDLE_HEADER_SIZE, SEEK_SET);
+
+      FileData *fd = filedata_new();
+
+      fd->filedes = file;
+      fd->spindle = cipher;
+
+      if (magic[0] == 0x1f && magic[1] == (char)0x8b) {
+        /* Gzip file, decompressed from the decrypted chunks. */
+        fd->buffer = MEM_mallocN(SPINDLE_GZIP_CHUNK_SIZE, "spindle gzip chunk");
+        fd->buffersize = SPINDLE_GZIP_CHUNK_SIZE;
+        fd->strm.next_in = (Bytef *)fd->buffer;
+        fd->strm.avail_in = 0;
+        fd->strm.total_out = 0;
+        fd->strm.zalloc = Z_NULL;
+        fd->strm.zfree = Z_NULL;
+
+        if (inflateInit2(&fd->strm, (16 + MAX_WBITS)) != Z_OK) {
+          BKE_reportf(reports, RPT_WARNING, "Unable to read '%s': %s", filepath, TIP_("zlib error"));
+          /* The caller closes the file. */
+          fd->filedes = -1;
+          fd->strm.next_in = NULL;
+          blo_filedata_free(fd);
+          return NULL;
+        }
+
+        /* 'seek_fn' is too slow for gzip, don't set it. */
+        fd->read = fd_read_spindle_gzip_from_file;
+      }
+      else {
+        fd->read = fd_read_spindle_from_file;
+        fd->seek = fd_seek_spindle_from_file;
+      }
+
+      return fd;
   }
 #endif
 
@@ -1544,6 +1669,12 @@ void blo_filedata_free(FileData *fd)
       }
     }
 
+#ifdef WITH_GAMEENGINE_BPPLAYER
+    if (fd->spindle) {
+      SPINDLE_CipherFree(fd->spindle);
+    }
+#endif
+
     if (fd->buffer && !(fd->flags & FD_FLAGS_NOT_MY_BUFFER)) {
       MEM_freeN((void *)fd->buffer);
       fd->buffer = NULL;
@@ -81,6 +81,8 @@ typedef struct FileData {
 	gzFile gzfiledes;
 	/** Gzip stream for memory decompression. */
 	z_stream strm;
+	/** Key stream of an encrypted runtime file, decrypted while reading. */
+	struct SpindleCipher *spindle;
 
 	/** Now only in use for library appending. */
 	char relabase[FILE_MAX];
@@ -2953,7 +2953,7 @@ void DRW_game_render_loop(bContext *C, GPUViewport *viewport, Main *bmain, Scene
     DEG_OBJECT_ITER_FOR_RENDER_ENGINE_BEGIN (depsgraph, ob) {
       Object *orig_ob = DEG_get_original_object(ob);
 
-      if (orig_ob->gameflag & OB_OVERLAY_COLLECTION) {
+      if ((orig_ob->gameflag & OB_OVERLAY_COLLECTION) && !(orig_ob->gameflag & OB_CULLED)) {
         drw_engines_cache_populate(ob);
       }
     }
@@ -2961,6 +2961,12 @@ void DRW_game_render_loop(bContext *C, GPUViewport *viewport, Main *bmain, Scene
   }
   else {
     DEG_OBJECT_ITER_FOR_RENDER_ENGINE_BEGIN (depsgraph, ob) {
+      Object *orig_ob = DEG_get_original_object(ob);
+
+      /* Culled by the game engine for this camera. */
+      if (orig_ob->gameflag & OB_CULLED) {
+        continue;
+      }
       drw_engines_cache_populate(ob);
     }
     DEG_OBJECT_ITER_FOR_RENDER_ENGINE_END;
@@ -1109,13 +1109,19 @@ static void draw_sensor_mouse(uiLayout *layout, PointerRNA *ptr, bContext *C)
 
 static void draw_sensor_near(uiLayout *layout, PointerRNA *ptr)
 {
-	uiLayout *row;
+	uiLayout *row, *sub;
 
 	uiItemR(layout, ptr, "property", 0, NULL, ICON_NONE);
 
 	row = uiLayoutRow(layout, true);
 	uiItemR(row, ptr, "distance", 0, NULL, ICON_NONE);
 	uiItemR(row, ptr, "reset_distance", 0, NULL, ICON_NONE);
+
+	row = uiLayoutRow(layout, false);
+	uiItemR(row, ptr, "use_query", 0, NULL, ICON_NONE);
+	sub = uiLayoutRow(row, false);
+	uiLayoutSetActive(sub, RNA_boolean_get(ptr, "use_query"));
+	uiItemR(sub, ptr, "query_skip", 0, NULL, ICON_NONE);
 }
 
 static void draw_sensor_property(uiLayout *layout, PointerRNA *ptr)
@@ -1148,7 +1154,7 @@ static void draw_sensor_property(uiLayout *layout, PointerRNA *ptr)
 
 static void draw_sensor_radar(uiLayout *layout, PointerRNA *ptr)
 {
-	uiLayout *row;
+	uiLayout *row, *sub;
 
 	uiItemR(layout, ptr, "property", 0, NULL, ICON_NONE);
 	uiItemR(layout, ptr, "axis", 0, NULL, ICON_NONE);
@@ -1156,6 +1162,12 @@ static void draw_sensor_radar(uiLayout *layout, PointerRNA *ptr)
 	row = uiLayoutRow(layout, false);
 	uiItemR(row, ptr, "angle", 0, NULL, ICON_NONE);
 	uiItemR(row, ptr, "distance", 0, NULL, ICON_NONE);
+
+	row = uiLayoutRow(layout, false);
+	uiItemR(row, ptr, "use_query", 0, NULL, ICON_NONE);
+	sub = uiLayoutRow(row, false);
+	uiLayoutSetActive(sub, RNA_boolean_get(ptr, "use_query"));
+	uiItemR(sub, ptr, "query_skip", 0, NULL, ICON_NONE);
 }
 
 static void draw_sensor_random(uiLayout *layout, PointerRNA *ptr)
@@ -740,6 +740,9 @@ enum {
   OB_RECORD_ANIMATION      = 1 << 23,
 
   OB_OVERLAY_COLLECTION    = 1 << 24,
+
+  /* Outside the view of the game camera being rendered, runtime only. */
+  OB_CULLED                = 1 << 25,
 };
 
 /* ob->gameflag2 */
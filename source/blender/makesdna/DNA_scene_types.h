@@ -831,7 +831,8 @@ typedef struct RecastData {
 	float detailsamplemaxerror;
 	char partitioning;
 	char _pad1;
-	short _pad2;
+	/* Tile width in cells for runtime tiled navigation meshes, 0 to use a single static mesh. */
+	short tilesize;
 } RecastData;
 
 /* RecastData.partitioning */
@@ -940,6 +941,11 @@ typedef struct GameData {
 #define GAME_USE_UNDO			            (1 << 19)
 #define GAME_USE_UI_ANTI_FLICKER			(1 << 20)
 #define GAME_USE_VIEWPORT_RENDER      (1 << 21)
+#define GAME_INTERPOLATE_TRANSFORMS			(1 << 22)
+#define GAME_USE_CULLING					(1 << 23)
+#define GAME_BATCH_CHARACTERS				(1 << 24)
+#define GAME_BATCH_SKINNING					(1 << 25)
+#define GAME_BAKE_ACTIONS					(1 << 26)
 /* Note: GameData.flag is now an int (max 32 flags). A short could only take 16 flags */
 
 /* GameData.playerflag */
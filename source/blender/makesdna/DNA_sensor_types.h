@@ -44,7 +44,9 @@ struct Material;
 typedef struct bNearSensor {
 	char name[64];	/* MAX_NAME */
 	float dist, resetdist;
-	int lastval, _pad;
+	int lastval;
+	/* skip: number of frames skipped between two queries */
+	short flag, skip;
 } bNearSensor;
 
 /**
@@ -118,6 +120,7 @@ typedef struct bRadarSensor {
 	float angle;
 	float range;
 	short flag, axis;
+	short skip, _pad;
 } bRadarSensor;
 
 typedef struct bRandomSensor {
@@ -219,6 +222,9 @@ typedef struct bJoystickSensor {
 #define SENS_RAY_NEG_Z_AXIS     5
 //#define SENS_RAY_NEGATIVE_AXIS     1
 
+/* bNearSensor->flag and bRadarSensor->flag */
+#define SENS_NEAR_QUERY		1
+
 /* bRadarSensor->axis */
 #define SENS_RADAR_X_AXIS     0
 #define SENS_RADAR_Y_AXIS     1
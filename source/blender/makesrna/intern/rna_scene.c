@@ -4788,6 +4788,16 @@ static void rna_def_scene_game_recast_data(BlenderRNA *brna)
   RNA_def_property_float_default(prop, 1.0f);
   RNA_def_property_ui_text(prop, "Max Sample Error", "Detail mesh simplification max sample error");
   RNA_def_property_update(prop, NC_SCENE, NULL);
+
+  prop = RNA_def_property(srna, "tile_size", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "tilesize");
+  RNA_def_property_range(prop, 0, 1024);
+  RNA_def_property_ui_range(prop, 0, 256, 8, -1);
+  RNA_def_property_int_default(prop, 0);
+  RNA_def_property_ui_text(prop, "Tile Size",
+                           "Width in cells of the tiles of navigation meshes rebuilt at runtime, "
+                           "0 to use a single static navigation mesh");
+  RNA_def_property_update(prop, NC_SCENE, NULL);
 }
 
 
@@ -5157,6 +5167,14 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
                            "Gravitational constant used for physics simulation in the game engine");
   RNA_def_property_update(prop, NC_SCENE, NULL);
 
+  prop = RNA_def_property(srna, "use_occlusion_culling", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_USE_CULLING);
+  RNA_def_property_ui_text(prop, "Culling",
+                           "Skip the render of the objects outside of the camera view, and "
+                           "of the objects hidden behind occluder objects. "
+                           "Culled objects don't cast shadows");
+  RNA_def_property_update(prop, NC_SCENE, NULL);
+
   prop = RNA_def_property(srna, "occlusion_culling_resolution", PROP_INT, PROP_PIXEL);
   RNA_def_property_int_sdna(prop, NULL, "occlusionRes");
   RNA_def_property_range(prop, 128.0, 1024.0);
@@ -5165,6 +5183,31 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
                            "Size of the occlusion buffer, use higher value for better precision (slower)");
   RNA_def_property_update(prop, NC_SCENE, NULL);
 
+  prop = RNA_def_property(srna, "use_character_batching", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_BATCH_CHARACTERS);
+  RNA_def_property_ui_text(prop, "Batch Characters",
+                           "Step all the character physics objects in one multithreaded pass, "
+                           "for crowds of characters. Characters don't sweep against each other "
+                           "but still push each other out on overlap");
+  RNA_def_property_update(prop, NC_SCENE, NULL);
+
+  prop = RNA_def_property(srna, "use_batch_skinning", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_BATCH_SKINNING);
+  RNA_def_property_ui_text(prop, "Batch Skinning",
+                           "Deform the meshes parented to armatures on multiple threads in the "
+                           "game engine, sharing the result between armatures playing the same "
+                           "action frame. Only vertex group deformation with up to 4 bones per "
+                           "vertex is supported");
+  RNA_def_property_update(prop, NC_SCENE, NULL);
+
+  prop = RNA_def_property(srna, "use_action_baking", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_BAKE_ACTIONS);
+  RNA_def_property_ui_text(prop, "Bake Actions",
+                           "Sample the armature actions at each frame before playing them and "
+                           "interpolate the poses between the samples, faster for many armatures "
+                           "but less accurate with non-linear keyframe interpolation");
+  RNA_def_property_update(prop, NC_SCENE, NULL);
+
   prop = RNA_def_property(srna, "fps", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, NULL, "ticrate");
   RNA_def_property_ui_range(prop, 1, 60, 1, 1);
@@ -5280,6 +5323,13 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
                            "Respect the frame rate from the Physics panel in the world properties "
                            "rather than rendering as many frames as possible");
 
+  prop = RNA_def_property(srna, "use_transform_interpolation", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_INTERPOLATE_TRANSFORMS);
+  RNA_def_property_ui_text(prop, "Interpolate Transforms",
+                           "Render every display frame with the object transforms interpolated "
+                           "between the last two logic frames, the logic and physics run at the "
+                           "FPS from the Physics panel (requires Use Frame Rate)");
+
   prop = RNA_def_property(srna, "use_deprecation_warnings", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_negative_sdna(prop, NULL, "flag", GAME_IGNORE_DEPRECATION_WARNINGS);
   RNA_def_property_ui_text(prop, "Deprecation Warnings",
@@ -385,6 +385,19 @@ static void rna_def_near_sensor(BlenderRNA *brna)
 	RNA_def_property_ui_text(prop, "Reset Distance", "The distance where the sensor forgets the actor");
 	RNA_def_property_range(prop, 0.0f, 10000.0f);
 	RNA_def_property_update(prop, NC_LOGIC, NULL);
+
+	prop = RNA_def_property(srna, "use_query", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "flag", SENS_NEAR_QUERY);
+	RNA_def_property_ui_text(prop, "Query", "Test the overlapping objects only when the sensor is evaluated "
+	                         "instead of keeping the sensor shape in the physics broadphase");
+	RNA_def_property_update(prop, NC_LOGIC, NULL);
+
+	prop = RNA_def_property(srna, "query_skip", PROP_INT, PROP_NONE);
+	RNA_def_property_int_sdna(prop, NULL, "skip");
+	RNA_def_property_ui_text(prop, "Query Skip", "Number of frames skipped between two queries, "
+	                         "the queries of the sensors are staggered over the skipped frames");
+	RNA_def_property_range(prop, 0, 1000);
+	RNA_def_property_update(prop, NC_LOGIC, NULL);
 }
 
 static void rna_def_mouse_sensor(BlenderRNA *brna)
@@ -716,6 +729,19 @@ static void rna_def_radar_sensor(BlenderRNA *brna)
 	RNA_def_property_range(prop, 0.0, 10000.0);
 	RNA_def_property_ui_text(prop, "Distance", "Depth of the radar cone");
 	RNA_def_property_update(prop, NC_LOGIC, NULL);
+
+	prop = RNA_def_property(srna, "use_query", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "flag", SENS_NEAR_QUERY);
+	RNA_def_property_ui_text(prop, "Query", "Test the overlapping objects only when the sensor is evaluated "
+	                         "instead of keeping the sensor shape in the physics broadphase");
+	RNA_def_property_update(prop, NC_LOGIC, NULL);
+
+	prop = RNA_def_property(srna, "query_skip", PROP_INT, PROP_NONE);
+	RNA_def_property_int_sdna(prop, NULL, "skip");
+	RNA_def_property_ui_text(prop, "Query Skip", "Number of frames skipped between two queries, "
+	                         "the queries of the sensors are staggered over the skipped frames");
+	RNA_def_property_range(prop, 0, 1000);
+	RNA_def_property_update(prop, NC_LOGIC, NULL);
 }
 
 static void rna_def_random_sensor(BlenderRNA *brna)
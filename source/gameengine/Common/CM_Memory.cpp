@@ -0,0 +1,139 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Common/CM_Memory.cpp
+ *  \ingroup common
+ */
+
+#include "CM_Memory.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace {
+
+struct CategoryCounter
+{
+	std::atomic<size_t> current;
+	std::atomic<size_t> peak;
+};
+
+CategoryCounter categories[CM_MEMORY_CATEGORY_MAX];
+
+std::mutex librariesMutex;
+std::map<std::string, CM_MemoryStats> libraries;
+
+const char *categoryNames[CM_MEMORY_CATEGORY_MAX] = {
+	"DisplayArray",
+	"PhysicsShape",
+	"ReplicaID",
+	"PythonProxy",
+	"Library",
+	"Video"
+};
+
+}
+
+void CM_MemoryAdd(CM_MemoryCategory category, size_t size)
+{
+	CategoryCounter& counter = categories[category];
+	const size_t current = counter.current.fetch_add(size) + size;
+
+	size_t peak = counter.peak.load();
+	while (current > peak && !counter.peak.compare_exchange_weak(peak, current)) {
+	}
+}
+
+void CM_MemoryRemove(CM_MemoryCategory category, size_t size)
+{
+	CategoryCounter& counter = categories[category];
+	size_t current = counter.current.load();
+	// Clamp to zero in case of an accounting started after the allocation.
+	while (!counter.current.compare_exchange_weak(current, (current > size) ? current - size : 0)) {
+	}
+}
+
+void CM_MemoryUpdate(CM_MemoryCategory category, size_t oldsize, size_t newsize)
+{
+	if (newsize > oldsize) {
+		CM_MemoryAdd(category, newsize - oldsize);
+	}
+	else if (newsize < oldsize) {
+		CM_MemoryRemove(category, oldsize - newsize);
+	}
+}
+
+CM_MemoryStats CM_MemoryGetStats(CM_MemoryCategory category)
+{
+	const CategoryCounter& counter = categories[category];
+	return {counter.current.load(), counter.peak.load()};
+}
+
+const char *CM_MemoryGetName(CM_MemoryCategory category)
+{
+	return categoryNames[category];
+}
+
+void CM_MemoryAddLibrary(const std::string& name, size_t size)
+{
+	{
+		std::lock_guard<std::mutex> lock(librariesMutex);
+		CM_MemoryStats& stats = libraries[name];
+		stats.current += size;
+		if (stats.current > stats.peak) {
+			stats.peak = stats.current;
+		}
+	}
+
+	CM_MemoryAdd(CM_MEMORY_LIBRARY, size);
+}
+
+void CM_MemoryRemoveLibrary(const std::string& name)
+{
+	size_t size = 0;
+	{
+		std::lock_guard<std::mutex> lock(librariesMutex);
+		std::map<std::string, CM_MemoryStats>::iterator it = libraries.find(name);
+		if (it == libraries.end()) {
+			return;
+		}
+		size = it->second.current;
+		it->second.current = 0;
+	}
+
+	CM_MemoryRemove(CM_MEMORY_LIBRARY, size);
+}
+
+std::map<std::string, CM_MemoryStats> CM_MemoryGetLibraryStats()
+{
+	std::lock_guard<std::mutex> lock(librariesMutex);
+	return libraries;
+}
+
+void CM_MemoryReset()
+{
+	for (CategoryCounter& counter : categories) {
+		counter.current = 0;
+		counter.peak = 0;
+	}
+
+	std::lock_guard<std::mutex> lock(librariesMutex);
+	libraries.clear();
+}
@@ -0,0 +1,77 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CM_Memory.h
+ *  \ingroup common
+ *  \brief Tagged memory accounting of the game engine subsystems.
+ *
+ * The subsystems report the size of the data they own when it is created and
+ * freed, the registry keeps the current and peak bytes per category and per
+ * library loaded with LibLoad. The values are estimations used to guide memory
+ * optimisations, MEM_get_memory_in_use() stays the reference for total usage.
+ */
+
+#ifndef __CM_MEMORY_H__
+#define __CM_MEMORY_H__
+
+#include <cstddef>
+#include <string>
+#include <map>
+
+enum CM_MemoryCategory {
+	CM_MEMORY_DISPLAY_ARRAY = 0,
+	CM_MEMORY_PHYSICS_SHAPE,
+	CM_MEMORY_REPLICA_ID,
+	CM_MEMORY_PYTHON_PROXY,
+	CM_MEMORY_LIBRARY,
+	CM_MEMORY_VIDEO,
+	CM_MEMORY_CATEGORY_MAX
+};
+
+struct CM_MemoryStats
+{
+	size_t current;
+	size_t peak;
+};
+
+/// Register size bytes allocated for a category, thread safe.
+void CM_MemoryAdd(CM_MemoryCategory category, size_t size);
+/// Unregister size bytes freed for a category, thread safe.
+void CM_MemoryRemove(CM_MemoryCategory category, size_t size);
+/// Move the accounting of a category by the difference between two sizes.
+void CM_MemoryUpdate(CM_MemoryCategory category, size_t oldsize, size_t newsize);
+
+CM_MemoryStats CM_MemoryGetStats(CM_MemoryCategory category);
+/// Return the identifier of a category used in reports, e.g. "DisplayArray".
+const char *CM_MemoryGetName(CM_MemoryCategory category);
+
+/** Register the memory used by a library loaded with LibLoad.
+ * The size is also accounted in the CM_MEMORY_LIBRARY category.
+ */
+void CM_MemoryAddLibrary(const std::string& name, size_t size);
+/// Unregister the memory of a freed library, its peak is kept.
+void CM_MemoryRemoveLibrary(const std::string& name);
+/// Return the statistics of all the libraries loaded since the start of the game.
+std::map<std::string, CM_MemoryStats> CM_MemoryGetLibraryStats();
+
+/// Reset all the counters, called when the game engine starts.
+void CM_MemoryReset();
+
+#endif  // __CM_MEMORY_H__
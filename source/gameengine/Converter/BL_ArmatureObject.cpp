@@ -58,6 +58,7 @@ extern "C" {
 #include "KX_BlenderConverter.h"
 #include "KX_Globals.h"
 #include "KX_KetsjiEngine.h"
+#include "KX_Scene.h"
 
 #include "RAS_DebugDraw.h"
 
@@ -219,7 +220,12 @@ BL_ArmatureObject::BL_ArmatureObject(void *sgReplicationInfo,
 	m_timestep(0.040),
 	m_vert_deform_type(vert_deform_type),
 	m_drawDebug(false),
-	m_lastapplyframe(0.0)
+	m_lastapplyframe(0.0),
+	m_poseVersion(0),
+	m_skinVersion(0),
+	m_poseAction(nullptr),
+	m_poseActionFrame(0.0f),
+	m_poseFromAction(false)
 {
 	m_controlledConstraints = new CListValue<BL_ArmatureConstraint>();
 	m_poseChannels = new CListValue<BL_ArmatureChannel>();
@@ -448,6 +454,7 @@ void BL_ArmatureObject::ApplyPose()
 		// restore ourself
 		memcpy(m_objArma->obmat, m_obmat, sizeof(m_obmat));
 		m_lastapplyframe = m_lastframe;
+		++m_poseVersion;
 	}
 }
 
@@ -461,21 +468,32 @@ void BL_ArmatureObject::SetPose(bPose *pose)
 {
 	extract_pose_from_pose(m_pose, pose);
 	m_lastapplyframe = -1.0;
+	m_poseFromAction = false;
 }
 
 void BL_ArmatureObject::SetPoseByAction(bAction *action, float localtime)
 {
 	Object *arm = GetArmatureObject();
 
-	PointerRNA ptrrna;
-	RNA_id_pointer_create(&arm->id, &ptrrna);
+	// Replicas playing the same action frame share the sampled pose.
+	if (!KX_GameObject::GetScene()->GetActionCache().SetPose(arm, action, localtime)) {
+		PointerRNA ptrrna;
+		RNA_id_pointer_create(&arm->id, &ptrrna);
 
-	animsys_evaluate_action(&ptrrna, action, localtime, false);
+		animsys_evaluate_action(&ptrrna, action, localtime, false);
+	}
+
+	/* The actions of the layers above the first are always blended with the
+	 * pose of the layer below, BlendInPose then clears the flag. */
+	m_poseFromAction = true;
+	m_poseAction = action;
+	m_poseActionFrame = localtime;
 }
 
 void BL_ArmatureObject::BlendInPose(bPose *blend_pose, float weight, short mode)
 {
 	game_blend_poses(m_pose, blend_pose, weight, mode);
+	m_poseFromAction = false;
 }
 
 bool BL_ArmatureObject::UpdateTimestep(double curtime)
@@ -549,6 +567,40 @@ double BL_ArmatureObject::GetLastFrame()
 	return m_lastframe;
 }
 
+const std::vector<BL_ArmatureObject::SkinMatrix>& BL_ArmatureObject::GetSkinMatrices()
+{
+	ApplyPose();
+	if (m_skinVersion != m_poseVersion || m_skinMatrices.empty()) {
+		m_skinMatrices.resize(BLI_listbase_count(&m_objArma->pose->chanbase));
+		unsigned int i = 0;
+		for (bPoseChannel *pchan = (bPoseChannel *)m_objArma->pose->chanbase.first; pchan; pchan = pchan->next, ++i) {
+			copy_m4_m4(m_skinMatrices[i].mat, pchan->chan_mat);
+		}
+		m_skinVersion = m_poseVersion;
+	}
+	RestorePose();
+
+	return m_skinMatrices;
+}
+
+unsigned int BL_ArmatureObject::GetPoseVersion() const
+{
+	return m_poseVersion;
+}
+
+bool BL_ArmatureObject::GetPoseAction(bAction **action, float *frame) const
+{
+	// Constraints depend on their targets, the pose is not only defined by the action.
+	if (!m_poseFromAction || m_controlledConstraints->GetCount() > 0) {
+		return false;
+	}
+
+	*action = m_poseAction;
+	*frame = m_poseActionFrame;
+	return true;
+}
+
+
 bool BL_ArmatureObject::GetBoneMatrix(Bone *bone, MT_Matrix4x4& matrix)
 {
 	ApplyPose();
@@ -650,6 +702,8 @@ KX_PYMETHODDEF_DOC_NOARGS(BL_ArmatureObject, update,
                           "or if an action is playing. This function is useful in other cases.\n")
 {
 	UpdateTimestep(KX_GetActiveEngine()->GetFrameTime());
+	// The channels could be modified by the user.
+	m_poseFromAction = false;
 	Py_RETURN_NONE;
 }
 
@@ -36,6 +36,9 @@
 #include "BL_ArmatureConstraint.h"
 #include "BL_ArmatureChannel.h"
 
+#include <vector>
+
+struct bAction;
 struct bArmature;
 struct Bone;
 struct bPose;
@@ -49,6 +52,13 @@ class BL_ArmatureObject : public KX_GameObject
 {
 	Py_Header
 
+public:
+	/// Deform matrix of a pose channel, from rest to pose in armature space.
+	struct SkinMatrix
+	{
+		float mat[4][4];
+	};
+
 protected:
 	/// List element: BL_ArmatureConstraint.
 	CListValue<BL_ArmatureConstraint> *m_controlledConstraints;
@@ -73,6 +83,18 @@ protected:
 
 	double m_lastapplyframe;
 
+	/// Incremented for each evaluation of the pose in ApplyPose.
+	unsigned int m_poseVersion;
+	/// Deform matrices of the pose channels in pose channel list order.
+	std::vector<SkinMatrix> m_skinMatrices;
+	/// The pose version of the deform matrices.
+	unsigned int m_skinVersion;
+	/// The last action frame set by SetPoseByAction.
+	bAction *m_poseAction;
+	float m_poseActionFrame;
+	/// True when the pose is only defined by m_poseAction at m_poseActionFrame.
+	bool m_poseFromAction;
+
 public:
 	BL_ArmatureObject(void *sgReplicationInfo,
 	                  SG_Callbacks callbacks,
@@ -110,6 +132,15 @@ public:
 	bool GetDrawDebug() const;
 	void DrawDebug(RAS_DebugDraw& debugDraw);
 
+	/// Evaluate the pose if needed and return the deform matrices of the pose channels.
+	const std::vector<SkinMatrix>& GetSkinMatrices();
+	/// Return the version of the pose, incremented each time the pose is evaluated.
+	unsigned int GetPoseVersion() const;
+	/** Return true if the pose is only defined by a single action frame. Armatures sharing
+	 * the same original armature and playing the same action frame have then the same pose.
+	 */
+	bool GetPoseAction(bAction **action, float *frame) const;
+
 	// for constraint python API
 	void LoadConstraints(KX_BlenderSceneConverter& converter);
 	size_t GetConstraintNumber() const;
@@ -62,6 +62,7 @@
 
 #include "PHY_Pro.h"
 #include "PHY_IPhysicsEnvironment.h"
+#include "PHY_IGraphicController.h"
 
 #include "RAS_MeshObject.h"
 #include "RAS_Rasterizer.h"
@@ -83,6 +84,7 @@
 #include "KX_FontObject.h"
 #include "KX_LodManager.h"
 #include "KX_PythonComponent.h"
+#include "BL_SkinDeformer.h"
 
 #include "RAS_ICanvas.h"
 #include "RAS_Polygon.h"
@@ -732,6 +734,40 @@ static void BL_CreatePhysicsObjectNew(KX_GameObject* gameobj,
 	}
 }
 
+/* Add the mesh objects to the culling tree of the physics environment. */
+static void BL_CreateGraphicObjectNew(KX_GameObject *gameobj, KX_Scene *kxscene, bool isActive)
+{
+	Object *blenderobject = gameobj->GetBlenderObject();
+	if (gameobj->GetMeshCount() == 0 || !blenderobject) {
+		return;
+	}
+
+	/* The bounds of the mesh don't follow the skinning, never cull deformed objects. */
+	if (blenderobject->parent && blenderobject->parent->type == OB_ARMATURE) {
+		return;
+	}
+
+	PHY_IMotionState *motionstate = new KX_MotionState(gameobj->GetSGNode());
+	PHY_IGraphicController *ctrl = kxscene->GetPhysicsEnvironment()->CreateGraphicController(motionstate);
+	if (!ctrl) {
+		delete motionstate;
+		return;
+	}
+
+	gameobj->SetGraphicController(ctrl);
+	ctrl->SetNewClientInfo(gameobj->getClientInfo());
+
+	BoundBox *bb = BKE_object_boundbox_get(blenderobject);
+	if (bb) {
+		ctrl->SetLocalAabb(MT_Vector3(bb->vec[0]), MT_Vector3(bb->vec[6]));
+	}
+
+	/* Objects in inactive layers are only added with their replicas. */
+	if (isActive) {
+		gameobj->ActivateGraphicController(false);
+	}
+}
+
 static KX_LodManager *lodmanager_from_blenderobject(Object *ob, KX_Scene *scene, RAS_Rasterizer *rasty, KX_BlenderSceneConverter& converter, bool libloading)
 {
 	if (BLI_listbase_count_at_most(&ob->lodlevels, 2) <= 1) {
@@ -1138,7 +1174,7 @@ static void bl_ConvertBlenderObject_Single(
 	{
 		// blender has an additional 'parentinverse' offset in each object
 		SG_Callbacks callback(nullptr,nullptr,nullptr,KX_Scene::KX_ScenegraphUpdateFunc,KX_Scene::KX_ScenegraphRescheduleFunc);
-		SG_Node* parentinversenode = new SG_Node(nullptr,kxscene,callback);
+		SG_Node* parentinversenode = new SG_Node(nullptr,kxscene,callback,kxscene->GetTransformStore());
 
 		// define a normal parent relationship for this node.
 		KX_NormalParentRelation * parent_relation = KX_NormalParentRelation::New();
@@ -1288,7 +1324,8 @@ void BL_ConvertBlenderObjects(struct Main* maggie,
 	/* set activity culling parameters */
 	kxscene->SetActivityCulling(false);
 	kxscene->SetActivityCullingRadius(blenderscene->gm.activityBoxRadius);
-	kxscene->SetDbvtCulling(false);
+	kxscene->SetDbvtCulling((blenderscene->gm.flag & GAME_USE_CULLING) != 0);
+	kxscene->GetActionCache().SetBake((blenderscene->gm.flag & GAME_BAKE_ACTIONS) != 0);
 	
 	// no occlusion culling by default
 	kxscene->SetDbvtOcclusionRes(0);
@@ -1515,6 +1552,11 @@ void BL_ConvertBlenderObjects(struct Main* maggie,
 				break;
 		}
 	
+		// Deform the mesh in the game engine instead of the armature modifier.
+		if ((blenderscene->gm.flag & GAME_BATCH_SKINNING) && parentobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
+			childobj->SetSkinDeformer(BL_SkinDeformer::New(childobj, static_cast<BL_ArmatureObject *>(parentobj)));
+		}
+
 		parentobj->	GetSGNode()->AddChild(pcit->m_gamechildnode);
 	}
 	vec_parent_child.clear();
@@ -1544,6 +1586,22 @@ void BL_ConvertBlenderObjects(struct Main* maggie,
 		BL_CreatePhysicsObjectNew(gameobj, blenderobject, meshobj, kxscene, layerMask, converter, processCompoundChildren);
 	}
 
+	// create graphic controllers for the culling, the objects are now placed
+	if (kxscene->GetDbvtCulling()) {
+		bool occlusion = false;
+		for (KX_GameObject *gameobj : sumolist) {
+			const bool isActive = objectlist->SearchValue(gameobj);
+			BL_CreateGraphicObjectNew(gameobj, kxscene, isActive);
+			if (isActive && gameobj->GetOccluder() && gameobj->GetGraphicController()) {
+				occlusion = true;
+			}
+		}
+		// the occlusion buffer is only used if the scene has occluders
+		if (occlusion) {
+			kxscene->SetDbvtOcclusionRes(blenderscene->gm.occlusionRes);
+		}
+	}
+
 	// create physics joints
 	for (KX_GameObject *gameobj : sumolist) {
 		PHY_IPhysicsEnvironment *physEnv = kxscene->GetPhysicsEnvironment();
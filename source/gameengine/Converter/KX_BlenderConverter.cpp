@@ -41,6 +41,7 @@
 #include "KX_KetsjiEngine.h"
 #include "KX_PythonInit.h" // So we can handle adding new text datablocks for Python to import
 #include "KX_LibLoadStatus.h"
+#include "KX_SoundManager.h"
 #include "KX_BlenderScalarInterpolator.h"
 #include "KX_BlenderConverter.h"
 #include "KX_BlenderSceneConverter.h"
@@ -64,6 +65,7 @@
 
 // This list includes only data type definitions
 #include "DNA_scene_types.h"
+#include "DNA_sound_types.h"
 #include "BKE_main.h"
 
 extern "C" {
@@ -84,6 +86,9 @@ extern "C" {
 
 #include "BLI_task.h"
 #include "CM_Message.h"
+#include "CM_Memory.h"
+
+#include "MEM_guardedalloc.h"
 
 #include <cstring>
 
@@ -440,6 +445,9 @@ KX_LibLoadStatus *KX_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib, c
 		return nullptr;
 	}
 
+	// Memory used by the linked data blocks, reported per library.
+	const size_t memoryInUse = MEM_get_memory_in_use();
+
 	main_newlib = BKE_main_new();
 	BKE_reports_init(&reports, RPT_STORE);
 
@@ -465,6 +473,9 @@ KX_LibLoadStatus *KX_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib, c
 	BKE_reports_clear(&reports);
 	// done linking
 
+	const size_t memoryAfterLink = MEM_get_memory_in_use();
+	CM_MemoryAddLibrary(path, (memoryAfterLink > memoryInUse) ? memoryAfterLink - memoryInUse : 0);
+
 	// needed for lookups
 	m_DynamicMaggie.push_back(main_newlib);
 	BLI_strncpy(main_newlib->name, path, sizeof(main_newlib->name));
@@ -623,6 +634,8 @@ bool KX_BlenderConverter::FreeBlendFile(Main *maggie)
 					++it;
 				}
 			}
+			// The cache refers to the F-Curves of the freed actions.
+			scene->GetActionCache().Clear();
 
 			// removed tagged objects and meshes
 			CListValue<KX_GameObject> *obj_lists[] = {scene->GetObjectList(), scene->GetInactiveList(), nullptr};
@@ -728,9 +741,17 @@ bool KX_BlenderConverter::FreeBlendFile(Main *maggie)
 	removeImportMain(maggie);
 #endif
 
+	// The shared sounds of the library sound datablocks are not used by any actuator now.
+	KX_SoundManager *soundManager = m_ketsjiEngine->GetSoundManager();
+	for (bSound *sound = (bSound *)maggie->sounds.first; sound; sound = (bSound *)sound->id.next) {
+		soundManager->RemoveSound(sound);
+	}
+
 	delete m_status_map[maggie->name];
 	m_status_map.erase(maggie->name);
 
+	CM_MemoryRemoveLibrary(maggie->name);
+
 	BKE_main_free(maggie);
 
 	return true;
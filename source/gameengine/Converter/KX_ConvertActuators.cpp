@@ -81,6 +81,7 @@ extern "C" {
 
 #include "KX_Scene.h"
 #include "KX_KetsjiEngine.h"
+#include "KX_SoundManager.h"
 
 #include "EXP_IntValue.h"
 #include "KX_GameObject.h"
@@ -250,6 +251,10 @@ void BL_ConvertActuators(const char* maggiename,
 				            actact->stridelength
 				            // Ketsji at 1, because zero is reserved for "NoDef"
 				            );
+				// Sample the action before the game starts.
+				if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
+					scene->GetActionCache().Bake(actact->act, gameobj->GetBlenderObject());
+				}
 				baseact= tmpbaseact;
 				break;
 			}
@@ -369,18 +374,13 @@ void BL_ConvertActuators(const char* maggiename,
 					else
 					{
 #ifdef WITH_AUDASPACE
-						BKE_sound_load_no_assert(G_MAIN, sound);
-						snd_sound = sound->playback_handle;
-
-						// if sound shall be 3D but isn't mono, we have to make it mono!
-						if (is3d)
-						{
-							snd_sound = AUD_Sound_rechannel(snd_sound, AUD_CHANNELS_MONO);
-						}
+						// the decoded sound is shared by all the actuators using this sound, 3D sounds are mono
+						snd_sound = ketsjiEngine->GetSoundManager()->GetSound(sound, is3d);
 #endif  // WITH_AUDASPACE
 					}
 					SCA_SoundActuator* tmpsoundact =
 						new SCA_SoundActuator(gameobj,
+						ketsjiEngine->GetSoundManager(),
 #ifdef WITH_AUDASPACE
 						snd_sound,
 #endif  // WITH_AUDASPACE
@@ -390,13 +390,6 @@ void BL_ConvertActuators(const char* maggiename,
 						settings,
 						soundActuatorType);
 
-#ifdef WITH_AUDASPACE
-					// if we made it mono, we have to free it
-					if (sound && snd_sound && snd_sound != sound->playback_handle) {
-						AUD_Sound_free(snd_sound);
-					}
-#endif  // WITH_AUDASPACE
-
 					tmpsoundact->SetName(bact->name);
 					baseact = tmpsoundact;
 				}
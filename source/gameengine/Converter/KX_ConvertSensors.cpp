@@ -238,7 +238,9 @@ void BL_ConvertSensors(struct Object* blenderobject,
 							blendernearsensor->resetdist,
 							bFindMaterial,
 							nearpropertyname,
-							physCtrl);
+							physCtrl,
+							(blendernearsensor->flag & SENS_NEAR_QUERY) != 0,
+							blendernearsensor->skip);
 
 					}
 					break;
@@ -463,7 +465,9 @@ void BL_ConvertSensors(struct Object* blenderobject,
 							smallmargin,
 							largemargin,
 							bFindMaterial,
-							radarpropertyname);
+							radarpropertyname,
+							(blenderradarsensor->flag & SENS_NEAR_QUERY) != 0,
+							blenderradarsensor->skip);
 
 					}
 
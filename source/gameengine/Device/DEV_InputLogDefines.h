@@ -0,0 +1,52 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file DEV_InputLogDefines.h
+ *  \ingroup device
+ */
+
+#ifndef __DEV_INPUTLOGDEFINES_H__
+#define __DEV_INPUTLOGDEFINES_H__
+
+/* Input log file layout, all values are in the native byte order:
+ *
+ * header:   char[8] magic, uint32 version
+ * frame:    uint16 input count, inputs,
+ *           uint16 text length, uint32 characters,
+ *           uint8 joystick count, joysticks
+ * input:    uint16 type, uint16 status count, uint8 status,
+ *           uint16 queue count, uint8 queue,
+ *           uint16 value count, int32 values, uint32 unicode
+ * joystick: uint8 index, uint8 flags, uint16 buttons, int16 axis[JOYAXIS_MAX]
+ *
+ * Only the inputs which received events during the frame are stored,
+ * the others keep the same state as in the previous frame.
+ */
+
+#define INPUTLOG_MAGIC				"BGEINPUT"
+#define INPUTLOG_MAGIC_SIZE			8
+#define INPUTLOG_VERSION			1
+
+#define INPUTLOG_JOYSTICK_TRIGAXIS		(1 << 0)
+#define INPUTLOG_JOYSTICK_TRIGBUTTON	(1 << 1)
+
+#endif // __DEV_INPUTLOGDEFINES_H__
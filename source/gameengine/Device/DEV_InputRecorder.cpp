@@ -0,0 +1,179 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Device/DEV_InputRecorder.cpp
+ *  \ingroup device
+ */
+
+#include "DEV_InputRecorder.h"
+#include "DEV_InputLogDefines.h"
+#include "DEV_Joystick.h"
+
+#include "SCA_IInputDevice.h"
+
+#include "BLI_fileops.h"
+
+#include "CM_Message.h"
+
+#include <cstdint>
+#include <cstring>
+
+template <class Type>
+static void writeValue(std::string& buffer, Type value)
+{
+	buffer.append((const char *)&value, sizeof(Type));
+}
+
+DEV_InputRecorder::DEV_InputRecorder()
+	:m_file(nullptr),
+	m_numFrames(0)
+{
+}
+
+DEV_InputRecorder::~DEV_InputRecorder()
+{
+	Close();
+}
+
+bool DEV_InputRecorder::Open(const std::string& path)
+{
+	Close();
+
+	m_file = BLI_fopen(path.c_str(), "wb");
+	if (!m_file) {
+		CM_Error("could not open '" << path << "'");
+		return false;
+	}
+
+	m_path = path;
+	m_numFrames = 0;
+
+	m_buffer.clear();
+	m_buffer.append(INPUTLOG_MAGIC, INPUTLOG_MAGIC_SIZE);
+	writeValue<uint32_t>(m_buffer, INPUTLOG_VERSION);
+	if (fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) != m_buffer.size()) {
+		CM_Error("could not write '" << m_path << "'");
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void DEV_InputRecorder::Close()
+{
+	if (!m_file) {
+		return;
+	}
+
+	if (fclose(m_file) != 0) {
+		CM_Error("could not write '" << m_path << "'");
+	}
+	else {
+		CM_Message("recorded " << m_numFrames << " input frames in '" << m_path << "'");
+	}
+	m_file = nullptr;
+}
+
+void DEV_InputRecorder::RecordFrame(SCA_IInputDevice *device)
+{
+	if (!m_file) {
+		return;
+	}
+
+	m_buffer.clear();
+
+	// Reserve the input count, written once all the inputs are known.
+	writeValue<uint16_t>(m_buffer, 0);
+	uint16_t numInputs = 0;
+
+	for (unsigned short i = 0; i < SCA_IInputDevice::MAX_KEYS; ++i) {
+		const SCA_InputEvent& input = device->GetInput((SCA_IInputDevice::SCA_EnumInputs)i);
+		// Without events the input keeps its state of the previous frame.
+		if (input.m_status.size() == 1 && input.m_values.size() == 1 && input.m_queue.empty()) {
+			continue;
+		}
+
+		writeValue<uint16_t>(m_buffer, i);
+		writeValue<uint16_t>(m_buffer, input.m_status.size());
+		for (SCA_InputEvent::SCA_EnumInputs status : input.m_status) {
+			writeValue<uint8_t>(m_buffer, status);
+		}
+		writeValue<uint16_t>(m_buffer, input.m_queue.size());
+		for (SCA_InputEvent::SCA_EnumInputs event : input.m_queue) {
+			writeValue<uint8_t>(m_buffer, event);
+		}
+		writeValue<uint16_t>(m_buffer, input.m_values.size());
+		for (int value : input.m_values) {
+			writeValue<int32_t>(m_buffer, value);
+		}
+		writeValue<uint32_t>(m_buffer, input.m_unicode);
+
+		++numInputs;
+	}
+	memcpy(&m_buffer[0], &numInputs, sizeof(numInputs));
+
+	const std::wstring& text = device->GetText();
+	writeValue<uint16_t>(m_buffer, text.size());
+	for (wchar_t c : text) {
+		writeValue<uint32_t>(m_buffer, c);
+	}
+
+	const size_t joystickOffset = m_buffer.size();
+	writeValue<uint8_t>(m_buffer, 0);
+	uint8_t numJoysticks = 0;
+
+	for (short i = 0; i < JOYINDEX_MAX; ++i) {
+		DEV_Joystick *joystick = DEV_Joystick::GetInstance(i);
+		if (!joystick || !joystick->Connected()) {
+			continue;
+		}
+
+		DEV_Joystick::State state;
+		joystick->GetState(state);
+
+		writeValue<uint8_t>(m_buffer, i);
+		writeValue<uint8_t>(m_buffer, (state.m_trigAxis ? INPUTLOG_JOYSTICK_TRIGAXIS : 0) |
+		                              (state.m_trigButton ? INPUTLOG_JOYSTICK_TRIGBUTTON : 0));
+		writeValue<uint16_t>(m_buffer, state.m_buttons);
+		for (int axis = 0; axis < JOYAXIS_MAX; ++axis) {
+			writeValue<int16_t>(m_buffer, state.m_axis[axis]);
+		}
+
+		++numJoysticks;
+	}
+	memcpy(&m_buffer[joystickOffset], &numJoysticks, sizeof(numJoysticks));
+
+	if (fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) != m_buffer.size()) {
+		CM_Error("could not write '" << m_path << "', input recording stopped");
+		fclose(m_file);
+		m_file = nullptr;
+		return;
+	}
+
+	++m_numFrames;
+}
+
+unsigned int DEV_InputRecorder::GetNumFrames() const
+{
+	return m_numFrames;
+}
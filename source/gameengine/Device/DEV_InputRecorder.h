@@ -0,0 +1,64 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file DEV_InputRecorder.h
+ *  \ingroup device
+ */
+
+#ifndef __DEV_INPUTRECORDER_H__
+#define __DEV_INPUTRECORDER_H__
+
+#include <string>
+#include <cstdio>
+
+class SCA_IInputDevice;
+
+/** Write the input events and joystick states seen by the logic
+ * every logic frame in a binary log, replayed by DEV_InputReplay.
+ */
+class DEV_InputRecorder
+{
+private:
+	FILE *m_file;
+	std::string m_path;
+	/// Data of the frame being recorded.
+	std::string m_buffer;
+	unsigned int m_numFrames;
+
+public:
+	DEV_InputRecorder();
+	~DEV_InputRecorder();
+
+	/// Create the log file, return false if the file can't be written.
+	bool Open(const std::string& path);
+	/// Flush and close the log file.
+	void Close();
+
+	/** Record the changed inputs of the device and the connected joysticks,
+	 * must be called at the beginning of each logic frame.
+	 */
+	void RecordFrame(SCA_IInputDevice *device);
+
+	unsigned int GetNumFrames() const;
+};
+
+#endif  // __DEV_INPUTRECORDER_H__
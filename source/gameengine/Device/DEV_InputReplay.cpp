@@ -0,0 +1,278 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Device/DEV_InputReplay.cpp
+ *  \ingroup device
+ */
+
+#include "DEV_InputReplay.h"
+#include "DEV_InputLogDefines.h"
+#include "DEV_Joystick.h"
+
+#include "BLI_fileops.h"
+
+#include "CM_Message.h"
+
+#include <cstdint>
+#include <cstring>
+
+DEV_InputReplay::DEV_InputReplay()
+	:m_offset(0),
+	m_frame(0),
+	m_finished(true),
+	m_missingJoysticks(0)
+{
+}
+
+DEV_InputReplay::~DEV_InputReplay()
+{
+	Finish();
+}
+
+bool DEV_InputReplay::Read(void *value, size_t size)
+{
+	if (m_offset + size > m_data.size()) {
+		return false;
+	}
+
+	memcpy(value, m_data.data() + m_offset, size);
+	m_offset += size;
+	return true;
+}
+
+bool DEV_InputReplay::Load(const std::string& path)
+{
+	FILE *file = BLI_fopen(path.c_str(), "rb");
+	if (!file) {
+		CM_Error("could not open '" << path << "'");
+		return false;
+	}
+
+	m_data.clear();
+	char buffer[4096];
+	size_t size;
+	while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		m_data.append(buffer, size);
+	}
+	const bool error = ferror(file);
+	fclose(file);
+
+	if (error) {
+		CM_Error("could not read '" << path << "'");
+		return false;
+	}
+
+	m_offset = 0;
+	char magic[INPUTLOG_MAGIC_SIZE];
+	uint32_t version;
+	if (!Read(magic, sizeof(magic)) || memcmp(magic, INPUTLOG_MAGIC, INPUTLOG_MAGIC_SIZE) != 0 ||
+		!Read(&version, sizeof(version)))
+	{
+		CM_Error("'" << path << "' is not an input log");
+		return false;
+	}
+
+	if (version != INPUTLOG_VERSION) {
+		CM_Error("unsupported input log version " << version << " in '" << path << "'");
+		return false;
+	}
+
+	m_frame = 0;
+	m_finished = false;
+	m_missingJoysticks = 0;
+
+	return true;
+}
+
+bool DEV_InputReplay::ReadFrame()
+{
+	uint16_t numInputs;
+	if (!Read(&numInputs, sizeof(numInputs))) {
+		return false;
+	}
+
+	for (unsigned short i = 0; i < numInputs; ++i) {
+		uint16_t type;
+		uint16_t count;
+		if (!Read(&type, sizeof(type)) || type >= MAX_KEYS) {
+			return false;
+		}
+
+		SCA_InputEvent& input = m_inputsTable[type];
+
+		// Status and values always contain at least one item.
+		if (!Read(&count, sizeof(count)) || count == 0) {
+			return false;
+		}
+		input.m_status.resize(count);
+		for (SCA_InputEvent::SCA_EnumInputs& status : input.m_status) {
+			uint8_t value;
+			if (!Read(&value, sizeof(value))) {
+				return false;
+			}
+			status = (SCA_InputEvent::SCA_EnumInputs)value;
+		}
+
+		if (!Read(&count, sizeof(count))) {
+			return false;
+		}
+		input.m_queue.resize(count);
+		for (SCA_InputEvent::SCA_EnumInputs& event : input.m_queue) {
+			uint8_t value;
+			if (!Read(&value, sizeof(value))) {
+				return false;
+			}
+			event = (SCA_InputEvent::SCA_EnumInputs)value;
+		}
+
+		if (!Read(&count, sizeof(count)) || count == 0) {
+			return false;
+		}
+		input.m_values.resize(count);
+		for (int& value : input.m_values) {
+			int32_t data;
+			if (!Read(&data, sizeof(data))) {
+				return false;
+			}
+			value = data;
+		}
+
+		uint32_t unicode;
+		if (!Read(&unicode, sizeof(unicode))) {
+			return false;
+		}
+		input.m_unicode = unicode;
+	}
+
+	uint16_t textSize;
+	if (!Read(&textSize, sizeof(textSize))) {
+		return false;
+	}
+	m_text.resize(textSize);
+	for (wchar_t& c : m_text) {
+		uint32_t data;
+		if (!Read(&data, sizeof(data))) {
+			return false;
+		}
+		c = data;
+	}
+
+	uint8_t numJoysticks;
+	if (!Read(&numJoysticks, sizeof(numJoysticks))) {
+		return false;
+	}
+
+	DEV_Joystick::State states[JOYINDEX_MAX];
+	bool recorded[JOYINDEX_MAX] = {false};
+	for (unsigned short i = 0; i < numJoysticks; ++i) {
+		uint8_t index;
+		uint8_t flags;
+		uint16_t buttons;
+		if (!Read(&index, sizeof(index)) || index >= JOYINDEX_MAX || !Read(&flags, sizeof(flags)) ||
+			!Read(&buttons, sizeof(buttons)))
+		{
+			return false;
+		}
+
+		DEV_Joystick::State& state = states[index];
+		for (int axis = 0; axis < JOYAXIS_MAX; ++axis) {
+			int16_t value;
+			if (!Read(&value, sizeof(value))) {
+				return false;
+			}
+			state.m_axis[axis] = value;
+		}
+		state.m_buttons = buttons;
+		state.m_trigAxis = (flags & INPUTLOG_JOYSTICK_TRIGAXIS);
+		state.m_trigButton = (flags & INPUTLOG_JOYSTICK_TRIGBUTTON);
+		recorded[index] = true;
+	}
+
+	/* The joysticks not connected during the recording stay idle, the live
+	 * states must never be mixed with the recorded ones. */
+	for (short i = 0; i < JOYINDEX_MAX; ++i) {
+		DEV_Joystick *joystick = DEV_Joystick::GetInstance(i);
+		if (!joystick) {
+			if (recorded[i] && !(m_missingJoysticks & (1 << i))) {
+				m_missingJoysticks |= (1 << i);
+				CM_Warning("joystick " << i << " recorded in the input log is not connected");
+			}
+			continue;
+		}
+
+		if (!recorded[i]) {
+			states[i] = DEV_Joystick::State();
+		}
+		joystick->SetState(states[i]);
+	}
+
+	return true;
+}
+
+bool DEV_InputReplay::NextFrame()
+{
+	if (m_finished) {
+		return false;
+	}
+
+	if (m_offset == m_data.size()) {
+		CM_Message("input replay finished after " << m_frame << " frames");
+		Finish();
+		return false;
+	}
+
+	if (!ReadFrame()) {
+		CM_Error("invalid input log at frame " << m_frame << ", replay stopped");
+		Finish();
+		return false;
+	}
+
+	++m_frame;
+	return true;
+}
+
+void DEV_InputReplay::Finish()
+{
+	if (m_finished) {
+		return;
+	}
+
+	m_finished = true;
+	m_data.clear();
+
+	for (short i = 0; i < JOYINDEX_MAX; ++i) {
+		DEV_Joystick *joystick = DEV_Joystick::GetInstance(i);
+		if (joystick) {
+			joystick->ReleaseState();
+		}
+	}
+}
+
+bool DEV_InputReplay::IsFinished() const
+{
+	return m_finished;
+}
+
+unsigned int DEV_InputReplay::GetFrame() const
+{
+	return m_frame;
+}
@@ -0,0 +1,71 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file DEV_InputReplay.h
+ *  \ingroup device
+ */
+
+#ifndef __DEV_INPUTREPLAY_H__
+#define __DEV_INPUTREPLAY_H__
+
+#include "SCA_IInputDevice.h"
+
+#include <string>
+
+/** Input device fed by a log written by DEV_InputRecorder, every logic
+ * frame receives exactly the inputs and joystick states of the recorded frame.
+ */
+class DEV_InputReplay : public SCA_IInputDevice
+{
+private:
+	std::string m_data;
+	/// Read position in the log data.
+	size_t m_offset;
+	unsigned int m_frame;
+	bool m_finished;
+	/// Recorded joysticks already reported as not connected, one bit per joystick.
+	unsigned short m_missingJoysticks;
+
+	bool Read(void *value, size_t size);
+	bool ReadFrame();
+	/// Stop the replay and give back the joysticks to their devices.
+	void Finish();
+
+public:
+	DEV_InputReplay();
+	virtual ~DEV_InputReplay();
+
+	/// Read the log file, return false if the file is not a valid input log.
+	bool Load(const std::string& path);
+
+	/** Replace the inputs and joystick states by the next recorded frame,
+	 * must be called at the beginning of each logic frame.
+	 * \return False if the log has no more frames.
+	 */
+	bool NextFrame();
+
+	/// Return true once all the frames were replayed.
+	bool IsFinished() const;
+	unsigned int GetFrame() const;
+};
+
+#endif  // __DEV_INPUTREPLAY_H__
@@ -53,7 +53,9 @@ DEV_Joystick::DEV_Joystick(short index)
 	m_buttonmax(-1),
 	m_isinit(0),
 	m_istrig_axis(0),
-	m_istrig_button(0)
+	m_istrig_button(0),
+	m_replay(false),
+	m_replay_buttons(0)
 {
 	for (int i=0; i < JOYAXIS_MAX; i++)
 		m_axis_array[i] = 0;
@@ -184,6 +186,10 @@ bool DEV_Joystick::aAxisIsPositive(int axis_single)
 
 bool DEV_Joystick::aAnyButtonPressIsPositive(void)
 {
+	if (m_replay) {
+		return (m_replay_buttons != 0);
+	}
+
 #ifdef WITH_SDL
 	if (!(SDL_CHECK(SDL_GameControllerGetButton))) {
 		return false;
@@ -202,6 +208,10 @@ bool DEV_Joystick::aAnyButtonPressIsPositive(void)
 
 bool DEV_Joystick::aButtonPressIsPositive(int button)
 {
+	if (m_replay) {
+		return (button >= 0 && button < JOYBUT_MAX && (m_replay_buttons & (1 << button)));
+	}
+
 #ifdef WITH_SDL
 	if ((SDL_CHECK(SDL_GameControllerGetButton) &&
 		SDL_GameControllerGetButton(m_private->m_gamecontroller, (SDL_GameControllerButton)button)))
@@ -215,6 +225,10 @@ bool DEV_Joystick::aButtonPressIsPositive(int button)
 
 bool DEV_Joystick::aButtonReleaseIsPositive(int button)
 {
+	if (m_replay) {
+		return !aButtonPressIsPositive(button);
+	}
+
 #ifdef WITH_SDL
 	if (!(SDL_CHECK(SDL_GameControllerGetButton) &&
 		SDL_GameControllerGetButton(m_private->m_gamecontroller, (SDL_GameControllerButton)button)))
@@ -341,6 +355,41 @@ void DEV_Joystick::DestroyJoystickDevice(void)
 #endif /* WITH_SDL */
 }
 
+void DEV_Joystick::GetState(State& state)
+{
+	for (int i = 0; i < JOYAXIS_MAX; i++) {
+		state.m_axis[i] = m_axis_array[i];
+	}
+
+	state.m_buttons = 0;
+	for (int i = 0; i < JOYBUT_MAX; i++) {
+		if (aButtonPressIsPositive(i)) {
+			state.m_buttons |= (1 << i);
+		}
+	}
+
+	state.m_trigAxis = m_istrig_axis;
+	state.m_trigButton = m_istrig_button;
+}
+
+void DEV_Joystick::SetState(const State& state)
+{
+	for (int i = 0; i < JOYAXIS_MAX; i++) {
+		m_axis_array[i] = state.m_axis[i];
+	}
+
+	m_replay = true;
+	m_replay_buttons = state.m_buttons;
+	m_istrig_axis = state.m_trigAxis;
+	m_istrig_button = state.m_trigButton;
+}
+
+void DEV_Joystick::ReleaseState()
+{
+	m_replay = false;
+	m_replay_buttons = 0;
+}
+
 int DEV_Joystick::Connected(void)
 {
 #ifdef WITH_SDL
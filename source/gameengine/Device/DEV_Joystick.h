@@ -93,6 +93,11 @@ class DEV_Joystick
 	bool			m_istrig_axis;
 	bool			m_istrig_button;
 
+	/** are the buttons replayed instead of read from the device ? */
+	bool			m_replay;
+	/** replayed button states, one bit per button */
+	unsigned short	m_replay_buttons;
+
 #ifdef WITH_SDL
 	/**
 	 * event callbacks
@@ -128,6 +133,19 @@ class DEV_Joystick
 	
 public:
 
+	/**
+	 * State of the joystick seen by the logic during a frame,
+	 * used to record and replay the joystick input.
+	 */
+	struct State
+	{
+		int m_axis[JOYAXIS_MAX];
+		/// One bit per button.
+		unsigned short m_buttons;
+		bool m_trigAxis;
+		bool m_trigButton;
+	};
+
 	static DEV_Joystick *GetInstance(short joyindex);
 	static bool HandleEvents(short (&addrem)[JOYINDEX_MAX]);
 	void ReleaseInstance(short joyindex);
@@ -175,6 +193,18 @@ public:
 	bool GetRumbleSupport();
 	void ProcessRumbleStatus();
 
+	/**
+	 * Get the current axis, buttons and trigger states.
+	 */
+	void GetState(State& state);
+
+	/**
+	 * Replace the current states, the buttons are then no longer read
+	 * from the device until ReleaseState is called.
+	 */
+	void SetState(const State& state);
+	void ReleaseState();
+
 	/**
 	 * Test if the joystick is connected
 	 */
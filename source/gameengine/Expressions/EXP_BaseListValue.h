@@ -21,6 +21,8 @@
 
 #include "EXP_Value.h"
 
+#include <unordered_map>
+
 class CBaseListValue : public CPropValue
 {
 	Py_Header
@@ -34,6 +36,25 @@ protected:
 	VectorType m_pValueArray;
 	bool m_bReleaseContents;
 
+	/// True when the name and position indices below are maintained, see EnableNameIndex().
+	bool m_useNameIndex;
+	/// Values grouped by name.
+	std::unordered_map<std::string, VectorType> m_nameIndex;
+	/// Position of each value in m_pValueArray.
+	std::unordered_map<CValue *, unsigned int> m_positionIndex;
+	/// Slots of the values removed from an indexed list, erased by the next Compact().
+	std::vector<unsigned int> m_removedPositions;
+
+	void IndexValue(CValue *val, unsigned int i);
+	void UnindexValue(CValue *val);
+	/// Update the position of the values starting from index start.
+	void UpdatePositions(unsigned int start);
+	void RebuildIndex();
+	/** Erase the slots of the removed values and update the positions of the moved values
+	 * in one pass, must be called before accessing the values by position.
+	 */
+	void Compact();
+
 	void SetValue(int i, CValue *val);
 	CValue *GetValue(int i);
 	CValue *FindValue(const std::string& name) const;
@@ -41,6 +62,8 @@ protected:
 	void Add(CValue *value);
 	void Insert(unsigned int i, CValue *value);
 	bool RemoveValue(CValue *val);
+	/// Remove a value by moving the last value at its place, the order of the list is not preserved.
+	bool RemoveValueUnordered(CValue *val);
 	bool CheckEqual(CValue *first, CValue *second);
 
 public:
@@ -53,6 +76,17 @@ public:
 
 	void SetReleaseOnDestruct(bool bReleaseContents);
 
+	/** Maintain a name and position index of the values, FindValue, SearchValue and RemoveValue
+	 * are then done in constant time instead of iterating over the list. The removed values
+	 * leave a slot erased on the next access by position, removing many values in a row
+	 * shifts the list once.
+	 * A value must be present only once in an indexed list and renaming a value
+	 * must be notified with RenameValue().
+	 */
+	void EnableNameIndex(bool enable);
+	/// Move the value to its new name in the name index.
+	void RenameValue(CValue *val, const std::string& oldname);
+
 	void Remove(int i);
 	void Resize(int num);
 	void ReleaseAndRemoveAll();
@@ -60,6 +60,7 @@ public:
 
 	virtual CListValue<ItemType> *GetReplica()
 	{
+		Compact();
 		CListValue<ItemType> *replica = new CListValue<ItemType>(*this);
 
 		replica->ProcessReplica();
@@ -72,6 +73,10 @@ public:
 			replica->m_pValueArray[i] = m_pValueArray[i]->GetReplica();
 		}
 
+		if (m_useNameIndex) {
+			replica->RebuildIndex();
+		}
+
 		return replica;
 	}
 
@@ -87,6 +92,7 @@ public:
 
 	ItemType *FindIf(std::function<bool (ItemType *)> function)
 	{
+		Compact();
 		for (CValue *val : m_pValueArray) {
 			ItemType *item = static_cast<ItemType *>(val);
 			if (function(item)) {
@@ -126,6 +132,11 @@ public:
 		return CBaseListValue::RemoveValue(val);
 	}
 
+	bool RemoveValueUnordered(ItemType *val)
+	{
+		return CBaseListValue::RemoveValueUnordered(val);
+	}
+
 	void SetValue(int i, ItemType *val)
 	{
 		CBaseListValue::SetValue(i, val);
@@ -137,19 +148,23 @@ public:
 
 	ItemType *GetFront()
 	{
+		Compact();
 		return static_cast<ItemType *>(m_pValueArray.front());
 	}
 	ItemType *GetBack()
 	{
+		Compact();
 		return static_cast<ItemType *>(m_pValueArray.back());
 	}
 
 	const_iterator begin()
 	{
+		Compact();
 		return const_iterator(m_pValueArray.begin());
 	}
 	const_iterator end()
 	{
+		Compact();
 		return const_iterator(m_pValueArray.end());
 	}
 };
@@ -37,4 +37,12 @@
  */
 void RunPythonCallBackList(PyObject *functionlist, PyObject **arglist, unsigned int minargcount, unsigned int maxargcount);
 
+/** Return the maximum quantity of arguments used by the valid functions of a list,
+ * allowing to create only the arguments passed to the callbacks.
+ * \param functionlist The python list which contains callbacks.
+ * \param minargcount The minimum of quantity of arguments possible.
+ * \param maxargcount The maximum of quantity of arguments possible.
+ */
+unsigned int GetPythonCallBackListMaxArgCount(PyObject *functionlist, unsigned int minargcount, unsigned int maxargcount);
+
 #endif // __EXP_PYTHON_CALLBACK_H__
@@ -28,7 +28,8 @@
 #include "BLI_sys_types.h" // For intptr_t support.
 
 CBaseListValue::CBaseListValue()
-	:m_bReleaseContents(true)
+	:m_bReleaseContents(true),
+	m_useNameIndex(false)
 {
 }
 
@@ -36,23 +37,130 @@ CBaseListValue::~CBaseListValue()
 {
 	if (m_bReleaseContents) {
 		for (CValue *item : m_pValueArray) {
-			item->Release();
+			// Skip the slots of the removed values.
+			if (item) {
+				item->Release();
+			}
+		}
+	}
+}
+
+void CBaseListValue::IndexValue(CValue *val, unsigned int i)
+{
+	// Resize() can leave empty slots until they are filled by SetValue().
+	if (!val) {
+		return;
+	}
+
+	m_nameIndex[val->GetName()].push_back(val);
+	m_positionIndex[val] = i;
+}
+
+void CBaseListValue::UnindexValue(CValue *val)
+{
+	if (!val) {
+		return;
+	}
+
+	m_positionIndex.erase(val);
+
+	const std::unordered_map<std::string, VectorType>::iterator it = m_nameIndex.find(val->GetName());
+	if (it == m_nameIndex.end()) {
+		return;
+	}
+
+	VectorType& values = it->second;
+	values.erase(std::find(values.begin(), values.end(), val));
+	if (values.empty()) {
+		m_nameIndex.erase(it);
+	}
+}
+
+void CBaseListValue::UpdatePositions(unsigned int start)
+{
+	for (unsigned int i = start, size = m_pValueArray.size(); i < size; ++i) {
+		CValue *val = m_pValueArray[i];
+		if (val) {
+			m_positionIndex[val] = i;
+		}
+	}
+}
+
+void CBaseListValue::Compact()
+{
+	if (m_removedPositions.empty()) {
+		return;
+	}
+
+	std::sort(m_removedPositions.begin(), m_removedPositions.end());
+
+	unsigned int dst = m_removedPositions.front();
+	unsigned int removed = 0;
+	for (unsigned int src = dst, size = m_pValueArray.size(); src < size; ++src) {
+		if (removed < m_removedPositions.size() && m_removedPositions[removed] == src) {
+			++removed;
+			continue;
+		}
+
+		CValue *val = m_pValueArray[src];
+		m_pValueArray[dst] = val;
+		if (val) {
+			m_positionIndex[val] = dst;
 		}
+		++dst;
+	}
+
+	m_pValueArray.resize(dst);
+	m_removedPositions.clear();
+}
+
+void CBaseListValue::RebuildIndex()
+{
+	m_nameIndex.clear();
+	m_positionIndex.clear();
+
+	for (unsigned int i = 0, size = m_pValueArray.size(); i < size; ++i) {
+		IndexValue(m_pValueArray[i], i);
 	}
 }
 
 void CBaseListValue::SetValue(int i, CValue *val)
 {
+	Compact();
+	if (m_useNameIndex) {
+		UnindexValue(m_pValueArray[i]);
+		IndexValue(val, i);
+	}
 	m_pValueArray[i] = val;
 }
 
 CValue *CBaseListValue::GetValue(int i)
 {
+	Compact();
 	return m_pValueArray[i];
 }
 
 CValue *CBaseListValue::FindValue(const std::string& name) const
 {
+	if (m_useNameIndex) {
+		const std::unordered_map<std::string, VectorType>::const_iterator it = m_nameIndex.find(name);
+		if (it == m_nameIndex.end()) {
+			return nullptr;
+		}
+
+		// Return the first value in list order as the search without index.
+		CValue *first = nullptr;
+		unsigned int firstPosition = 0;
+		for (CValue *val : it->second) {
+			const unsigned int position = m_positionIndex.find(val)->second;
+			if (!first || position < firstPosition) {
+				first = val;
+				firstPosition = position;
+			}
+		}
+		return first;
+	}
+
 	const VectorTypeConstIterator it = std::find_if(m_pValueArray.begin(), m_pValueArray.end(),
 										 [&name](CValue *item) { return item->GetName() == name; });
 	
@@ -64,6 +172,10 @@ CValue *CBaseListValue::FindValue(const std::string& name) const
 
 bool CBaseListValue::SearchValue(CValue *val) const
 {
+	if (m_useNameIndex) {
+		return (m_positionIndex.find(val) != m_positionIndex.end());
+	}
+
 	const VectorTypeConstIterator it = std::find(m_pValueArray.begin(), m_pValueArray.end(), val);
 	if (it != m_pValueArray.end()) {
 		return true;
@@ -73,16 +185,40 @@ bool CBaseListValue::SearchValue(CValue *val) const
 
 void CBaseListValue::Add(CValue *value)
 {
+	Compact();
+	if (m_useNameIndex) {
+		IndexValue(value, m_pValueArray.size());
+	}
 	m_pValueArray.push_back(value);
 }
 
 void CBaseListValue::Insert(unsigned int i, CValue *value)
 {
+	Compact();
 	m_pValueArray.insert(m_pValueArray.begin() + i, value);
+	if (m_useNameIndex) {
+		IndexValue(value, i);
+		UpdatePositions(i + 1);
+	}
 }
 
 bool CBaseListValue::RemoveValue(CValue *val)
 {
+	if (m_useNameIndex) {
+		const std::unordered_map<CValue *, unsigned int>::const_iterator it = m_positionIndex.find(val);
+		if (it == m_positionIndex.end()) {
+			return false;
+		}
+
+		const unsigned int i = it->second;
+		UnindexValue(val);
+		/* Erasing the value would shift and update the position of all the next values,
+		 * removing many objects would then be quadratic. Leave a slot erased later. */
+		m_pValueArray[i] = nullptr;
+		m_removedPositions.push_back(i);
+		return true;
+	}
+
 	bool result = false;
 	for (VectorTypeIterator it = m_pValueArray.begin(); it != m_pValueArray.end();) {
 		if (*it == val) {
@@ -96,6 +232,42 @@ bool CBaseListValue::RemoveValue(CValue *val)
 	return result;
 }
 
+bool CBaseListValue::RemoveValueUnordered(CValue *val)
+{
+	if (m_useNameIndex) {
+		Compact();
+
+		const std::unordered_map<CValue *, unsigned int>::const_iterator it = m_positionIndex.find(val);
+		if (it == m_positionIndex.end()) {
+			return false;
+		}
+
+		const unsigned int i = it->second;
+		UnindexValue(val);
+
+		CValue *last = m_pValueArray.back();
+		m_pValueArray.pop_back();
+		if (i < m_pValueArray.size()) {
+			m_pValueArray[i] = last;
+			m_positionIndex[last] = i;
+		}
+		return true;
+	}
+
+	bool result = false;
+	for (unsigned int i = 0; i < m_pValueArray.size();) {
+		if (m_pValueArray[i] == val) {
+			m_pValueArray[i] = m_pValueArray.back();
+			m_pValueArray.pop_back();
+			result = true;
+		}
+		else {
+			++i;
+		}
+	}
+	return result;
+}
+
 bool CBaseListValue::CheckEqual(CValue *first, CValue *second)
 {
 	bool result = false;
@@ -113,6 +285,8 @@ bool CBaseListValue::CheckEqual(CValue *first, CValue *second)
 
 std::string CBaseListValue::GetText()
 {
+	Compact();
+
 	std::string strListRep = "[";
 	std::string commastr = "";
 
@@ -136,27 +310,74 @@ void CBaseListValue::SetReleaseOnDestruct(bool bReleaseContents)
 	m_bReleaseContents = bReleaseContents;
 }
 
+void CBaseListValue::EnableNameIndex(bool enable)
+{
+	Compact();
+	m_useNameIndex = enable;
+	if (m_useNameIndex) {
+		RebuildIndex();
+	}
+	else {
+		m_nameIndex.clear();
+		m_positionIndex.clear();
+	}
+}
+
+void CBaseListValue::RenameValue(CValue *val, const std::string& oldname)
+{
+	if (!m_useNameIndex || m_positionIndex.find(val) == m_positionIndex.end()) {
+		return;
+	}
+
+	const std::unordered_map<std::string, VectorType>::iterator it = m_nameIndex.find(oldname);
+	if (it != m_nameIndex.end()) {
+		VectorType& values = it->second;
+		values.erase(std::find(values.begin(), values.end(), val));
+		if (values.empty()) {
+			m_nameIndex.erase(it);
+		}
+	}
+
+	m_nameIndex[val->GetName()].push_back(val);
+}
+
 void CBaseListValue::Remove(int i)
 {
+	Compact();
+	if (m_useNameIndex) {
+		UnindexValue(m_pValueArray[i]);
+	}
 	m_pValueArray.erase(m_pValueArray.begin() + i);
+	if (m_useNameIndex) {
+		UpdatePositions(i);
+	}
 }
 
 void CBaseListValue::Resize(int num)
 {
+	Compact();
+	if (m_useNameIndex) {
+		for (unsigned int i = num, size = m_pValueArray.size(); i < size; ++i) {
+			UnindexValue(m_pValueArray[i]);
+		}
+	}
 	m_pValueArray.resize(num);
 }
 
 void CBaseListValue::ReleaseAndRemoveAll()
 {
+	Compact();
 	for (CValue *item : m_pValueArray) {
 		item->Release();
 	}
 	m_pValueArray.clear();
+	m_nameIndex.clear();
+	m_positionIndex.clear();
 }
 
 int CBaseListValue::GetCount() const
 {
-	return m_pValueArray.size();
+	return m_pValueArray.size() - m_removedPositions.size();
 }
 
 #ifdef WITH_PYTHON
@@ -466,7 +687,11 @@ PyObject *CBaseListValue::Pyreverse()
 		return nullptr;
 	}
 
+	Compact();
 	std::reverse(m_pValueArray.begin(), m_pValueArray.end());
+	if (m_useNameIndex) {
+		UpdatePositions(0);
+	}
 	Py_RETURN_NONE;
 }
 
@@ -572,6 +797,7 @@ PyObject *CBaseListValue::Pyfilter(PyObject *args)
 	CListValue<CValue> *result = new CListValue<CValue>();
 	result->SetReleaseOnDestruct(false);
 
+	Compact();
 	for (CValue *item : m_pValueArray) {
 		if (strlen(namestr) == 0 || std::regex_match(item->GetName(), namereg)) {
 			if (strlen(propstr) == 0) {
@@ -600,6 +826,7 @@ PyObject *CBaseListValue::Pyfrom_id(PyObject *value)
 		return nullptr;
 	}
 
+	Compact();
 	int numelem = GetCount();
 	for (int i = 0; i < numelem; i++) {
 		if (reinterpret_cast<uintptr_t>(m_pValueArray[i]->m_proxy) == id) {
@@ -51,6 +51,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "CM_Message.h"
+#include "CM_Memory.h"
 
 PyObjectPlus::PyObjectPlus()
 {
@@ -202,6 +203,7 @@ PyObject *PyObjectPlus::py_base_new(PyTypeObject *type, PyObject *args, PyObject
 	 * which is not really 'correct' python OO but for our use its OK. */
 
 	PyObjectPlus_Proxy *ret = (PyObjectPlus_Proxy *)type->tp_alloc(type, 0); // Starts with 1 ref, used for the return ref'.
+	CM_MemoryAdd(CM_MEMORY_PYTHON_PROXY, type->tp_basicsize);
 	ret->ref = base->ref;
 	ret->ptr = base->ptr;
 	ret->py_owns = base->py_owns;
@@ -266,6 +268,8 @@ void PyObjectPlus::py_base_dealloc(PyObject *self)
 			BGE_PROXY_PTR(self) = nullptr; // Not really needed.
 		}
 	}
+	CM_MemoryRemove(CM_MEMORY_PYTHON_PROXY, Py_TYPE(self)->tp_basicsize);
+
 	/* is ok normally but not for subtyping, use tp_free instead. 
 	 * PyObject_DEL(self);
 	 */
@@ -1113,6 +1117,7 @@ PyObject *PyObjectPlus::GetProxyPlus_Ext(PyObjectPlus *self, PyTypeObject *tp, v
 {
 	if (self->m_proxy == nullptr) {
 		self->m_proxy = reinterpret_cast<PyObject *>PyObject_NEW(PyObjectPlus_Proxy, tp);
+		CM_MemoryAdd(CM_MEMORY_PYTHON_PROXY, tp->tp_basicsize);
 		BGE_PROXY_PYOWNS(self->m_proxy) = false;
 		BGE_PROXY_PYREF(self->m_proxy) = true;
 #ifdef USE_WEAKREFS
@@ -1131,6 +1136,7 @@ PyObject *PyObjectPlus::NewProxyPlus_Ext(PyObjectPlus *self, PyTypeObject *tp, v
 	if (!self) {
 		// In case of proxy without reference to game object.
 		PyObject *proxy = reinterpret_cast<PyObject *>PyObject_NEW(PyObjectPlus_Proxy, tp);
+		CM_MemoryAdd(CM_MEMORY_PYTHON_PROXY, tp->tp_basicsize);
 		BGE_PROXY_PYREF(proxy) = false;
 		BGE_PROXY_PYOWNS(proxy) = py_owns;
 		BGE_PROXY_REF(proxy) = nullptr;
@@ -26,6 +26,7 @@
 
 #include "EXP_PythonCallBack.h"
 #include <iostream>
+#include <algorithm>
 #include <stdarg.h>
 
 #include "BLI_alloca.h"
@@ -122,3 +123,24 @@ void RunPythonCallBackList(PyObject *functionlist, PyObject **arglist, unsigned
 		Py_XDECREF(argTuples[i]);
 	}
 }
+
+unsigned int GetPythonCallBackListMaxArgCount(PyObject *functionlist, unsigned int minargcount, unsigned int maxargcount)
+{
+	unsigned int size = PyList_Size(functionlist);
+	unsigned int argcount = minargcount;
+
+	for (unsigned int i = 0; i < size; ++i) {
+		unsigned int funcargcount = 0;
+
+		PyObject *item = PyList_GET_ITEM(functionlist, i);
+		if (CheckPythonFunction(item, minargcount, maxargcount, funcargcount)) {
+			argcount = std::max(argcount, funcargcount);
+		}
+		// The error is reported when running the callbacks.
+		else {
+			PyErr_Clear();
+		}
+	}
+
+	return argcount;
+}
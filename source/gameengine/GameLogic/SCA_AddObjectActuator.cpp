@@ -93,12 +93,18 @@ bool SCA_AddObjectActuator::Update()
 	
 	if (bNegativeEvent) return false; // do nothing on negative events
 
-	InstantAddObject();
+	// The object is added with the other scene mutations at the end of the logic update.
+	m_scene->GetCommandBuffer().AddObject(this, static_cast<KX_GameObject *>(GetParent()), m_OriginalObject);
 
-	
 	return false;
 }
 
+bool SCA_AddObjectActuator::IsOwnerLocal() const
+{
+	// Only records a command in the scene command buffer.
+	return true;
+}
+
 
 
 
@@ -105,6 +105,7 @@ public:
 
 	virtual bool 
 	Update();
+	virtual bool IsOwnerLocal() const;
 
 		KX_GameObject *
 	GetLastCreatedObject(
@@ -68,7 +68,7 @@ void SCA_CollisionSensor::EndFrame()
 void SCA_CollisionSensor::UnregisterToManager()
 {
 	// before unregistering the sensor, make sure we release all references
-	EndFrame();
+	SCA_CollisionSensor::EndFrame();
 	SCA_ISensor::UnregisterToManager();
 }
 
@@ -175,6 +175,9 @@ void SCA_CollisionSensor::RegisterSumo(KX_CollisionEventManager *collisionman)
 }
 void SCA_CollisionSensor::UnregisterSumo(KX_CollisionEventManager *collisionman)
 {
+	// The manager doesn't end the frames of an unregistered sensor, release the colliders now.
+	SCA_CollisionSensor::EndFrame();
+
 	if (m_physCtrl) {
 		if (collisionman->GetPhysicsEnvironment()->RemoveCollisionCallback(m_physCtrl)) {
 			// no more sensor on the controller, can remove it if it is a sensor object
@@ -47,6 +47,7 @@ typedef unsigned long uint_ptr;
 #endif
 
 class KX_CollisionEventManager;
+class PHY_IPhysicsEnvironment;
 
 class SCA_CollisionSensor : public SCA_ISensor
 {
@@ -96,6 +97,11 @@ public:
 
 	virtual bool NewHandleCollision(void *obj1, void *obj2, const PHY_CollData *colldata);
 
+	/// Find the colliders of a sensor not registered in the physics world, called every logic frame.
+	virtual void QueryCollisions(PHY_IPhysicsEnvironment *physEnv)
+	{
+	}
+
 	// Allows to do pre-filtering and save computation time
 	// obj1 = sensor physical controller, obj2 = physical controller of second object
 	// return value = true if collision should be checked on pair of object
@@ -166,6 +166,12 @@ bool SCA_ConstraintActuator::NeedRayCast(KX_ClientObjectInfo *client, void *UNUS
 	return true;
 }
 
+bool SCA_ConstraintActuator::IsOwnerLocal() const
+{
+	// The distance and force field constraints cast rays, the ray tests are not thread safe.
+	return (m_locrot < KX_ACT_CONSTRAINT_DIRPX || (m_locrot >= KX_ACT_CONSTRAINT_ORIX && m_locrot <= KX_ACT_CONSTRAINT_ORIZ));
+}
+
 bool SCA_ConstraintActuator::Update(double curtime)
 {
 
@@ -138,6 +138,7 @@ protected:
 	};
 
 	virtual bool Update(double curtime);
+	virtual bool IsOwnerLocal() const;
 
 	/* --------------------------------------------------------------------- */
 	/* Python interface ---------------------------------------------------- */
@@ -67,11 +67,17 @@ bool SCA_EndObjectActuator::Update()
 
 	if (bNegativeEvent)
 		return false; // do nothing on negative events
-	m_scene->DelayedRemoveObject(static_cast<KX_GameObject *>(GetParent()));
+	m_scene->GetCommandBuffer().EndObject(static_cast<KX_GameObject *>(GetParent()));
 	
 	return false;
 }
 
+bool SCA_EndObjectActuator::IsOwnerLocal() const
+{
+	// Only records a command in the scene command buffer.
+	return true;
+}
+
 
 
 CValue* SCA_EndObjectActuator::GetReplica()
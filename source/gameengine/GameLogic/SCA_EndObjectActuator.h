@@ -59,6 +59,7 @@ class SCA_EndObjectActuator : public SCA_IActuator
 
 	virtual bool 
 	Update();
+	virtual bool IsOwnerLocal() const;
 
 	virtual void Replace_IScene(SCA_IScene *val);
 
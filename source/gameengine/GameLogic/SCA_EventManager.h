@@ -71,6 +71,7 @@ public:
 	virtual void	EndFrame();
 	virtual bool	RegisterSensor(class SCA_ISensor* sensor);
 	int		GetType();
+	SCA_LogicManager *GetLogicManager() { return m_logicmgr; }
 	//SG_DList &GetSensors() { return m_sensors; }
 
 
@@ -66,6 +66,11 @@ bool SCA_IActuator::Update()
 	return false;
 }
 
+bool SCA_IActuator::IsOwnerLocal() const
+{
+	return false;
+}
+
 void SCA_IActuator::AddEvent(bool event)
 {
 	if (event) {
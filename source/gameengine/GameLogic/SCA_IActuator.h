@@ -114,6 +114,13 @@ public:
 	virtual bool Update(double curtime);
 	virtual bool Update();
 
+	/**
+	 * Return true if the update of the actuator only modifies its owner and doesn't run
+	 * Python or modify the scene. The actuators of objects having only owner local
+	 * actuators are updated in parallel, see SCA_LogicManager::UpdateFrame.
+	 */
+	virtual bool IsOwnerLocal() const;
+
 	/**
 	 * Add an event to an actuator.
 	 */
@@ -46,7 +46,8 @@ SCA_IObject::SCA_IObject():
 	CValue(),
 	m_initState(0),
 	m_state(0),
-	m_firstState(nullptr)
+	m_firstState(nullptr),
+	m_actuatorOrder(0)
 {
 	m_suspended = false;
 }
@@ -111,6 +111,11 @@ protected:
 	 */
 	SG_QList*				m_firstState;
 
+	/**
+	 * position of the object in the actuator update of the current frame
+	 */
+	unsigned int			m_actuatorOrder;
+
 public:
 	
 	SCA_IObject();
@@ -203,7 +208,26 @@ public:
 	 */
 	unsigned int GetState(void)	{ return m_state; }
 
+	/**
+	 * Set and get the position of the object in the actuator update, set by the logic manager
+	 * every frame to order the commands recorded by actuators updated in parallel.
+	 */
+	void SetActuatorOrder(unsigned int order) { m_actuatorOrder = order; }
+	unsigned int GetActuatorOrder() const { return m_actuatorOrder; }
+
 	virtual int GetGameObjectType() const {return -1;}
+
+	/**
+	 * Return true if the object is not part of a hierarchy, its owner local actuators
+	 * can then be updated in parallel with the ones of the other objects.
+	 */
+	virtual bool IsIsolated() const { return false; }
+
+	/**
+	 * Called on the main thread after the parallel actuator update for the objects updated
+	 * in parallel, to apply the changes which touch data shared between objects.
+	 */
+	virtual void EndParallelUpdate() {}
 	
 	typedef enum ObjectTypes {
 		OBJ_ARMATURE=0,
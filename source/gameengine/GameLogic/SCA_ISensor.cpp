@@ -53,6 +53,7 @@ SCA_ISensor::SCA_ISensor(SCA_IObject *gameobj, SCA_EventManager *eventmgr)
 	m_skipped_ticks(0),
 	m_pos_ticks(0),
 	m_neg_ticks(0),
+	m_pulse_phase(0),
 	m_invert(false),
 	m_level(false),
 	m_tap(false),
@@ -122,6 +123,10 @@ SCA_ISensor::sensortype SCA_ISensor::GetSensorType()
 
 void SCA_ISensor::Suspend()
 {
+	// A suspended sensor is never evaluated, remove it from its manager until it is resumed.
+	if (!m_suspended && m_links) {
+		m_eventmgr->RemoveSensor(this);
+	}
 	m_suspended = true;
 }
 
@@ -132,6 +137,9 @@ bool SCA_ISensor::IsSuspended()
 
 void SCA_ISensor::Resume()
 {
+	if (m_suspended && m_links) {
+		m_eventmgr->RegisterSensor(this);
+	}
 	m_suspended = false;
 }
 
@@ -195,13 +203,18 @@ void SCA_ISensor::RegisterToManager()
 	// sensor is just activated, initialize it
 	Init();
 	m_state = false;
-	m_eventmgr->RegisterSensor(this);
+	// Replicas get their own phase too.
+	m_pulse_phase = m_eventmgr->GetLogicManager()->NextPulsePhase();
+	// The sensor is registered when resumed.
+	if (!m_suspended) {
+		m_eventmgr->RegisterSensor(this);
+	}
 }
 
 void SCA_ISensor::Replace_EventManager(class SCA_LogicManager *logicmgr)
 {
 	// True if we're used currently.
-	if (m_links) {
+	if (m_links && !m_suspended) {
 		m_eventmgr->RemoveSensor(this);
 		m_eventmgr = logicmgr->FindEventManager(m_eventmgr->GetType());
 		m_eventmgr->RegisterSensor(this);
@@ -265,9 +278,9 @@ void SCA_ISensor::Activate(class SCA_LogicManager *logicmgr)
 			// the sensor triggered this frame
 			if (m_state || !m_tap) {
 				ActivateControllers(logicmgr);
-				// reset these counters so that pulse are synchronized with transition
-				m_pos_ticks = 0;
-				m_neg_ticks = 0;
+				/* reset these counters so that pulse are synchronized with transition,
+				 * the phase avoids all the sensors with the same frequency to pulse in the same frame. */
+				m_pos_ticks = m_neg_ticks = m_pulse_phase % (m_skipped_ticks + 1);
 			}
 			else {
 				result = false;
@@ -280,22 +293,29 @@ void SCA_ISensor::Activate(class SCA_LogicManager *logicmgr)
 			if (m_pos_pulsemode) {
 				m_pos_ticks++;
 				if (m_pos_ticks > m_skipped_ticks) {
-					if (m_state) {
+					if (!m_state) {
+						m_pos_ticks = 0;
+					}
+					// Over the pulse budget the pulse is deferred to the next frame.
+					else if (logicmgr->AddPulse(m_pos_ticks > (m_skipped_ticks + 1))) {
 						ActivateControllers(logicmgr);
 						result = true;
+						m_pos_ticks = 0;
 					}
-					m_pos_ticks = 0;
 				}
 			}
 			// negative pulse doesn't make sense in tap mode, skip
 			if (m_neg_pulsemode && !m_tap) {
 				m_neg_ticks++;
 				if (m_neg_ticks > m_skipped_ticks) {
-					if (!m_state) {
+					if (m_state) {
+						m_neg_ticks = 0;
+					}
+					else if (logicmgr->AddPulse(m_neg_ticks > (m_skipped_ticks + 1))) {
 						ActivateControllers(logicmgr);
 						result = true;
+						m_neg_ticks = 0;
 					}
-					m_neg_ticks = 0;
 				}
 			}
 		}
@@ -66,6 +66,9 @@ protected:
 	/// Number of ticks since the last negative pulse.
 	int m_neg_ticks;
 
+	/// Phase of the pulses, used to stagger the pulses of the sensors with the same frequency.
+	unsigned int m_pulse_phase;
+
 	/// Invert the output signal.
 	bool m_invert;
 
@@ -78,7 +81,7 @@ protected:
 	/// Sensor has been reset.
 	bool m_reset;
 
-	/// Sensor must ignore updates?
+	/// Sensor must ignore updates? A suspended sensor is removed from its event manager.
 	bool m_suspended;
 
 	/// Number of connections to controller.
@@ -145,7 +148,7 @@ public:
 
 	virtual sensortype GetSensorType();
 
-	/// Stop sensing for a while.
+	/// Stop sensing for a while, the sensor is not processed by its event manager until resumed.
 	void Suspend();
 
 	/// Is this sensor switched off?
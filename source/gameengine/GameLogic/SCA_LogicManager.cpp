@@ -39,8 +39,19 @@
 #include "SCA_PythonController.h"
 #include <set>
 
+extern "C" {
+#include "BLI_task.h"
+}
+
+/// Minimum number of objects with owner local actuators to update them on several threads.
+#define SCA_PARALLEL_ACTUATOR_OBJECTS 16
+
 
 SCA_LogicManager::SCA_LogicManager()
+	:m_pulsePhase(0),
+	m_pulseBudget(0),
+	m_numPulses(0),
+	m_parallelUpdate(false)
 {
 }
 
@@ -160,6 +171,8 @@ void SCA_LogicManager::RegisterToActuator(SCA_IController* controller,SCA_IActua
 
 void SCA_LogicManager::BeginFrame(double curtime, double fixedtime)
 {
+	m_numPulses = 0;
+
 	for (std::vector<SCA_EventManager*>::const_iterator ie=m_eventmanagers.begin(); !(ie==m_eventmanagers.end()); ie++)
 		(*ie)->NextFrame(curtime, fixedtime);
 
@@ -179,40 +192,134 @@ void SCA_LogicManager::BeginFrame(double curtime, double fixedtime)
 
 
 
+bool SCA_LogicManager::AddPulse(bool deferred)
+{
+	if (!deferred && m_pulseBudget != 0 && m_numPulses >= m_pulseBudget) {
+		return false;
+	}
+
+	++m_numPulses;
+	return true;
+}
+
+unsigned int SCA_LogicManager::GetPulseBudget() const
+{
+	return m_pulseBudget;
+}
+
+void SCA_LogicManager::SetPulseBudget(unsigned int budget)
+{
+	m_pulseBudget = budget;
+}
+
+bool SCA_LogicManager::IsParallelUpdate() const
+{
+	return m_parallelUpdate;
+}
+
+void SCA_LogicManager::UpdateActuators(SG_QList *ahead, double curtime)
+{
+	SG_QList::iterator<SCA_IActuator> ia(*ahead);
+	for (ia.begin(); !ia.end();  )
+	{
+		SCA_IActuator* actua = *ia;
+		// increment first to allow removal of inactive actuators.
+		++ia;
+		if (!actua->Update(curtime))
+		{
+			// this actuator is not active anymore, remove
+			actua->QDelink(); 
+			actua->SetActive(false); 
+		} else if (actua->IsNoLink())
+		{
+			// This actuator has no more links but it still active
+			// make sure it will get a negative event on next frame to stop it
+			// Do this check after Update() rather than before to make sure
+			// that all the actuators that are activated at same time than a state
+			// actuator have a chance to execute. 
+			bool event = false;
+			actua->RemoveAllEvents();
+			actua->AddEvent(event);
+		}
+	}
+}
+
+struct SCA_ActuatorTaskData
+{
+	SG_QList **objects;
+	double curtime;
+};
+
+void SCA_LogicManager::UpdateActuatorsTask(void *__restrict userdata, const int iter, const TaskParallelTLS *__restrict UNUSED(tls))
+{
+	SCA_ActuatorTaskData *data = static_cast<SCA_ActuatorTaskData *>(userdata);
+	UpdateActuators(data->objects[iter], data->curtime);
+}
+
 void SCA_LogicManager::UpdateFrame(double curtime)
 {
 	for (std::vector<SCA_EventManager*>::const_iterator ie=m_eventmanagers.begin(); !(ie==m_eventmanagers.end()); ie++)
 		(*ie)->UpdateFrame();
 
+	/* The objects outside of a hierarchy with only owner local actuators are updated first
+	 * in parallel, the actuators of an object are always updated together in priority order. */
+	m_localActuatorObjects.clear();
+	m_serialActuatorObjects.clear();
+	m_localActuatorOwners.clear();
+	unsigned int order = 0;
 	SG_DList::iterator<SG_QList> io(m_activeActuators);
-	for (io.begin(); !io.end(); )
+	for (io.begin(); !io.end(); ++io)
 	{
 		SG_QList* ahead = *io;
-		// increment now so that we can remove the current element
-		++io;
 		SG_QList::iterator<SCA_IActuator> ia(*ahead);
-		for (ia.begin(); !ia.end();  )
-		{
-			SCA_IActuator* actua = *ia;
-			// increment first to allow removal of inactive actuators.
-			++ia;
-			if (!actua->Update(curtime))
-			{
-				// this actuator is not active anymore, remove
-				actua->QDelink(); 
-				actua->SetActive(false); 
-			} else if (actua->IsNoLink())
-			{
-				// This actuator has no more links but it still active
-				// make sure it will get a negative event on next frame to stop it
-				// Do this check after Update() rather than before to make sure
-				// that all the actuators that are activated at same time than a state
-				// actuator have a chance to execute. 
-				bool event = false;
-				actua->RemoveAllEvents();
-				actua->AddEvent(event);
+		ia.begin();
+		if (ia.end()) {
+			m_serialActuatorObjects.push_back(ahead);
+			continue;
+		}
+		SCA_IObject *owner = (*ia)->GetParent();
+		// Gives a deterministic order to the scene commands recorded by the actuators.
+		owner->SetActuatorOrder(order++);
+		bool local = owner->IsIsolated();
+		for (; !ia.end() && local; ++ia) {
+			local = (*ia)->IsOwnerLocal();
+		}
+		if (local) {
+			m_localActuatorObjects.push_back(ahead);
+			m_localActuatorOwners.push_back(owner);
+		}
+		else {
+			m_serialActuatorObjects.push_back(ahead);
+		}
+	}
+
+	if (!m_localActuatorObjects.empty()) {
+		SCA_ActuatorTaskData data = {m_localActuatorObjects.data(), curtime};
+
+		TaskParallelSettings settings;
+		BLI_parallel_range_settings_defaults(&settings);
+		settings.use_threading = (m_localActuatorObjects.size() >= SCA_PARALLEL_ACTUATOR_OBJECTS);
+		m_parallelUpdate = true;
+		BLI_task_parallel_range(0, m_localActuatorObjects.size(), &data, UpdateActuatorsTask, &settings);
+		m_parallelUpdate = false;
+
+		for (SCA_IObject *owner : m_localActuatorOwners) {
+			owner->EndParallelUpdate();
+		}
+
+		// The main list is only modified on this thread.
+		for (SG_QList *ahead : m_localActuatorObjects) {
+			if (ahead->QEmpty()) {
+				// no more active controller, remove from main list
+				ahead->Delink();
 			}
 		}
+	}
+
+	// The other actuators can run Python or modify the scene, they are updated serially.
+	for (SG_QList *ahead : m_serialActuatorObjects)
+	{
+		UpdateActuators(ahead, curtime);
 		if (ahead->QEmpty())
 		{
 			// no more active controller, remove from main list
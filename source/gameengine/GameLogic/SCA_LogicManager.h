@@ -83,6 +83,26 @@ class SCA_LogicManager
 
 	std::map<std::string, void *>		m_map_gamemeshname_to_blendobj;
 	std::map<void *, CValue *>			m_map_blendobj_to_gameobj;
+
+	/// Counter used to stagger the pulses of the sensors.
+	unsigned int m_pulsePhase;
+	/// Maximum number of sensor pulses per frame, 0 for no limit.
+	unsigned int m_pulseBudget;
+	/// Number of sensor pulses sent in the current frame.
+	unsigned int m_numPulses;
+
+	/// Objects of m_activeActuators updated in parallel and serially in the current frame.
+	std::vector<SG_QList *> m_localActuatorObjects;
+	std::vector<SG_QList *> m_serialActuatorObjects;
+	/// Owners of the objects of m_localActuatorObjects, the actuator lists can be emptied by the update.
+	std::vector<class SCA_IObject *> m_localActuatorOwners;
+	/// True while the owner local actuators are updated in parallel.
+	bool m_parallelUpdate;
+
+	/// Update the active actuators of an object, the inactive actuators are removed from the object list.
+	static void UpdateActuators(SG_QList *ahead, double curtime);
+	static void UpdateActuatorsTask(void *__restrict userdata, const int iter, const struct TaskParallelTLS *__restrict tls);
+
 public:
 	SCA_LogicManager();
 	virtual ~SCA_LogicManager();
@@ -105,6 +125,19 @@ public:
 	}
 
 	void	AddTriggeredController(SCA_IController* controller, SCA_ISensor* sensor);
+
+	/// Return a different phase for each sensor registered.
+	unsigned int NextPulsePhase()
+	{
+		return m_pulsePhase++;
+	}
+	/** Count a pulse of a sensor, return false if the pulse must be deferred to the next frame.
+	 * \param deferred True if the pulse was already deferred, it is always accepted.
+	 */
+	bool AddPulse(bool deferred);
+	unsigned int GetPulseBudget() const;
+	void SetPulseBudget(unsigned int budget);
+	bool IsParallelUpdate() const;
 	SCA_EventManager*	FindEventManager(int eventmgrtype);
 	std::vector<class SCA_EventManager*>	GetEventManagers() { return m_eventmanagers; }
 
@@ -48,14 +48,19 @@ SCA_NearSensor::SCA_NearSensor(SCA_EventManager* eventmgr,
 							 float resetmargin,
 							 bool bFindMaterial,
 							 const std::string& touchedpropname,
-							 PHY_IPhysicsController* ctrl)
+							 PHY_IPhysicsController* ctrl,
+							 bool query,
+							 int querySkip)
 							:SCA_CollisionSensor(eventmgr,
 							 gameobj,
 							 bFindMaterial,
 							 false,
 							 touchedpropname),
 			 m_Margin(margin),
-			 m_ResetMargin(resetmargin)
+			 m_ResetMargin(resetmargin),
+			 m_query(query),
+			 m_querySkip(querySkip),
+			 m_queryCounter(0)
 
 {
 
@@ -77,7 +82,8 @@ void SCA_NearSensor::SynchronizeTransform()
 {
 	// The near and radar sensors are using a different physical object which is 
 	// not linked to the parent object, must synchronize it.
-	if (m_physCtrl)
+	// In query mode the object is only used by the queries.
+	if (m_physCtrl && !(m_query && m_queryCounter > 0))
 	{
 		PHY_IMotionState* motionState = m_physCtrl->GetMotionState();
 		KX_GameObject* parent = ((KX_GameObject*)GetParent());
@@ -174,6 +180,62 @@ bool SCA_NearSensor::Evaluate()
 	return result;
 }
 
+void SCA_NearSensor::EndFrame()
+{
+	// In query mode the colliders are kept until the next query.
+	if (m_query && m_queryCounter > 0) {
+		return;
+	}
+
+	SCA_CollisionSensor::EndFrame();
+}
+
+void SCA_NearSensor::RegisterSumo(KX_CollisionEventManager *collisionman)
+{
+	if (m_query) {
+		// The physics object is never added to the physics world, the queries are staggered over the skipped frames.
+		m_queryCounter = collisionman->NextQueryPhase() % (m_querySkip + 1);
+		return;
+	}
+
+	SCA_CollisionSensor::RegisterSumo(collisionman);
+}
+
+void SCA_NearSensor::UnregisterSumo(KX_CollisionEventManager *collisionman)
+{
+	if (m_query) {
+		SCA_CollisionSensor::EndFrame();
+		return;
+	}
+
+	SCA_CollisionSensor::UnregisterSumo(collisionman);
+}
+
+void SCA_NearSensor::QueryCollisions(PHY_IPhysicsEnvironment *physEnv)
+{
+	if (!m_query || !m_physCtrl) {
+		return;
+	}
+
+	if (m_queryCounter > 0) {
+		--m_queryCounter;
+		return;
+	}
+	m_queryCounter = m_querySkip;
+
+	// Same check as in NewHandleCollision, no need to query for an inactive sensor.
+	if (!m_links || m_suspended) {
+		return;
+	}
+
+	// The colliders of the last query are released at the end of the previous frame.
+	std::vector<PHY_IPhysicsController *> controllers;
+	physEnv->ContactTest(m_physCtrl, controllers);
+	for (PHY_IPhysicsController *ctrl : controllers) {
+		NewHandleCollision(m_physCtrl, ctrl, nullptr);
+	}
+}
+
 // this function is called at broad phase stage to check if the two controller
 // need to interact at all. It is used for Near/Radar sensor that don't need to
 // check collision with object not included in filter
@@ -283,6 +345,8 @@ PyMethodDef SCA_NearSensor::Methods[] = {
 PyAttributeDef SCA_NearSensor::Attributes[] = {
 	KX_PYATTRIBUTE_FLOAT_RW_CHECK("distance", 0, 10000, SCA_NearSensor, m_Margin, CheckResetDistance),
 	KX_PYATTRIBUTE_FLOAT_RW_CHECK("resetDistance", 0, 10000, SCA_NearSensor, m_ResetMargin, CheckResetDistance),
+	KX_PYATTRIBUTE_BOOL_RO("useQuery", SCA_NearSensor, m_query),
+	KX_PYATTRIBUTE_INT_RW("querySkip", 0, 1000, true, SCA_NearSensor, m_querySkip),
 	KX_PYATTRIBUTE_NULL //Sentinel
 };
 
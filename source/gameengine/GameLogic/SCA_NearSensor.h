@@ -47,6 +47,13 @@ protected:
 	float  m_ResetMargin;
 
 	KX_ClientObjectInfo*	m_client_info;
+
+	/// Test the overlapping objects with a query instead of registering the sensor in the physics world.
+	bool m_query;
+	/// Number of frames skipped between two queries.
+	int m_querySkip;
+	/// Number of frames left before the next query.
+	int m_queryCounter;
 public:
 	SCA_NearSensor(class SCA_EventManager* eventmgr,
 	              class KX_GameObject* gameobj,
@@ -54,7 +61,9 @@ public:
 	              float resetmargin,
 	              bool bFindMaterial,
 	              const std::string& touchedpropname,
-	              PHY_IPhysicsController*	ctrl);
+	              PHY_IPhysicsController*	ctrl,
+	              bool query,
+	              int querySkip);
 #if 0
 public:
 	SCA_NearSensor(class SCA_EventManager* eventmgr,
@@ -71,6 +80,11 @@ public:
 	virtual void ProcessReplica();
 	virtual void SetPhysCtrlRadius();
 	virtual bool Evaluate();
+	virtual void EndFrame();
+
+	virtual void RegisterSumo(KX_CollisionEventManager *collisionman);
+	virtual void UnregisterSumo(KX_CollisionEventManager *collisionman);
+	virtual void QueryCollisions(PHY_IPhysicsEnvironment *physEnv);
 
 	virtual void ReParent(SCA_IObject* parent);
 	virtual bool	NewHandleCollision(void* obj1,void* obj2,
@@ -334,6 +334,12 @@ bool SCA_ObjectActuator::Update()
 
 
 
+bool SCA_ObjectActuator::IsOwnerLocal() const
+{
+	// The servo control reads the transform and velocity of the reference object.
+	return (m_reference == nullptr);
+}
+
 CValue* SCA_ObjectActuator::GetReplica()
 {
 	SCA_ObjectActuator* replica = new SCA_ObjectActuator(*this);//m_float,GetName());
@@ -161,6 +161,7 @@ public:
 			m_angular_length2 = (m_bitLocalFlag.ZeroAngularVelocity) ? 0.0f : m_angular_velocity.length2();
 		}
 	virtual bool Update();
+	virtual bool IsOwnerLocal() const;
 
 #ifdef WITH_PYTHON
 
@@ -35,6 +35,7 @@
 
 #include "SCA_ParentActuator.h"
 #include "KX_GameObject.h"
+#include "KX_Scene.h"
 #include "KX_Globals.h"
 
 #include "EXP_PyObjectPlus.h" 
@@ -117,19 +118,26 @@ bool SCA_ParentActuator::Update()
 		return false; // do nothing on negative events
 
 	KX_GameObject *obj = (KX_GameObject*) GetParent();
+	KX_SceneCommandBuffer& commandBuffer = obj->GetScene()->GetCommandBuffer();
 	switch (m_mode) {
 		case KX_PARENT_SET:
 			if (m_ob)
-				obj->SetParent((KX_GameObject*)m_ob, m_addToCompound, m_ghost);
+				commandBuffer.SetParent(obj, (KX_GameObject*)m_ob, m_addToCompound, m_ghost);
 			break;
 		case KX_PARENT_REMOVE:
-			obj->RemoveParent();
+			commandBuffer.RemoveParent(obj);
 			break;
 	};
 	
 	return false;
 }
 
+bool SCA_ParentActuator::IsOwnerLocal() const
+{
+	// Only records a command in the scene command buffer.
+	return true;
+}
+
 #ifdef WITH_PYTHON
 
 /* ------------------------------------------------------------------------- */
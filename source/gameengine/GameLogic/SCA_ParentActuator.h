@@ -68,6 +68,7 @@ public:
 						SCA_IObject *ob);
 	virtual ~SCA_ParentActuator();
 	virtual bool Update();
+	virtual bool IsOwnerLocal() const;
 	
 	virtual CValue* GetReplica();
 	virtual void ProcessReplica();
@@ -49,7 +49,9 @@ SCA_RadarSensor::SCA_RadarSensor(SCA_EventManager* eventmgr,
 			double margin,
 			double resetmargin,
 			bool bFindMaterial,
-			const std::string& touchedpropname)
+			const std::string& touchedpropname,
+			bool query,
+			int querySkip)
 
 			: SCA_NearSensor(
 				eventmgr,
@@ -59,7 +61,9 @@ SCA_RadarSensor::SCA_RadarSensor(SCA_EventManager* eventmgr,
 				resetmargin,
 				bFindMaterial,
 				touchedpropname,
-				physCtrl),
+				physCtrl,
+				query,
+				querySkip),
 
 				m_coneradius(coneradius),
 				m_coneheight(coneheight),
@@ -88,6 +92,11 @@ CValue* SCA_RadarSensor::GetReplica()
  *	for usage.  */
 void SCA_RadarSensor::SynchronizeTransform()
 {
+	// In query mode the cone is only used by the queries.
+	if (m_query && m_queryCounter > 0) {
+		return;
+	}
+
 	// Getting the parent location was commented out. Why?
 	MT_Transform trans;
 	trans.setOrigin(((KX_GameObject*)GetParent())->NodeGetWorldPosition());
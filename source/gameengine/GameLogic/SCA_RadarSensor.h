@@ -72,7 +72,9 @@ public:
 			double margin,
 			double resetmargin,
 			bool bFindMaterial,
-			const std::string& touchedpropname);
+			const std::string& touchedpropname,
+			bool query,
+			int querySkip);
 	SCA_RadarSensor();
 	virtual ~SCA_RadarSensor();
 	virtual void SynchronizeTransform();
@@ -49,12 +49,17 @@ typedef float sample_t;
 #include "KX_PyMath.h" // needed for PyObjectFrom()
 #include "KX_Globals.h"
 #include "KX_Camera.h"
+#include "KX_Scene.h"
+#include "KX_SoundManager.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 /* ------------------------------------------------------------------------- */
 /* Native functions                                                          */
 /* ------------------------------------------------------------------------- */
 SCA_SoundActuator::SCA_SoundActuator(SCA_IObject* gameobj,
+								   KX_SoundManager *soundManager,
 #ifdef WITH_AUDASPACE
 								   AUD_Sound* sound,
 #endif  // WITH_AUDASPACE
@@ -63,7 +68,12 @@ SCA_SoundActuator::SCA_SoundActuator(SCA_IObject* gameobj,
 								   bool is3d,
 								   KX_3DSoundSettings settings,
 								   KX_SOUNDACT_TYPE type)//,
-								   : SCA_IActuator(gameobj, KX_ACT_SOUND)
+								   : SCA_IActuator(gameobj, KX_ACT_SOUND),
+								   m_soundManager(soundManager),
+								   m_virtual(false),
+								   m_virtualPosition(0.0),
+								   m_length(-1.0f),
+								   m_loop(false)
 {
 #ifdef WITH_AUDASPACE
 	m_sound = sound ? AUD_Sound_copy(sound) : nullptr;
@@ -81,6 +91,10 @@ SCA_SoundActuator::SCA_SoundActuator(SCA_IObject* gameobj,
 
 SCA_SoundActuator::~SCA_SoundActuator()
 {
+	if (m_soundManager) {
+		m_soundManager->RemoveVoice(this);
+	}
+
 #ifdef WITH_AUDASPACE
 	if (m_handle) {
 		AUD_Handle_stop(m_handle);
@@ -92,13 +106,21 @@ SCA_SoundActuator::~SCA_SoundActuator()
 #endif  // WITH_AUDASPACE
 }
 
-void SCA_SoundActuator::play()
+void SCA_SoundActuator::stop()
 {
 #ifdef WITH_AUDASPACE
 	if (m_handle) {
 		AUD_Handle_stop(m_handle);
 		m_handle = nullptr;
 	}
+	m_virtual = false;
+#endif  // WITH_AUDASPACE
+}
+
+void SCA_SoundActuator::play()
+{
+#ifdef WITH_AUDASPACE
+	stop();
 
 	if (!m_sound)
 		return;
@@ -149,6 +171,14 @@ void SCA_SoundActuator::play()
 			AUD_Handle_setLoopCount(m_handle, -1);
 		AUD_Handle_setPitch(m_handle, m_pitch);
 		AUD_Handle_setVolume(m_handle, m_volume);
+
+		m_loop = loop;
+		// The length depends on the ping pong, it is computed only if the voice becomes virtual.
+		m_length = -1.0f;
+
+		if (m_soundManager) {
+			m_soundManager->AddVoice(this);
+		}
 	}
 
 	m_isplaying = true;
@@ -165,12 +195,93 @@ CValue* SCA_SoundActuator::GetReplica()
 void SCA_SoundActuator::ProcessReplica()
 {
 	SCA_IActuator::ProcessReplica();
+	m_virtual = false;
 #ifdef WITH_AUDASPACE
 	m_handle = nullptr;
 	m_sound = AUD_Sound_copy(m_sound);
 #endif  // WITH_AUDASPACE
 }
 
+bool SCA_SoundActuator::IsVoicePlaying() const
+{
+#ifdef WITH_AUDASPACE
+	return m_handle && (m_virtual || AUD_Handle_getStatus(m_handle) == AUD_STATUS_PLAYING);
+#else
+	return false;
+#endif  // WITH_AUDASPACE
+}
+
+bool SCA_SoundActuator::IsVirtualVoice() const
+{
+	return m_virtual;
+}
+
+void SCA_SoundActuator::SetVirtualVoice(bool virt)
+{
+#ifdef WITH_AUDASPACE
+	if (virt == m_virtual || !m_handle) {
+		return;
+	}
+
+	if (virt) {
+		if (m_length < 0.0f) {
+			m_length = AUD_getInfo(m_sound).length;
+			if (m_type == KX_SOUNDACT_LOOPBIDIRECTIONAL || m_type == KX_SOUNDACT_LOOPBIDIRECTIONAL_STOP) {
+				m_length *= 2.0f;
+			}
+		}
+		m_virtualPosition = AUD_Handle_getPosition(m_handle);
+		AUD_Handle_pause(m_handle);
+	}
+	else {
+		AUD_Handle_setPosition(m_handle, m_virtualPosition);
+		AUD_Handle_resume(m_handle);
+	}
+
+	m_virtual = virt;
+#endif  // WITH_AUDASPACE
+}
+
+void SCA_SoundActuator::UpdateVirtualVoice(double deltatime)
+{
+	m_virtualPosition += deltatime * m_pitch;
+
+	// An unknown length is treated as an endless sound.
+	if (m_length > 0.0f && m_virtualPosition >= m_length) {
+		if (m_loop) {
+			m_virtualPosition = std::fmod(m_virtualPosition, (double)m_length);
+		}
+		else {
+			stop();
+		}
+	}
+}
+
+float SCA_SoundActuator::GetAudibility()
+{
+	if (!m_is3d) {
+		return m_volume;
+	}
+
+	KX_GameObject *obj = (KX_GameObject *)GetParent();
+	KX_Camera *cam = obj->GetScene()->GetActiveCamera();
+	if (!cam) {
+		return m_volume;
+	}
+
+	// Same inverse distance clamped attenuation as the audio device.
+	const float reference = m_3d.reference_distance;
+	float distance = std::max((obj->NodeGetWorldPosition() - cam->NodeGetWorldPosition()).length(), reference);
+	if (m_3d.max_distance > 0.0f) {
+		distance = std::min(distance, m_3d.max_distance);
+	}
+
+	const float denominator = reference + m_3d.rolloff_factor * (distance - reference);
+	const float gain = (denominator > 0.0f) ? reference / denominator : 1.0f;
+
+	return m_volume * std::min(std::max(gain, m_3d.min_gain), m_3d.max_gain);
+}
+
 bool SCA_SoundActuator::Update(double curtime)
 {
 	bool result = false;
@@ -187,8 +298,8 @@ bool SCA_SoundActuator::Update(double curtime)
 	if (!m_sound)
 		return false;
 
-	// actual audio device playing state
-	bool isplaying = m_handle ? (AUD_Handle_getStatus(m_handle) == AUD_STATUS_PLAYING) : false;
+	// actual audio device playing state, a virtual voice is still playing
+	bool isplaying = IsVoicePlaying();
 
 	if (bNegativeEvent)
 	{
@@ -202,11 +313,7 @@ bool SCA_SoundActuator::Update(double curtime)
 			case KX_SOUNDACT_LOOPBIDIRECTIONAL_STOP:
 				{
 					// stop immediately
-					if (m_handle)
-					{
-						AUD_Handle_stop(m_handle);
-						m_handle = nullptr;
-					}
+					stop();
 					break;
 				}
 			case KX_SOUNDACT_PLAYEND:
@@ -220,6 +327,7 @@ bool SCA_SoundActuator::Update(double curtime)
 					// stop the looping so that the sound stops when it finished
 					if (m_handle)
 						AUD_Handle_setLoopCount(m_handle, 0);
+					m_loop = false;
 					break;
 				}
 			default:
@@ -246,11 +354,12 @@ bool SCA_SoundActuator::Update(double curtime)
 			play();
 	}
 	// verify that the sound is still playing
-	isplaying = m_handle ? (AUD_Handle_getStatus(m_handle) == AUD_STATUS_PLAYING) : false;
+	isplaying = IsVoicePlaying();
 
 	if (isplaying)
 	{
-		if (m_is3d)
+		// a virtual voice isn't mixed, its 3D settings are updated once it becomes audible
+		if (m_is3d && !m_virtual)
 		{
 			KX_Camera* cam = KX_GetActiveScene()->GetActiveCamera();
 			if (cam)
@@ -348,11 +457,15 @@ KX_PYMETHODDEF_DOC_NOARGS(SCA_SoundActuator, startSound,
 "\tStarts the sound.\n")
 {
 #ifdef WITH_AUDASPACE
-	switch (m_handle ? AUD_Handle_getStatus(m_handle) : AUD_STATUS_INVALID) {
+	// a virtual voice is paused by the voice budget but still playing
+	switch (m_virtual ? AUD_STATUS_PLAYING : (m_handle ? AUD_Handle_getStatus(m_handle) : AUD_STATUS_INVALID)) {
 		case AUD_STATUS_PLAYING:
 			break;
 		case AUD_STATUS_PAUSED:
 			AUD_Handle_resume(m_handle);
+			if (m_soundManager) {
+				m_soundManager->AddVoice(this);
+			}
 			break;
 		default:
 			play();
@@ -367,8 +480,14 @@ KX_PYMETHODDEF_DOC_NOARGS(SCA_SoundActuator, pauseSound,
 "\tPauses the sound.\n")
 {
 #ifdef WITH_AUDASPACE
-	if (m_handle)
+	if (m_handle) {
+		// the handle of a virtual voice is already paused, only its position is behind
+		if (m_virtual) {
+			AUD_Handle_setPosition(m_handle, m_virtualPosition);
+			m_virtual = false;
+		}
 		AUD_Handle_pause(m_handle);
+	}
 #endif  // WITH_AUDASPACE
 
 	Py_RETURN_NONE;
@@ -378,13 +497,7 @@ KX_PYMETHODDEF_DOC_NOARGS(SCA_SoundActuator, stopSound,
 "stopSound()\n"
 "\tStops the sound.\n")
 {
-#ifdef WITH_AUDASPACE
-	if (m_handle)
-	{
-		AUD_Handle_stop(m_handle);
-		m_handle = nullptr;
-	}
-#endif  // WITH_AUDASPACE
+	stop();
 
 	Py_RETURN_NONE;
 }
@@ -435,7 +548,9 @@ PyObject *SCA_SoundActuator::pyattr_get_audposition(PyObjectPlus *self, const st
 #ifdef WITH_AUDASPACE
 	SCA_SoundActuator * actuator = static_cast<SCA_SoundActuator *> (self);
 
-	if (actuator->m_handle)
+	if (actuator->m_virtual)
+		position = actuator->m_virtualPosition;
+	else if (actuator->m_handle)
 		position = AUD_Handle_getPosition(actuator->m_handle);
 #endif  // WITH_AUDASPACE
 
@@ -562,7 +677,9 @@ int SCA_SoundActuator::pyattr_set_audposition(PyObjectPlus *self, const struct K
 #ifdef WITH_AUDASPACE
 	SCA_SoundActuator * actuator = static_cast<SCA_SoundActuator *> (self);
 
-	if (actuator->m_handle)
+	if (actuator->m_virtual)
+		actuator->m_virtualPosition = position;
+	else if (actuator->m_handle)
 		AUD_Handle_setPosition(actuator->m_handle, position);
 #endif  // WITH_AUDASPACE
 
@@ -620,6 +737,7 @@ int SCA_SoundActuator::pyattr_set_sound(PyObjectPlus *self, const struct KX_PYAT
 
 	AUD_Sound_free(actuator->m_sound);
 	actuator->m_sound = snd;
+	actuator->m_length = -1.0f;
 #endif  // WITH_AUDASPACE
 
 	return PY_SET_ATTR_SUCCESS;
@@ -41,6 +41,8 @@
 
 #include "BKE_sound.h"
 
+class KX_SoundManager;
+
 typedef struct KX_3DSoundSettings {
 	float min_gain;
 	float max_gain;
@@ -60,12 +62,24 @@ class SCA_SoundActuator : public SCA_IActuator
 	AUD_Sound*				m_sound;
 	AUD_Handle*				m_handle;
 #endif  // WITH_AUDASPACE
+	/// Manager registering the playing actuators as voices.
+	KX_SoundManager*		m_soundManager;
+	/// The handle is paused by the voice budget, the position is advanced by m_virtualPosition.
+	bool					m_virtual;
+	/// Playback position of a virtual voice in seconds.
+	double					m_virtualPosition;
+	/// Length of the played sound in seconds, negative when not computed yet.
+	float					m_length;
+	/// The played sound is looping.
+	bool					m_loop;
 	float					m_volume;
 	float					m_pitch;
 	bool					m_is3d;
 	KX_3DSoundSettings		m_3d;
 
 	void play();
+	/// Stop and release the handle.
+	void stop();
 
 public:
 
@@ -84,6 +98,7 @@ public:
 	KX_SOUNDACT_TYPE		m_type;
 
 	SCA_SoundActuator(SCA_IObject* gameobj,
+					 KX_SoundManager *soundManager,
 #ifdef WITH_AUDASPACE
 					 AUD_Sound *sound,
 #endif  // WITH_AUDASPACE
@@ -100,6 +115,18 @@ public:
 	CValue* GetReplica();
 	void ProcessReplica();
 
+	/// Return true if the sound is played, mixed or virtual.
+	bool IsVoicePlaying() const;
+	bool IsVirtualVoice() const;
+	/** Make the voice virtual or mixed, a virtual voice keeps its position
+	 * but its handle is paused.
+	 */
+	void SetVirtualVoice(bool virt);
+	/// Advance the position of a virtual voice, stop it at the end of a non looping sound.
+	void UpdateVirtualVoice(double deltatime);
+	/// Return the volume of the sound heard from the active camera, used to prioritize the voices.
+	float GetAudibility();
+
 #ifdef WITH_PYTHON
 
 	/* -------------------------------------------------------------------- */
@@ -74,6 +74,7 @@ SCA_SteeringActuator::SCA_SteeringActuator(SCA_IObject *gameobj,
       m_facingMode(facingmode),
       m_normalUp(normalup),
       m_pathLen(0),
+      m_pathTicket(-1),
       m_pathUpdatePeriod(pathUpdatePeriod),
       m_lockzvel(lockzvel),
       m_wayPointIdx(-1),
@@ -98,6 +99,7 @@ SCA_SteeringActuator::SCA_SteeringActuator(SCA_IObject *gameobj,
 
 SCA_SteeringActuator::~SCA_SteeringActuator()
 {
+	CancelPathRequest();
 	if (m_navmesh)
 		m_navmesh->UnregisterActuator(this);
 	if (m_target)
@@ -114,6 +116,8 @@ CValue* SCA_SteeringActuator::GetReplica()
 
 void SCA_SteeringActuator::ProcessReplica()
 {
+	// The request belongs to the original actuator.
+	m_pathTicket = -1;
 	if (m_target)
 		m_target->RegisterActuator(this);
 	if (m_navmesh)
@@ -138,6 +142,7 @@ bool SCA_SteeringActuator::UnlinkObject(SCA_IObject* clientobj)
 	else if (clientobj == m_navmesh)
 	{
 		m_navmesh = nullptr;
+		m_pathTicket = -1;
 		return true;
 	}
 	return false;
@@ -155,6 +160,7 @@ void SCA_SteeringActuator::Relink(std::map<SCA_IObject *, SCA_IObject *>& obj_ma
 
 	KX_NavMeshObject *navobj = static_cast<KX_NavMeshObject *>(obj_map[m_navmesh]);
 	if (navobj) {
+		CancelPathRequest();
 		if (m_navmesh)
 			m_navmesh->UnregisterActuator(this);
 		m_navmesh = navobj;
@@ -162,6 +168,20 @@ void SCA_SteeringActuator::Relink(std::map<SCA_IObject *, SCA_IObject *>& obj_ma
 	}
 }
 
+void SCA_SteeringActuator::CancelPathRequest()
+{
+	if (m_navmesh && m_pathTicket != -1)
+		m_navmesh->CancelPath(m_pathTicket);
+	m_pathTicket = -1;
+}
+
+bool SCA_SteeringActuator::IsOwnerLocal() const
+{
+	/* The navigation mesh, the obstacle simulation and the debug drawing are shared,
+	 * the transform of the target object could be modified by an other thread. */
+	return (!m_target && !m_navmesh && !(m_simulation && m_obstacle) && !m_enableVisualization);
+}
+
 bool SCA_SteeringActuator::Update(double curtime)
 {
 	double delta =  curtime - m_updateTime;
@@ -171,6 +191,10 @@ bool SCA_SteeringActuator::Update(double curtime)
 	{
 		delta = 0.0;
 		m_pathUpdateTime = -1.0;
+		CancelPathRequest();
+		// The path of a previous activation is outdated.
+		m_pathLen = 0;
+		m_wayPointIdx = -1;
 		m_updateTime = curtime;
 		m_isActive = true;
 	}
@@ -222,12 +246,30 @@ bool SCA_SteeringActuator::Update(double curtime)
 
 				static const MT_Scalar WAYPOINT_RADIUS(0.25f);
 
-				if (m_pathUpdateTime<0 || (m_pathUpdatePeriod>=0 && 
-											curtime - m_pathUpdateTime>((double)m_pathUpdatePeriod/1000.0)))
+				// The path requested in a previous frame replaces the current one once solved.
+				if (m_pathTicket != -1)
+				{
+					const int pathLen = m_navmesh->PollPath(m_pathTicket, m_path, MAX_PATH_LENGTH);
+					if (pathLen != -1)
+					{
+						m_pathTicket = -1;
+						m_pathLen = pathLen;
+						m_wayPointIdx = m_pathLen > 1 ? 1 : -1;
+					}
+				}
+
+				if (m_pathTicket == -1 && (m_pathUpdateTime<0 || (m_pathUpdatePeriod>=0 &&
+											curtime - m_pathUpdateTime>((double)m_pathUpdatePeriod/1000.0))))
 				{
 					m_pathUpdateTime = curtime;
-					m_pathLen = m_navmesh->FindPath(mypos, targpos, m_path, MAX_PATH_LENGTH);
-					m_wayPointIdx = m_pathLen > 1 ? 1 : -1;
+					if (m_pathLen == 0) {
+						// No path to follow yet, don't wait for the next frame.
+						m_pathLen = m_navmesh->FindPath(mypos, targpos, m_path, MAX_PATH_LENGTH);
+						m_wayPointIdx = m_pathLen > 1 ? 1 : -1;
+					}
+					else {
+						m_pathTicket = m_navmesh->RequestPath(mypos, targpos);
+					}
 				}
 
 				if (m_wayPointIdx>0)
@@ -360,6 +402,10 @@ inline void flipAxes(float* vec)
 
 static bool getNavmeshNormal(dtStatNavMesh* navmesh, const MT_Vector3& pos, MT_Vector3& normal)
 {
+	// Tiled navigation meshes don't expose their detail meshes.
+	if (!navmesh)
+		return false;
+
 	static const float polyPickExt[3] = {2, 4, 2};
 	float spos[3];
 	pos.getValue(spos);
@@ -615,6 +661,7 @@ int SCA_SteeringActuator::pyattr_set_navmesh(PyObjectPlus *self, const struct KX
 		return PY_SET_ATTR_FAIL;
 	}
 
+	actuator->CancelPathRequest();
 	if (actuator->m_navmesh != nullptr)
 		actuator->m_navmesh->UnregisterActuator(actuator);
 
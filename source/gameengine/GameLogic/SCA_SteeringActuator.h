@@ -60,12 +60,17 @@ class SCA_SteeringActuator : public SCA_IActuator
 	bool m_normalUp;
 	float m_path[MAX_PATH_LENGTH*3];
 	int m_pathLen;
+	/// Ticket of the path request being solved by the navigation mesh, -1 if none.
+	int m_pathTicket;
 	int m_pathUpdatePeriod;
 	double m_pathUpdateTime;
 	bool m_lockzvel;
 	int m_wayPointIdx;
 	MT_Matrix3x3 m_parentlocalmat;
 	MT_Vector3 m_steerVec;
+
+	/// Cancel the path request of the current navigation mesh.
+	void CancelPathRequest();
 	void HandleActorFace(MT_Vector3& velocity);
 public:
 	enum KX_STEERINGACT_MODE
@@ -94,6 +99,7 @@ public:
 	                    bool lockzvel);
 	virtual ~SCA_SteeringActuator();
 	virtual bool Update(double curtime);
+	virtual bool IsOwnerLocal() const;
 
 	virtual CValue* GetReplica();
 	virtual void ProcessReplica();
@@ -303,6 +303,12 @@ void SCA_TrackToActuator::Relink(std::map<SCA_IObject *, SCA_IObject *>& obj_map
 }
 
 
+bool SCA_TrackToActuator::IsOwnerLocal() const
+{
+	// The transform of the target object could be modified by an other thread.
+	return (m_object == nullptr);
+}
+
 bool SCA_TrackToActuator::Update(double curtime)
 {
 	bool result = false;
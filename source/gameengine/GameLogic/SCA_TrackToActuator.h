@@ -67,6 +67,7 @@ class SCA_TrackToActuator : public SCA_IActuator
 	virtual bool UnlinkObject(SCA_IObject* clientobj);
 	virtual void Relink(std::map<SCA_IObject *, SCA_IObject *>& obj_map);
 	virtual bool Update(double curtime);
+	virtual bool IsOwnerLocal() const;
 
 	//Python Interface
 	enum UpAxis {
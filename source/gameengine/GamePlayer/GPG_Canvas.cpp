@@ -43,6 +43,7 @@
 
 #include "BKE_image.h"
 #include "MEM_guardedalloc.h"
+#include "DNA_scene_types.h"
 #include "DNA_space_types.h"
 
 GPG_Canvas::GPG_Canvas(RAS_Rasterizer *rasty, GHOST_IWindow *window, Scene *startscene)
@@ -57,6 +58,10 @@ GPG_Canvas::GPG_Canvas(RAS_Rasterizer *rasty, GHOST_IWindow *window, Scene *star
 		m_window->getClientBounds(bnds);
 		this->Resize(bnds.getWidth(), bnds.getHeight());
 	}
+	else {
+		// Without window (headless) the canvas uses the player resolution of the scene.
+		this->Resize(m_startScene->gm.xplay, m_startScene->gm.yplay);
+	}
 }
 
 GPG_Canvas::~GPG_Canvas()
@@ -176,6 +181,13 @@ void GPG_Canvas::GetDisplayDimensions(int &width, int &height)
 	unsigned int uiheight;
 
 	GHOST_ISystem *system = GHOST_ISystem::getSystem();
+	if (!system) {
+		// Without display the canvas size is used.
+		width = GetWidth();
+		height = GetHeight();
+		return;
+	}
+
 	system->getMainDisplayDimensions(uiwidth, uiheight);
 
 	width = uiwidth;
@@ -184,6 +196,11 @@ void GPG_Canvas::GetDisplayDimensions(int &width, int &height)
 
 void GPG_Canvas::ResizeWindow(int width, int height)
 {
+	if (!m_window) {
+		Resize(width, height);
+		return;
+	}
+
 	if (m_window->getState() == GHOST_kWindowStateFullScreen) {
 		GHOST_ISystem *system = GHOST_ISystem::getSystem();
 		GHOST_DisplaySetting setting;
@@ -203,6 +220,10 @@ void GPG_Canvas::ResizeWindow(int width, int height)
 
 void GPG_Canvas::SetFullScreen(bool enable)
 {
+	if (!m_window) {
+		return;
+	}
+
 	if (enable) {
 		m_window->setState(GHOST_kWindowStateFullScreen);
 	}
@@ -213,12 +234,18 @@ void GPG_Canvas::SetFullScreen(bool enable)
 
 bool GPG_Canvas::GetFullScreen()
 {
-	return (m_window->getState() == GHOST_kWindowStateFullScreen);
+	return (m_window && m_window->getState() == GHOST_kWindowStateFullScreen);
 }
 
 void GPG_Canvas::ConvertMousePosition(int x, int y, int &r_x, int &r_y, bool UNUSED(screen))
 {
-	m_window->screenToClient(x, y, r_x, r_y);
+	if (m_window) {
+		m_window->screenToClient(x, y, r_x, r_y);
+	}
+	else {
+		r_x = x;
+		r_y = y;
+	}
 }
 
 ARegion *GPG_Canvas::GetARegion()
@@ -484,10 +484,13 @@ static void usage(const std::string& program, bool isBlenderPlayer)
 	CM_Message(std::endl)
 	CM_Message("usage:   " << program << " [--options] " << example_filename << std::endl);
 	CM_Message("Available options are: [-w [w h l t]] [-f [fw fh fb ff]] " << consoleoption << "[-g gamengineoptions] "
-		<< "[-s stereomode] [-m aasamples]");
+		<< "[-s stereomode] [-m aasamples] [-b frames [file]] [-headless] "
+		<< "[-record file] [-replay file]");
 	CM_Message("Optional parameters must be passed in order.");
 	CM_Message("Default values are set in the blend file." << std::endl);
 	CM_Message("  -h: Prints this command summary" << std::endl);
+	CM_Message("  -headless: run only the logic and physics without window nor GPU (dedicated server)");
+	CM_Message("       Note: all the other display options are ignored." << std::endl);
 	CM_Message("  -w: display in a window");
 	CM_Message("       --Optional parameters--");
 	CM_Message("       w = window width");
@@ -538,12 +541,20 @@ static void usage(const std::string& program, bool isBlenderPlayer)
 	CM_Message("       show_shadow_frustum            0         Show debug light shadow frustum volume");
 	CM_Message("       ignore_deprecation_warnings    1         Ignore deprecation warnings" << std::endl);
 	CM_Message("  -p: override python main loop script");
+	CM_Message("  -b: run a benchmark and quit");
+	CM_Message("       frames = number of frames to run with a fixed time step");
+	CM_Message("       file   = JSON statistics output file (default: standard output)");
+	CM_Message("       Example: -b 1000  or  -b 1000 stats.json" << std::endl);
+	CM_Message("  -record: record the keyboard, mouse and joystick inputs of every logic frame in a file" << std::endl);
+	CM_Message("  -replay: replay the inputs recorded in a file instead of the user inputs, quit at the end" << std::endl);
 	CM_Message(std::endl);
 	CM_Message("  - : all arguments after this are ignored, allowing python to access them from sys.argv");
 	CM_Message(std::endl);
 	CM_Message("example: " << program << " -w 320 200 10 10 -g noaudio " << example_pathname << example_filename);
 	CM_Message("example: " << program << " -g show_framerate = 0 " << example_pathname << example_filename);
 	CM_Message("example: " << program << " -i 232421 -m 16 " << example_pathname << example_filename);
+	CM_Message("example: " << program << " -headless -b 1000 stats.json " << example_pathname << example_filename);
+	CM_Message("example: " << program << " -headless -replay inputs.log -b 1000 " << example_pathname << example_filename);
 }
 
 static void get_filename(int argc, char **argv, char *filename)
@@ -702,6 +713,7 @@ int main(
 	bool fullScreen = false;
 	bool fullScreenParFound = false;
 	bool windowParFound = false;
+	bool headless = false;
 #ifdef WIN32
 	bool closeConsole = true;
 #endif
@@ -1078,8 +1090,14 @@ int main(
 				}
 				break;
 			}
-			case 'h': //display help
+			case 'h':
 			{
+				if (strcmp(argv[i], "-headless") == 0) { //run without window nor GPU
+					headless = true;
+					i++;
+					break;
+				}
+				//display help
 				usage(argv[0], isBlenderPlayer);
 				return 0;
 				break;
@@ -1198,6 +1216,40 @@ int main(
 				pythonControllerFile = argv[i++];
 				break;
 			}
+			case 'r':
+			{
+				const bool record = (strcmp(argv[i], "-record") == 0);
+				if (!record && strcmp(argv[i], "-replay") != 0) {
+					CM_Warning("unknown argument: " << argv[i++]);
+					break;
+				}
+
+				++i;
+				if ((i + 1) <= validArguments) {
+					SYS_WriteCommandLineString(syshandle, record ? "input_record" : "input_replay", argv[i++]);
+				}
+				else {
+					error = true;
+					CM_Error("no argument supplied for " << (record ? "-record" : "-replay"));
+				}
+				break;
+			}
+			case 'b': //benchmark
+			{
+				++i;
+				if ((i + 1) <= validArguments) {
+					SYS_WriteCommandLineInt(syshandle, "benchmark_frames", atoi(argv[i++]));
+					// Optional output file.
+					if ((i + 1) <= validArguments && argv[i][0] != '-') {
+						SYS_WriteCommandLineString(syshandle, "benchmark_output", argv[i++]);
+					}
+				}
+				else {
+					error = true;
+					CM_Error("no argument supplied for -b");
+				}
+				break;
+			}
 			default:  //not recognized
 			{
 				CM_Warning("unknown argument: " << argv[i++]);
@@ -1222,23 +1274,32 @@ int main(
 		usage(argv[0], isBlenderPlayer);
 		return 0;
 	}
+
+	if (headless) {
+		// Let the launcher know it must not render and a server doesn't play any sound.
+		SYS_WriteCommandLineInt(syshandle, "headless", 1);
+		BKE_sound_force_device("Null");
+	}
+
 	GHOST_ISystem *system = nullptr;
 #ifdef WIN32
 	if (scr_saver_mode != SCREEN_SAVER_MODE_CONFIGURATION)
 #endif
 	{
-		// Create the system
-		if (GHOST_ISystem::createSystem() == GHOST_kSuccess) {
-			system = GHOST_ISystem::getSystem();
-			BLI_assert(system);
-			
-			if (!fullScreenWidth || !fullScreenHeight)
-				system->getMainDisplayDimensions(fullScreenWidth, fullScreenHeight);
-			// process first batch of events. If the user
-			// drops a file on top off the blenderplayer icon, we
-			// receive an event with the filename
-			
-			system->processEvents(0);
+		// Create the system, a headless player doesn't use any display.
+		if (headless || GHOST_ISystem::createSystem() == GHOST_kSuccess) {
+			if (!headless) {
+				system = GHOST_ISystem::getSystem();
+				BLI_assert(system);
+
+				if (!fullScreenWidth || !fullScreenHeight)
+					system->getMainDisplayDimensions(fullScreenWidth, fullScreenHeight);
+				// process first batch of events. If the user
+				// drops a file on top off the blenderplayer icon, we
+				// receive an event with the filename
+
+				system->processEvents(0);
+			}
 			
 			// this bracket is needed for app (see below) to get out
 			// of scope before GHOST_ISystem::disposeSystem() is called.
@@ -1320,7 +1381,7 @@ int main(
 						/* Setting options according to the blend file if not overriden in the command line */
 #ifdef WIN32
 #if !defined(DEBUG)
-						if (closeConsole) {
+						if (closeConsole && system) {
 							system->toggleConsole(0); // Close a console window
 						}
 #endif // !defined(DEBUG)
@@ -1415,7 +1476,10 @@ int main(
 						if (firstTimeRunning) {
 							firstTimeRunning = false;
 
-							if (fullScreen) {
+							if (headless) {
+								CM_Message("running headless, only logic and physics are processed");
+							}
+							else if (fullScreen) {
 #ifdef WIN32
 								if (scr_saver_mode == SCREEN_SAVER_MODE_SAVER)
 								{
@@ -1484,8 +1548,10 @@ int main(
 							/* wm context */
 							wmWindowManager * wm = (wmWindowManager *)CTX_data_main(C)->wm.first;
 							CTX_wm_manager_set(C, wm);
-							WM_init_opengl_blenderplayer(G_MAIN, system);
-							wm_window_ghostwindow_blenderplayer_ensure(wm, (wmWindow *)wm->windows.first, window);
+							if (!headless) {
+								WM_init_opengl_blenderplayer(G_MAIN, system);
+								wm_window_ghostwindow_blenderplayer_ensure(wm, (wmWindow *)wm->windows.first, window);
+							}
 						}
 
 						// This argc cant be argc_py_clamped, since python uses it.
@@ -1497,7 +1563,9 @@ int main(
 						}
 						launcher.SetPythonGlobalDict(globalDict);
 #endif  // WITH_PYTHON
-						DRW_engines_register();
+						if (!headless) {
+							DRW_engines_register();
+						}
 
 						launcher.InitEngine();
 
@@ -1522,7 +1590,9 @@ int main(
 						}
 						launcher.ExitEngine();
 
-						DRW_engines_free();
+						if (!headless) {
+							DRW_engines_free();
+						}
 					}
 				} while (!quitGame(exitcode));
 			}
@@ -1564,7 +1634,9 @@ int main(
   BKE_vfont_clipboard_free();
   BKE_node_clipboard_free();
 
-  GPU_free_unused_buffers(G_MAIN);
+  if (!headless) {
+    GPU_free_unused_buffers(G_MAIN);
+  }
   
 
   BKE_blender_free(); /* blender.c, does entire library and spacetypes */
@@ -1586,18 +1658,22 @@ int main(
 
   BLF_exit();
 
-  DRW_opengl_context_enable_ex(false);
-  GPU_pass_cache_free();
-  GPU_exit();
-  DRW_opengl_context_disable_ex(false);
-  DRW_opengl_context_destroy();
+  if (!headless) {
+    DRW_opengl_context_enable_ex(false);
+    GPU_pass_cache_free();
+    GPU_exit();
+    DRW_opengl_context_disable_ex(false);
+    DRW_opengl_context_destroy();
+  }
 
   if (window) {
     system->disposeWindow(window);
   }
 
   // Dispose the system
-  GHOST_ISystem::disposeSystem();
+  if (system) {
+    GHOST_ISystem::disposeSystem();
+  }
 
 #ifdef WITH_PYTHON
   BPY_python_end();
@@ -0,0 +1,262 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_ActionCache.cpp
+ *  \ingroup ketsji
+ */
+
+#include "BL_ActionCache.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BKE_action.h"
+#include "BKE_fcurve.h"
+#include "BLI_listbase.h"
+#include "BLI_string.h"
+#include "BLI_utildefines.h"
+#include "DNA_action_types.h"
+#include "DNA_anim_types.h"
+#include "DNA_armature_types.h"
+#include "DNA_object_types.h"
+}
+
+/// Transform property of a pose channel animated by an action.
+struct BL_ChannelProperty
+{
+	const char *name;
+	unsigned int offset;
+	unsigned int size;
+};
+
+static const BL_ChannelProperty channelProperties[] = {
+	{"location", offsetof(bPoseChannel, loc), 3},
+	{"rotation_quaternion", offsetof(bPoseChannel, quat), 4},
+	{"rotation_euler", offsetof(bPoseChannel, eul), 3},
+	{"scale", offsetof(bPoseChannel, size), 3},
+	{nullptr, 0, 0}
+};
+
+BL_ActionCache::BL_ActionCache()
+	:m_bake(false)
+{
+}
+
+BL_ActionCache::~BL_ActionCache()
+{
+}
+
+void BL_ActionCache::SetBake(bool bake)
+{
+	m_bake = bake;
+}
+
+BL_ActionCache::Layout& BL_ActionCache::GetLayout(bAction *action, Object *armob)
+{
+	const LayoutKey key(action, (bArmature *)armob->data);
+	std::map<LayoutKey, Layout>::iterator it = m_layouts.find(key);
+	if (it != m_layouts.end()) {
+		return it->second;
+	}
+
+	Layout& layout = m_layouts[key];
+	layout.valid = true;
+	layout.channelCount = BLI_listbase_count(&armob->pose->chanbase);
+	layout.bakeStart = 0.0f;
+	layout.bakeEnd = 0.0f;
+
+	for (FCurve *fcu = (FCurve *)action->curves.first; fcu; fcu = fcu->next) {
+		// Same skipped curves as the animation system.
+		if ((fcu->grp && (fcu->grp->flag & AGRP_MUTED)) || (fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) ||
+			BKE_fcurve_is_empty(fcu))
+		{
+			continue;
+		}
+
+		/* Only the transform of the pose channels is cached: "pose.bones["name"].property".
+		 * The property name doesn't contain dots unlike the bone name. */
+		const bool isChannel = fcu->rna_path && STRPREFIX(fcu->rna_path, "pose.bones[");
+		const char *prop = isChannel ? strrchr(fcu->rna_path, '.') : nullptr;
+		char *name = isChannel ? BLI_str_quoted_substrN(fcu->rna_path, "pose.bones[") : nullptr;
+		if (fcu->driver || !prop || !name || prop[-1] != ']') {
+			if (name) {
+				MEM_freeN(name);
+			}
+			layout.valid = false;
+			break;
+		}
+		++prop;
+
+		bPoseChannel *pchan = BKE_pose_channel_find_name(armob->pose, name);
+		MEM_freeN(name);
+		// The animation system skips the unresolved paths.
+		if (!pchan) {
+			continue;
+		}
+
+		Target target;
+		target.channel = BLI_findindex(&armob->pose->chanbase, pchan);
+		target.fcurve = fcu;
+
+		if (STREQ(prop, "rotation_axis_angle")) {
+			if (fcu->array_index < 0 || fcu->array_index > 3) {
+				continue;
+			}
+			target.offset = (fcu->array_index == 0) ? offsetof(bPoseChannel, rotAngle) :
+			                offsetof(bPoseChannel, rotAxis) + (fcu->array_index - 1) * sizeof(float);
+			layout.targets.push_back(target);
+			continue;
+		}
+
+		const BL_ChannelProperty *property = channelProperties;
+		while (property->name && !STREQ(prop, property->name)) {
+			++property;
+		}
+
+		if (!property->name) {
+			layout.valid = false;
+			break;
+		}
+		if (fcu->array_index < 0 || fcu->array_index >= (int)property->size) {
+			continue;
+		}
+
+		target.offset = property->offset + fcu->array_index * sizeof(float);
+		layout.targets.push_back(target);
+	}
+
+	if (!layout.valid) {
+		layout.targets.clear();
+	}
+	else if (m_bake) {
+		BakeLayout(layout, action);
+	}
+
+	return layout;
+}
+
+void BL_ActionCache::BakeLayout(Layout& layout, bAction *action)
+{
+	if (!layout.baked.empty() || layout.targets.empty()) {
+		return;
+	}
+
+	float start, end;
+	calc_action_range(action, &start, &end, 0);
+	layout.bakeStart = floorf(start);
+	layout.bakeEnd = ceilf(end);
+
+	const unsigned int size = layout.targets.size();
+	const unsigned int frames = (unsigned int)(layout.bakeEnd - layout.bakeStart) + 1;
+	layout.baked.resize(frames * size);
+	for (unsigned int i = 0; i < frames; ++i) {
+		Sample(layout, layout.bakeStart + (float)i, &layout.baked[i * size]);
+	}
+}
+
+void BL_ActionCache::Sample(const Layout& layout, float frame, float *values) const
+{
+	for (unsigned int i = 0, size = layout.targets.size(); i < size; ++i) {
+		values[i] = evaluate_fcurve(layout.targets[i].fcurve, frame);
+	}
+}
+
+void BL_ActionCache::Bake(bAction *action, Object *armob)
+{
+	if (!m_bake || !action || !armob || armob->type != OB_ARMATURE || !armob->pose) {
+		return;
+	}
+
+	Layout& layout = GetLayout(action, armob);
+	if (layout.valid) {
+		BakeLayout(layout, action);
+	}
+}
+
+bool BL_ActionCache::SetPose(Object *armob, bAction *action, float frame)
+{
+	if (!action || !armob->pose) {
+		return false;
+	}
+
+	const Layout& layout = GetLayout(action, armob);
+	if (!layout.valid) {
+		return false;
+	}
+
+	m_channels.clear();
+	for (bPoseChannel *pchan = (bPoseChannel *)armob->pose->chanbase.first; pchan; pchan = pchan->next) {
+		m_channels.push_back(pchan);
+	}
+
+	// The pose channels of the armature were changed since the action was first played.
+	if (m_channels.size() != layout.channelCount) {
+		return false;
+	}
+
+	const unsigned int size = layout.targets.size();
+	if (!layout.baked.empty() && frame >= layout.bakeStart && frame <= layout.bakeEnd) {
+		// Interpolate the two samples around the frame.
+		const float position = frame - layout.bakeStart;
+		const unsigned int index = std::min((unsigned int)position, (unsigned int)(layout.bakeEnd - layout.bakeStart));
+		const unsigned int next = std::min(index + 1, (unsigned int)(layout.bakeEnd - layout.bakeStart));
+		const float factor = position - (float)index;
+		const float *values = &layout.baked[index * size];
+		const float *nextValues = &layout.baked[next * size];
+
+		for (unsigned int i = 0; i < size; ++i) {
+			const Target& target = layout.targets[i];
+			float *value = (float *)((char *)m_channels[target.channel] + target.offset);
+			*value = values[i] + (nextValues[i] - values[i]) * factor;
+		}
+		return true;
+	}
+
+	std::vector<float>& values = m_samples[SampleKey(action, (bArmature *)armob->data, frame)];
+	if (values.size() != size) {
+		values.resize(size);
+		Sample(layout, frame, values.data());
+	}
+
+	for (unsigned int i = 0; i < size; ++i) {
+		const Target& target = layout.targets[i];
+		*(float *)((char *)m_channels[target.channel] + target.offset) = values[i];
+	}
+
+	return true;
+}
+
+void BL_ActionCache::ClearSamples()
+{
+	m_samples.clear();
+}
+
+void BL_ActionCache::Clear()
+{
+	m_samples.clear();
+	m_layouts.clear();
+}
@@ -0,0 +1,105 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_ActionCache.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __BL_ACTIONCACHE_H__
+#define __BL_ACTIONCACHE_H__
+
+#include <map>
+#include <vector>
+#include <tuple>
+
+struct bAction;
+struct bArmature;
+struct bPoseChannel;
+struct FCurve;
+struct Object;
+
+/** Cache of the armature poses sampled from actions. The F-Curves of an action are evaluated
+ * once per frame for all the armatures sharing the same armature data and playing the action
+ * at the same frame. When baking is enabled, the actions are sampled at each frame of their
+ * range once and the poses are interpolated between the samples.
+ */
+class BL_ActionCache
+{
+private:
+	/// A float of a pose channel animated by an F-Curve.
+	struct Target
+	{
+		unsigned int channel;
+		/// Offset of the float in the pose channel.
+		unsigned int offset;
+		FCurve *fcurve;
+	};
+
+	/// Targets of an action on an armature.
+	struct Layout
+	{
+		/// False if the action animates other properties than the transform of the pose channels.
+		bool valid;
+		unsigned int channelCount;
+		std::vector<Target> targets;
+
+		/// Samples of the targets at each frame from bakeStart to bakeEnd, empty if not baked.
+		float bakeStart;
+		float bakeEnd;
+		std::vector<float> baked;
+	};
+
+	typedef std::pair<bAction *, bArmature *> LayoutKey;
+	typedef std::tuple<bAction *, bArmature *, float> SampleKey;
+
+	std::map<LayoutKey, Layout> m_layouts;
+	/// Samples of the targets for the current frame.
+	std::map<SampleKey, std::vector<float> > m_samples;
+	/// Pose channels of the armature being posed.
+	std::vector<bPoseChannel *> m_channels;
+	bool m_bake;
+
+	Layout& GetLayout(bAction *action, Object *armob);
+	void BakeLayout(Layout& layout, bAction *action);
+	void Sample(const Layout& layout, float frame, float *values) const;
+
+public:
+	BL_ActionCache();
+	~BL_ActionCache();
+
+	/// Enable the baking of the actions.
+	void SetBake(bool bake);
+	/// Bake an action for an armature if baking is enabled.
+	void Bake(bAction *action, Object *armob);
+
+	/** Set the pose of an armature to the action at a frame.
+	 * \return False if the action can't be sampled by the cache, the caller must evaluate the action.
+	 */
+	bool SetPose(Object *armob, bAction *action, float frame);
+
+	/// Free the samples of the frame, called once per logic frame.
+	void ClearSamples();
+	/// Free all the data, the actions could be freed.
+	void Clear();
+};
+
+#endif  // __BL_ACTIONCACHE_H__
@@ -0,0 +1,415 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_SkinDeformer.cpp
+ *  \ingroup ketsji
+ */
+
+#include "BL_SkinDeformer.h"
+#include "BL_ArmatureObject.h"
+#include "KX_GameObject.h"
+
+#include <map>
+#include <tuple>
+#include <algorithm>
+#include <cfloat>
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BKE_action.h"
+#include "BKE_customdata.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+#include "BLI_listbase.h"
+#include "BLI_math.h"
+#include "BLI_task.h"
+#include "DNA_armature_types.h"
+#include "DNA_action_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_modifier_types.h"
+#include "DNA_object_types.h"
+#include "depsgraph/DEG_depsgraph.h"
+#include "depsgraph/DEG_depsgraph_query.h"
+#include "eevee_private.h"
+}
+
+/// Number of vertices skinned by a task.
+#define BL_SKIN_TASK_VERTICES 4096
+
+BL_SkinData::BL_SkinData(Object *object, ArmatureModifierData *modifier, Object *armature)
+	:m_object(object),
+	m_modifier(modifier)
+{
+	Mesh *me = (Mesh *)object->data;
+	bPose *pose = armature->pose;
+
+	m_vertexCount = me->totvert;
+	m_channelCount = BLI_listbase_count(&pose->chanbase);
+
+	// Pose channel index of each vertex group, -1 for the groups not deforming.
+	std::vector<int> groupChannels;
+	for (bDeformGroup *group = (bDeformGroup *)object->defbase.first; group; group = group->next) {
+		bPoseChannel *pchan = BKE_pose_channel_find_name(pose, group->name);
+		if (pchan && pchan->bone && !(pchan->bone->flag & BONE_NO_DEFORM)) {
+			groupChannels.push_back(BLI_findindex(&pose->chanbase, pchan));
+		}
+		else {
+			groupChannels.push_back(-1);
+		}
+	}
+
+	m_channels.resize(m_vertexCount * BL_SKIN_MAX_INFLUENCES, 0);
+	m_weights.resize(m_vertexCount * BL_SKIN_MAX_INFLUENCES, 0.0f);
+	m_positions.resize(m_vertexCount * 3);
+	m_normals.resize(m_vertexCount * 3);
+
+	for (unsigned int i = 0; i < m_vertexCount; ++i) {
+		unsigned short *channels = &m_channels[i * BL_SKIN_MAX_INFLUENCES];
+		float *weights = &m_weights[i * BL_SKIN_MAX_INFLUENCES];
+
+		// Keep the largest influences sorted by decreasing weight.
+		const MDeformVert& dvert = me->dvert[i];
+		for (unsigned int j = 0; j < dvert.totweight; ++j) {
+			const MDeformWeight& dw = dvert.dw[j];
+			if ((unsigned int)dw.def_nr >= groupChannels.size() || groupChannels[dw.def_nr] == -1 || dw.weight <= 0.0f) {
+				continue;
+			}
+
+			int k = BL_SKIN_MAX_INFLUENCES - 1;
+			if (dw.weight <= weights[k]) {
+				continue;
+			}
+			for (; k > 0 && weights[k - 1] < dw.weight; --k) {
+				weights[k] = weights[k - 1];
+				channels[k] = channels[k - 1];
+			}
+			weights[k] = dw.weight;
+			channels[k] = groupChannels[dw.def_nr];
+		}
+
+		float sum = 0.0f;
+		for (unsigned int k = 0; k < BL_SKIN_MAX_INFLUENCES; ++k) {
+			sum += weights[k];
+		}
+
+		if (sum > 0.0f) {
+			for (unsigned int k = 0; k < BL_SKIN_MAX_INFLUENCES; ++k) {
+				weights[k] /= sum;
+			}
+		}
+		else {
+			// Like the armature modifier, the vertices without influence are not moved.
+			channels[0] = m_channelCount;
+			weights[0] = 1.0f;
+		}
+
+		const MVert& mvert = me->mvert[i];
+		copy_v3_v3(&m_positions[i * 3], mvert.co);
+		normal_short_to_float_v3(&m_normals[i * 3], mvert.no);
+	}
+
+	// The game engine replaces the modifier.
+	m_modifier->modifier.mode &= ~eModifierMode_Realtime;
+	DEG_id_tag_update(&m_object->id, ID_RECALC_GEOMETRY);
+}
+
+BL_SkinData::~BL_SkinData()
+{
+	m_modifier->modifier.mode |= eModifierMode_Realtime;
+	DEG_id_tag_update(&m_object->id, ID_RECALC_GEOMETRY);
+}
+
+BL_SkinDeformer::BL_SkinDeformer(KX_GameObject *gameobj, BL_SkinData *data)
+	:m_gameobj(gameobj),
+	m_data(data),
+	m_version(0),
+	m_skinnedArmature(nullptr),
+	m_skinnedPoseVersion(0),
+	m_source(nullptr),
+	m_appliedSource(nullptr),
+	m_appliedVersion(0),
+	m_appliedMesh(nullptr),
+	m_appliedVerts(nullptr)
+{
+	unit_m4(m_skinnedPostmat);
+}
+
+BL_SkinDeformer::BL_SkinDeformer(const BL_SkinDeformer& other)
+	:m_gameobj(other.m_gameobj),
+	m_data(other.m_data->AddRef()),
+	m_version(0),
+	m_skinnedArmature(nullptr),
+	m_skinnedPoseVersion(0),
+	m_source(nullptr),
+	m_appliedSource(nullptr),
+	m_appliedVersion(0),
+	m_appliedMesh(nullptr),
+	m_appliedVerts(nullptr)
+{
+	unit_m4(m_skinnedPostmat);
+}
+
+BL_SkinDeformer::~BL_SkinDeformer()
+{
+	m_data->Release();
+}
+
+BL_SkinDeformer *BL_SkinDeformer::New(KX_GameObject *gameobj, BL_ArmatureObject *armature)
+{
+	Object *ob = gameobj->GetBlenderObject();
+	if (!ob || ob->type != OB_MESH) {
+		return nullptr;
+	}
+
+	Mesh *me = (Mesh *)ob->data;
+	if (me->totvert == 0 || !me->dvert || me->key) {
+		return nullptr;
+	}
+
+	// The armature modifier must be the only modifier to deform the evaluated mesh.
+	ArmatureModifierData *amd = nullptr;
+	for (ModifierData *md = (ModifierData *)ob->modifiers.first; md; md = md->next) {
+		if (!(md->mode & eModifierMode_Realtime)) {
+			continue;
+		}
+		if (md->type != eModifierType_Armature || amd) {
+			return nullptr;
+		}
+		amd = (ArmatureModifierData *)md;
+	}
+
+	Object *armob = armature->GetArmatureObject();
+	if (!amd || amd->object != armob || amd->deformflag != ARM_DEF_VGROUP || amd->multi || amd->defgrp_name[0] != '\0' ||
+		!armob->pose)
+	{
+		return nullptr;
+	}
+
+	// B-Bones deform with their segments.
+	for (bPoseChannel *pchan = (bPoseChannel *)armob->pose->chanbase.first; pchan; pchan = pchan->next) {
+		if (pchan->bone && !(pchan->bone->flag & BONE_NO_DEFORM) && pchan->bone->segments > 1) {
+			return nullptr;
+		}
+	}
+
+	return new BL_SkinDeformer(gameobj, new BL_SkinData(ob, amd, armob));
+}
+
+BL_SkinDeformer *BL_SkinDeformer::GetReplica(KX_GameObject *gameobj) const
+{
+	BL_SkinDeformer *replica = new BL_SkinDeformer(*this);
+	replica->m_gameobj = gameobj;
+	return replica;
+}
+
+void BL_SkinDeformer::Skin(unsigned int start, unsigned int end)
+{
+	const unsigned short *channels = m_data->m_channels.data();
+	const float *weights = m_data->m_weights.data();
+	const float *restPositions = m_data->m_positions.data();
+	const float *restNormals = m_data->m_normals.data();
+	const float (*matrices)[4][4] = (const float (*)[4][4])m_matrices.data();
+	float *positions = m_positions.data();
+	float *normals = m_normals.data();
+
+	for (unsigned int i = start; i < end; ++i) {
+		// Blend the 3x4 affine part of the influence matrices.
+		float mat[4][3] = {{0.0f}};
+		for (unsigned int k = 0; k < BL_SKIN_MAX_INFLUENCES; ++k) {
+			const float weight = weights[i * BL_SKIN_MAX_INFLUENCES + k];
+			// The influences are sorted by decreasing weight.
+			if (weight == 0.0f) {
+				break;
+			}
+			const float (*bmat)[4] = matrices[channels[i * BL_SKIN_MAX_INFLUENCES + k]];
+			for (unsigned int col = 0; col < 4; ++col) {
+				madd_v3_v3fl(mat[col], bmat[col], weight);
+			}
+		}
+
+		const float *co = &restPositions[i * 3];
+		const float *no = &restNormals[i * 3];
+		float *dco = &positions[i * 3];
+		float *dno = &normals[i * 3];
+		for (unsigned int row = 0; row < 3; ++row) {
+			dco[row] = mat[0][row] * co[0] + mat[1][row] * co[1] + mat[2][row] * co[2] + mat[3][row];
+			dno[row] = mat[0][row] * no[0] + mat[1][row] * no[1] + mat[2][row] * no[2];
+		}
+		normalize_v3(dno);
+	}
+}
+
+void BL_SkinDeformer::Apply(Depsgraph *depsgraph)
+{
+	Object *ob_eval = DEG_get_evaluated_object(depsgraph, m_gameobj->GetBlenderObject());
+	Mesh *me = ob_eval->runtime.mesh_eval;
+	if (!me || me->totvert != m_data->m_vertexCount) {
+		return;
+	}
+
+	/* The depsgraph evaluates again the mesh when the armature is updated,
+	 * the vertices are then written again even if they didn't change. */
+	if (m_source == m_appliedSource && m_source->m_version == m_appliedVersion &&
+		me == m_appliedMesh && me->mvert == m_appliedVerts)
+	{
+		return;
+	}
+
+	// The evaluated mesh without modifiers references the vertices of the original mesh.
+	CustomData_duplicate_referenced_layer(&me->vdata, CD_MVERT, me->totvert);
+	BKE_mesh_update_customdata_pointers(me, false);
+
+	const float *positions = m_source->m_positions.data();
+	const float *normals = m_source->m_normals.data();
+	MVert *mvert = me->mvert;
+	for (unsigned int i = 0; i < m_data->m_vertexCount; ++i) {
+		copy_v3_v3(mvert[i].co, &positions[i * 3]);
+		normal_float_to_short_v3(mvert[i].no, &normals[i * 3]);
+	}
+
+	BKE_mesh_batch_cache_dirty_tag(me, BKE_MESH_BATCH_DIRTY_ALL);
+	BKE_object_boundbox_flag(ob_eval, BOUNDBOX_DIRTY, true);
+	EEVEE_ObjectEngineData *oedata = EEVEE_object_data_ensure(ob_eval);
+	oedata->need_update = true;
+
+	m_appliedSource = m_source;
+	m_appliedVersion = m_source->m_version;
+	m_appliedMesh = me;
+	m_appliedVerts = me->mvert;
+}
+
+struct BL_SkinTask
+{
+	BL_SkinDeformer *deformer;
+	unsigned int start;
+	unsigned int end;
+};
+
+void BL_SkinDeformer::SkinTask(void *__restrict userdata, const int iter, const TaskParallelTLS *__restrict UNUSED(tls))
+{
+	const BL_SkinTask& task = static_cast<BL_SkinTask *>(userdata)[iter];
+	task.deformer->Skin(task.start, task.end);
+}
+
+void BL_SkinDeformer::UpdateDeformers(const std::vector<BL_SkinDeformer *>& deformers, Depsgraph *depsgraph)
+{
+	if (deformers.empty()) {
+		return;
+	}
+
+	// Deformers computing the pose of an action frame, by skinning data, armature, action and frame.
+	typedef std::tuple<BL_SkinData *, Object *, bAction *, float> ActionKey;
+	std::map<ActionKey, std::vector<BL_SkinDeformer *> > actionDeformers;
+	std::vector<BL_SkinTask> tasks;
+
+	for (BL_SkinDeformer *deformer : deformers) {
+		deformer->m_source = nullptr;
+
+		KX_GameObject *parent = deformer->m_gameobj->GetParent();
+		if (!parent || parent->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE) {
+			continue;
+		}
+
+		BL_ArmatureObject *armature = static_cast<BL_ArmatureObject *>(parent);
+
+		// Armature to mesh space.
+		float obmat[4][4];
+		float armmat[4][4];
+		float postmat[4][4];
+		deformer->m_gameobj->NodeGetWorldTransform().getValue(&obmat[0][0]);
+		armature->NodeGetWorldTransform().getValue(&armmat[0][0]);
+		invert_m4(obmat);
+		mul_m4_m4m4(postmat, obmat, armmat);
+
+		// Share the vertices of a deformer with the same mesh and pose.
+		bAction *action;
+		float frame;
+		std::vector<BL_SkinDeformer *> *sources = nullptr;
+		if (armature->GetPoseAction(&action, &frame)) {
+			sources = &actionDeformers[ActionKey(deformer->m_data, armature->GetOrigArmatureObject(), action, frame)];
+			for (BL_SkinDeformer *source : *sources) {
+				if (compare_m4m4(source->m_skinnedPostmat, postmat, FLT_EPSILON)) {
+					deformer->m_source = source;
+					break;
+				}
+			}
+			if (deformer->m_source) {
+				continue;
+			}
+		}
+
+		const std::vector<BL_ArmatureObject::SkinMatrix>& skinMatrices = armature->GetSkinMatrices();
+		if (skinMatrices.size() != deformer->m_data->m_channelCount) {
+			continue;
+		}
+
+		deformer->m_source = deformer;
+		if (sources) {
+			sources->push_back(deformer);
+		}
+
+		const unsigned int poseVersion = armature->GetPoseVersion();
+		if (deformer->m_skinnedArmature == armature && deformer->m_skinnedPoseVersion == poseVersion &&
+			compare_m4m4(deformer->m_skinnedPostmat, postmat, FLT_EPSILON))
+		{
+			continue;
+		}
+
+		const unsigned int channelCount = deformer->m_data->m_channelCount;
+		deformer->m_matrices.resize((channelCount + 1) * 16);
+		float (*matrices)[4][4] = (float (*)[4][4])deformer->m_matrices.data();
+		float premat[4][4];
+		invert_m4_m4(premat, postmat);
+		for (unsigned int i = 0; i < channelCount; ++i) {
+			mul_m4_series(matrices[i], postmat, skinMatrices[i].mat, premat);
+		}
+		unit_m4(matrices[channelCount]);
+
+		const unsigned int vertexCount = deformer->m_data->m_vertexCount;
+		deformer->m_positions.resize(vertexCount * 3);
+		deformer->m_normals.resize(vertexCount * 3);
+		for (unsigned int start = 0; start < vertexCount; start += BL_SKIN_TASK_VERTICES) {
+			tasks.push_back({deformer, start, std::min(start + BL_SKIN_TASK_VERTICES, vertexCount)});
+		}
+
+		++deformer->m_version;
+		deformer->m_skinnedArmature = armature;
+		deformer->m_skinnedPoseVersion = poseVersion;
+		copy_m4_m4(deformer->m_skinnedPostmat, postmat);
+	}
+
+	if (!tasks.empty()) {
+		TaskParallelSettings settings;
+		BLI_parallel_range_settings_defaults(&settings);
+		settings.use_threading = (tasks.size() > 1);
+		BLI_task_parallel_range(0, tasks.size(), tasks.data(), SkinTask, &settings);
+	}
+
+	// The evaluated meshes are written on the main thread.
+	for (BL_SkinDeformer *deformer : deformers) {
+		if (deformer->m_source) {
+			deformer->Apply(depsgraph);
+		}
+	}
+}
@@ -0,0 +1,130 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_SkinDeformer.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __BL_SKINDEFORMER_H__
+#define __BL_SKINDEFORMER_H__
+
+#include "CM_RefCount.h"
+
+#include <vector>
+
+class KX_GameObject;
+class BL_ArmatureObject;
+struct ArmatureModifierData;
+struct Depsgraph;
+struct Mesh;
+struct MVert;
+struct Object;
+
+/// Maximum number of bones deforming a vertex.
+#define BL_SKIN_MAX_INFLUENCES 4
+
+/** Skinning data of a mesh object deformed by an armature, shared between all the
+ * replicas of the object. The armature modifier of the object is disabled while the
+ * data exists, the game engine deforms the evaluated mesh instead.
+ */
+class BL_SkinData : public CM_RefCount<BL_SkinData>
+{
+public:
+	/// The original object.
+	Object *m_object;
+	/// The disabled armature modifier.
+	ArmatureModifierData *m_modifier;
+
+	unsigned int m_vertexCount;
+	/// Number of pose channels, the matrix at this index is the identity for the unweighted vertices.
+	unsigned int m_channelCount;
+
+	/// Influences of the vertices: BL_SKIN_MAX_INFLUENCES pose channel indices and normalized weights per vertex.
+	std::vector<unsigned short> m_channels;
+	std::vector<float> m_weights;
+
+	/// Rest positions and normals of the vertices.
+	std::vector<float> m_positions;
+	std::vector<float> m_normals;
+
+	BL_SkinData(Object *object, ArmatureModifierData *modifier, Object *armature);
+	virtual ~BL_SkinData();
+};
+
+/** Deform a mesh object with the pose of its parent armature, all the visible deformers of a
+ * scene are updated together by UpdateDeformers.
+ */
+class BL_SkinDeformer
+{
+private:
+	KX_GameObject *m_gameobj;
+	BL_SkinData *m_data;
+
+	/// Deformed positions and normals, used only when the deformer computes its own pose.
+	std::vector<float> m_positions;
+	std::vector<float> m_normals;
+	/// Skinning matrices in mesh space, the last is the identity.
+	std::vector<float> m_matrices;
+
+	/// Incremented each time the deformed vertices are computed.
+	unsigned int m_version;
+	/// The armature, its pose version and the armature to mesh space matrix of the computed vertices.
+	BL_ArmatureObject *m_skinnedArmature;
+	unsigned int m_skinnedPoseVersion;
+	float m_skinnedPostmat[4][4];
+
+	/// The deformer computing the vertices of this deformer for the current frame.
+	BL_SkinDeformer *m_source;
+	/// The source deformer, its version and the mesh of the last vertices written to the evaluated mesh.
+	BL_SkinDeformer *m_appliedSource;
+	unsigned int m_appliedVersion;
+	Mesh *m_appliedMesh;
+	MVert *m_appliedVerts;
+
+	BL_SkinDeformer(KX_GameObject *gameobj, BL_SkinData *data);
+
+	/// Compute the deformed vertices from m_matrices.
+	void Skin(unsigned int start, unsigned int end);
+	/// Write the vertices of the source deformer to the evaluated mesh if they changed.
+	void Apply(Depsgraph *depsgraph);
+
+	static void SkinTask(void *__restrict userdata, const int iter, const struct TaskParallelTLS *__restrict tls);
+
+public:
+	BL_SkinDeformer(const BL_SkinDeformer& other);
+	~BL_SkinDeformer();
+
+	/** Create a deformer for a mesh object parented to an armature, return nullptr if
+	 * the deformation of the object is not supported.
+	 */
+	static BL_SkinDeformer *New(KX_GameObject *gameobj, BL_ArmatureObject *armature);
+
+	/// Return a copy of the deformer for a replica of the object.
+	BL_SkinDeformer *GetReplica(KX_GameObject *gameobj) const;
+
+	/** Deform the meshes of the deformers for the current frame. The deformers using the same
+	 * mesh and armature playing the same action frame share their result.
+	 */
+	static void UpdateDeformers(const std::vector<BL_SkinDeformer *>& deformers, Depsgraph *depsgraph);
+};
+
+#endif  // __BL_SKINDEFORMER_H__
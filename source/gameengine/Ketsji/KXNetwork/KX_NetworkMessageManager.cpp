@@ -49,35 +49,46 @@ void KX_NetworkMessageManager::AddMessage(KX_NetworkMessageManager::Message mess
 	m_messages[m_currentList][message.to][message.subject].push_back(message);
 }
 
-const std::vector<KX_NetworkMessageManager::Message> KX_NetworkMessageManager::GetMessages(std::string to, std::string subject)
+static void AppendMessages(const std::vector<KX_NetworkMessageManager::Message>& list,
+						   std::vector<const KX_NetworkMessageManager::Message *>& messages)
 {
-	std::vector<KX_NetworkMessageManager::Message> messages;
+	for (const KX_NetworkMessageManager::Message& message : list) {
+		messages.push_back(&message);
+	}
+}
+
+void KX_NetworkMessageManager::GetMessages(const std::string& to, const std::string& subject,
+										   std::vector<const Message *>& messages)
+{
+	messages.clear();
 
-	// look at messages without receiver.
-	std::map<std::string, std::vector<Message> >& messagesNoReceiver = m_messages[1 - m_currentList][""];
-	std::map<std::string, std::vector<Message> >& messagesReceiver = m_messages[1 - m_currentList][to];
-	if (subject.empty()) {
-		// Add all message without receiver and subject.
-		for (std::map<std::string, std::vector<Message> >::iterator it = messagesNoReceiver.begin(), end = messagesNoReceiver.end();
-			it != end; ++it)
-		{
-			messages.insert(messages.end(), it->second.begin(), it->second.end());
+	/* Only look up the lists, using operator[] would insert empty lists
+	 * for every receiver and subject checked by the sensors. */
+	const std::map<std::string, std::map<std::string, std::vector<Message> > >& lastMessages = m_messages[1 - m_currentList];
+	static const std::string noReceiver;
+	const std::string *receivers[2] = {&noReceiver, &to};
+	for (const std::string *receiver : receivers) {
+		std::map<std::string, std::map<std::string, std::vector<Message> > >::const_iterator receiverit = lastMessages.find(*receiver);
+		if (receiverit == lastMessages.end()) {
+			continue;
 		}
-		// Add all message with the given receiver and no subject.
-		for (std::map<std::string, std::vector<Message> >::iterator it = messagesReceiver.begin(), end = messagesReceiver.end();
-			 it != end; ++it)
-		{
-			messages.insert(messages.end(), it->second.begin(), it->second.end());
+
+		const std::map<std::string, std::vector<Message> >& subjects = receiverit->second;
+		if (subject.empty()) {
+			// Add all message without receiver or with the given receiver and any subject.
+			for (std::map<std::string, std::vector<Message> >::const_iterator it = subjects.begin(), end = subjects.end();
+				 it != end; ++it)
+			{
+				AppendMessages(it->second, messages);
+			}
+		}
+		else {
+			std::map<std::string, std::vector<Message> >::const_iterator subjectit = subjects.find(subject);
+			if (subjectit != subjects.end()) {
+				AppendMessages(subjectit->second, messages);
+			}
 		}
 	}
-	else {
-		std::vector<KX_NetworkMessageManager::Message>& messagesNoReceiverSubject = messagesNoReceiver[subject];
-		messages.insert(messages.end(), messagesNoReceiverSubject.begin(), messagesNoReceiverSubject.end());
-		std::vector<KX_NetworkMessageManager::Message>& messagesReceiverSubject = messagesReceiver[subject];
-		messages.insert(messages.end(), messagesReceiverSubject.begin(), messagesReceiverSubject.end());
-	}
-
-	return messages;
 }
 
 void KX_NetworkMessageManager::ClearMessages()
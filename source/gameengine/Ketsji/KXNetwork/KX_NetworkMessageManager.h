@@ -77,10 +77,12 @@ public:
 	 */
 	void AddMessage(Message message);
 	/** Get all messages for a given receiver object name and message subject.
+	 * The messages are not copied, they stay valid until the next call to ClearMessages().
 	 * \param to The object(s) name.
 	 * \param subject The message subject/filter.
+	 * \param messages The list filled with the messages, cleared first.
 	 */
-	const std::vector<Message> GetMessages(std::string to, std::string subject);
+	void GetMessages(const std::string& to, const std::string& subject, std::vector<const Message *>& messages);
 
 	/// Clear all messages
 	void ClearMessages();
@@ -66,8 +66,10 @@ public:
 	/** Get all messages for a given receiver object name and message subject.
 	 * \param to The object(s) name.
 	 * \param subject The message subject/filter.
+	 * \param messages The list filled with the messages, see KX_NetworkMessageManager::GetMessages.
 	 */
-	const std::vector<KX_NetworkMessageManager::Message> FindMessages(std::string to, std::string subject);
+	void FindMessages(const std::string& to, const std::string& subject,
+					  std::vector<const KX_NetworkMessageManager::Message *>& messages);
 };
 
 #endif // __KX_NETWORKMESSAGESCENE_H__
@@ -100,15 +100,12 @@ bool KX_NetworkMessageSensor::Evaluate()
 		m_SubjectList = nullptr;
 	}
 
-	std::string toname = GetParent()->GetName();
-	std::string& subject = this->m_subject;
+	const std::string toname = GetParent()->GetName();
+	m_NetworkScene->FindMessages(toname, m_subject, m_messages);
 
-	const std::vector<KX_NetworkMessageManager::Message> messages =
-	    m_NetworkScene->FindMessages(toname, subject);
+	m_frame_message_count = m_messages.size();
 
-	m_frame_message_count = messages.size();
-
-	if (!messages.empty()) {
+	if (!m_messages.empty()) {
 #ifdef NAN_NET_DEBUG
 		std::cout << "KX_NetworkMessageSensor found one or more messages" << std::endl;
 #endif
@@ -117,12 +114,11 @@ bool KX_NetworkMessageSensor::Evaluate()
 		m_SubjectList = new CListValue<CStringValue>();
 	}
 
-	std::vector<KX_NetworkMessageManager::Message>::const_iterator mesit;
-	for (mesit = messages.begin(); mesit != messages.end(); mesit++) {
+	for (const KX_NetworkMessageManager::Message *message : m_messages) {
 		// save the body
-		const std::string& body = (*mesit).body;
+		const std::string& body = message->body;
 		// save the subject
-		const std::string& messub = (*mesit).subject;
+		const std::string& messub = message->subject;
 #ifdef NAN_NET_DEBUG
 		if (body) {
 			cout << "body [" << body << "]\n";
@@ -33,6 +33,7 @@
 #define __KX_NETWORKMESSAGESENSOR_H__
 
 #include "SCA_ISensor.h"
+#include "KX_NetworkMessageManager.h"
 
 class KX_NetworkMessageScene;
 class CStringValue;
@@ -51,6 +52,9 @@ class KX_NetworkMessageSensor : public SCA_ISensor
 	// The number of messages caught since the last frame.
 	int m_frame_message_count;
 
+	// The messages found in the last frame, kept to reuse its memory.
+	std::vector<const KX_NetworkMessageManager::Message *> m_messages;
+
 	bool m_IsUp;
 
 	CListValue<CStringValue> *m_BodyList;
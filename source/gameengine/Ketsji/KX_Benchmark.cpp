@@ -0,0 +1,201 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_Benchmark.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_Benchmark.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_fileops.h"
+
+#include "CM_Message.h"
+
+#include <algorithm>
+#include <sstream>
+#include <cstdio>
+
+/// Escape a string for JSON.
+static std::string jsonString(const std::string& str)
+{
+	std::string result = "\"";
+	for (const char c : str) {
+		switch (c) {
+			case '"':
+			{
+				result += "\\\"";
+				break;
+			}
+			case '\\':
+			{
+				result += "\\\\";
+				break;
+			}
+			case '\n':
+			{
+				result += "\\n";
+				break;
+			}
+			default:
+			{
+				if ((unsigned char)c < 0x20) {
+					char code[7];
+					snprintf(code, sizeof(code), "\\u%04x", c);
+					result += code;
+				}
+				else {
+					result += c;
+				}
+			}
+		}
+	}
+	result += "\"";
+	return result;
+}
+
+/// Write the min, mean, percentiles and max of measurements in seconds as milliseconds.
+static void writeStatistics(std::ostream& stream, const std::vector<double>& values)
+{
+	if (values.empty()) {
+		stream << "{}";
+		return;
+	}
+
+	std::vector<double> sorted = values;
+	std::sort(sorted.begin(), sorted.end());
+
+	double sum = 0.0;
+	for (double value : sorted) {
+		sum += value;
+	}
+
+	const unsigned int size = sorted.size();
+	// Nearest-rank percentile.
+	const auto percentile = [&sorted, size](unsigned int p) {
+		const unsigned int rank = (p * size + 99) / 100;
+		return sorted[std::max(rank, 1u) - 1];
+	};
+
+	stream << "{\"min\": " << sorted.front() * 1000.0
+		   << ", \"mean\": " << sum / size * 1000.0
+		   << ", \"p50\": " << percentile(50) * 1000.0
+		   << ", \"p95\": " << percentile(95) * 1000.0
+		   << ", \"p99\": " << percentile(99) * 1000.0
+		   << ", \"max\": " << sorted.back() * 1000.0 << "}";
+}
+
+KX_Benchmark::KX_Benchmark(const std::vector<std::string>& categories)
+	:m_categories(categories),
+	m_times(categories.size()),
+	m_startMemory(0),
+	m_maxFrameMemory(0)
+{
+}
+
+KX_Benchmark::~KX_Benchmark()
+{
+}
+
+void KX_Benchmark::Start()
+{
+	for (std::vector<double>& times : m_times) {
+		times.clear();
+	}
+	m_frameTimes.clear();
+
+	MEM_reset_peak_memory();
+	m_startMemory = MEM_get_memory_in_use();
+	m_maxFrameMemory = m_startMemory;
+}
+
+void KX_Benchmark::AddFrame(const std::vector<double>& times)
+{
+	double frameTime = 0.0;
+	for (unsigned int i = 0, size = m_times.size(); i < size; ++i) {
+		m_times[i].push_back(times[i]);
+		frameTime += times[i];
+	}
+	m_frameTimes.push_back(frameTime);
+
+	m_maxFrameMemory = std::max(m_maxFrameMemory, MEM_get_memory_in_use());
+}
+
+unsigned int KX_Benchmark::GetNumFrames() const
+{
+	return m_frameTimes.size();
+}
+
+void KX_Benchmark::Write(std::ostream& output, const std::string& fileName, double timestep) const
+{
+	std::stringstream stream;
+	stream.precision(6);
+	stream << std::fixed;
+
+	stream << "{\n";
+	stream << "  \"file\": " << jsonString(fileName) << ",\n";
+	stream << "  \"frames\": " << m_frameTimes.size() << ",\n";
+	stream << "  \"timestep\": " << timestep << ",\n";
+
+	stream << "  \"frame\": ";
+	writeStatistics(stream, m_frameTimes);
+	stream << ",\n";
+
+	stream << "  \"categories\": {\n";
+	for (unsigned int i = 0, size = m_categories.size(); i < size; ++i) {
+		stream << "    " << jsonString(m_categories[i]) << ": ";
+		writeStatistics(stream, m_times[i]);
+		stream << ((i < size - 1) ? ",\n" : "\n");
+	}
+	stream << "  },\n";
+
+	stream << "  \"memory\": {"
+		   << "\"start\": " << m_startMemory
+		   << ", \"end\": " << MEM_get_memory_in_use()
+		   << ", \"max_frame\": " << m_maxFrameMemory
+		   << ", \"peak\": " << MEM_get_peak_memory() << "}\n";
+	stream << "}\n";
+
+	output << stream.str();
+}
+
+bool KX_Benchmark::Write(const std::string& path, const std::string& fileName, double timestep) const
+{
+	std::stringstream stream;
+	Write(stream, fileName, timestep);
+	const std::string data = stream.str();
+
+	FILE *file = BLI_fopen(path.c_str(), "wb");
+	if (!file) {
+		CM_Error("could not open '" << path << "'");
+		return false;
+	}
+
+	const bool success = (fwrite(data.data(), 1, data.size(), file) == data.size());
+	if ((fclose(file) != 0) || !success) {
+		CM_Error("could not write '" << path << "'");
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,75 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_Benchmark.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_BENCHMARK_H__
+#define __KX_BENCHMARK_H__
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+/** Record the time spent in each profiling category and the memory usage
+ * for every frame, and write the statistics of the whole run in JSON.
+ */
+class KX_Benchmark
+{
+private:
+	/// Name of each category used in the output.
+	std::vector<std::string> m_categories;
+	/// Time measurements per category and per frame in seconds.
+	std::vector<std::vector<double> > m_times;
+	/// Sum of all the categories per frame.
+	std::vector<double> m_frameTimes;
+
+	/// Memory allocated at the start of the recording.
+	size_t m_startMemory;
+	/// Maximum memory allocated at the end of a frame.
+	size_t m_maxFrameMemory;
+
+public:
+	KX_Benchmark(const std::vector<std::string>& categories);
+	~KX_Benchmark();
+
+	/// Reset the statistics and the memory peak.
+	void Start();
+
+	/** Add the measurements of a frame.
+	 * \param times The time spent in each category in seconds, in the order of the categories.
+	 */
+	void AddFrame(const std::vector<double>& times);
+
+	unsigned int GetNumFrames() const;
+
+	/** Write the statistics in JSON, the times are in milliseconds and the memory in bytes.
+	 * \param fileName The game file used, only written for reference.
+	 * \param timestep The fixed time step of the run in seconds.
+	 */
+	void Write(std::ostream& output, const std::string& fileName, double timestep) const;
+	/// Write the statistics in a file, return false if the file can't be written.
+	bool Write(const std::string& path, const std::string& fileName, double timestep) const;
+};
+
+#endif  // __KX_BENCHMARK_H__
@@ -66,7 +66,9 @@ KX_BlenderMaterial::KX_BlenderMaterial(
 	if (m_material->use_nodes && m_material->nodetree) {
       RAS_ICanvas *canvas = KX_GetActiveEngine()->GetCanvas();
       ARegion *ar = canvas->GetARegion(); // if no ar, we are in blenderplayer
-      if ((m_scene->GetBlenderScene()->gm.flag & GAME_USE_VIEWPORT_RENDER) == 0 || !ar) {
+      // A headless player doesn't have any GPU context to compile the material.
+      const bool headless = KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::HEADLESS);
+      if (!headless && ((m_scene->GetBlenderScene()->gm.flag & GAME_USE_VIEWPORT_RENDER) == 0 || !ar)) {
         EEVEE_Data *vedata = EEVEE_engine_data_get();
         EEVEE_EffectsInfo *effects = vedata->stl->effects;
         const bool use_ssrefract = ((m_material->blend_flag & MA_BL_SS_REFRACTION) != 0) &&
@@ -35,6 +35,7 @@
 #include "KX_Camera.h"
 #include "KX_Scene.h"
 #include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
 #include "EXP_Python.h"
 #include "KX_PyMath.h"
 
@@ -132,6 +133,18 @@ MT_Transform KX_Camera::GetCameraToWorld() const
 	return MT_Transform(NodeGetWorldPosition(), NodeGetWorldOrientation());
 }
 
+MT_Transform KX_Camera::GetRenderWorldToCamera() const
+{
+	MT_Vector3 position, scaling;
+	MT_Matrix3x3 rotation;
+	GetSGNode()->GetInterpolatedWorldTransform(KX_GetActiveEngine()->GetInterpolationFactor(), position, rotation, scaling);
+
+	MT_Transform camtrans;
+	camtrans.invert(MT_Transform(position, rotation));
+
+	return camtrans;
+}
+
 /**
  * Sets the projection matrix that is used by the rasterizer.
  */
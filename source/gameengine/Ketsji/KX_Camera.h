@@ -148,6 +148,8 @@ public:
 
 	MT_Transform		GetWorldToCamera() const;
 	MT_Transform		GetCameraToWorld() const;
+	/// World to camera transform of the rendered frame, see KX_GameObject::NodeGetRenderTransform.
+	MT_Transform		GetRenderWorldToCamera() const;
 
 	/** Sets the projection matrix that is used by the rasterizer. */
 	void				SetProjectionMatrix(const MT_Matrix4x4 & mat);
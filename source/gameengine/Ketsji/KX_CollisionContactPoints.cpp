@@ -27,6 +27,7 @@
 #include "KX_CollisionContactPoints.h"
 #include "PHY_DynamicTypes.h"
 #include "KX_PyMath.h"
+#include "KX_FrameArena.h"
 
 KX_CollisionContactPoint::KX_CollisionContactPoint(const PHY_CollData *collData, unsigned int index, bool firstObject)
 	:m_collData(collData),
@@ -156,15 +157,15 @@ static PyObject *kx_collision_contact_point_list_get_sensors_item_cb(void *self_
 	return ((KX_CollisionContactPointList *)self_v)->GetCollisionContactPoint(index)->NewProxy(true);
 }
 
-CListWrapper *KX_CollisionContactPointList::GetListWrapper()
+CListWrapper *KX_CollisionContactPointList::GetListWrapper(KX_FrameArena& arena)
 {
-	return (new CListWrapper(this,
+	return arena.New<CListWrapper>(this,
 							 nullptr, // No base python proxy.
 							 nullptr,
 							 kx_collision_contact_point_list_get_sensors_size_cb,
 							 kx_collision_contact_point_list_get_sensors_item_cb,
 							 nullptr,
-							 nullptr));
+							 nullptr);
 }
 
 #endif  // WITH_PYTHON
@@ -31,6 +31,7 @@
 #include "EXP_ListWrapper.h"
 
 class PHY_CollData;
+class KX_FrameArena;
 
 class KX_CollisionContactPoint : public CValue
 {
@@ -75,7 +76,8 @@ public:
 	virtual ~KX_CollisionContactPointList();
 
 #ifdef WITH_PYTHON
-	CListWrapper *GetListWrapper();
+	/// Return a list wrapper allocated in the frame arena, its proxy must be invalidated after use.
+	CListWrapper *GetListWrapper(KX_FrameArena& arena);
 #endif  // WITH_PYTHON
 
 	KX_CollisionContactPoint *GetCollisionContactPoint(unsigned int index);
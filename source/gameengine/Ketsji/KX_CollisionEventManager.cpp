@@ -38,11 +38,33 @@
 #include "PHY_IPhysicsEnvironment.h"
 #include "PHY_IPhysicsController.h"
 
+#include <algorithm>
+
+/// Return true if the collisions of a controller are used by a collision sensor or a python callback.
+static bool useCollisions(PHY_IPhysicsController *ctrl)
+{
+	KX_ClientObjectInfo *client_info = static_cast<KX_ClientObjectInfo *>(ctrl->GetNewClientInfo());
+	if (!client_info) {
+		return false;
+	}
+
+	if (!client_info->m_sensors.empty()) {
+		return true;
+	}
+
+#ifdef WITH_PYTHON
+	KX_GameObject *gameobj = client_info->m_gameobject;
+	return (gameobj && gameobj->m_collisionCallbacks && PyList_GET_SIZE(gameobj->m_collisionCallbacks) > 0);
+#else
+	return false;
+#endif
+}
 
 KX_CollisionEventManager::KX_CollisionEventManager(class SCA_LogicManager *logicmgr,
                                                    PHY_IPhysicsEnvironment *physEnv)
 	:SCA_EventManager(logicmgr, TOUCH_EVENTMGR),
-	m_physEnv(physEnv)
+	m_physEnv(physEnv),
+	m_queryPhase(0)
 {
 	m_physEnv->AddCollisionCallback(PHY_OBJECT_RESPONSE, KX_CollisionEventManager::newCollisionResponse, this);
 	m_physEnv->AddCollisionCallback(PHY_SENSOR_RESPONSE, KX_CollisionEventManager::newCollisionResponse, this);
@@ -52,15 +74,6 @@ KX_CollisionEventManager::KX_CollisionEventManager(class SCA_LogicManager *logic
 
 KX_CollisionEventManager::~KX_CollisionEventManager()
 {
-	RemoveNewCollisions();
-}
-
-void KX_CollisionEventManager::RemoveNewCollisions()
-{
-	for (std::set<NewCollision>::iterator it = m_newCollisions.begin(), end = m_newCollisions.end(); it != end; ++it) {
-		delete it->colldata;
-	}
-	m_newCollisions.clear();
 }
 
 bool KX_CollisionEventManager::NewHandleCollision(void *object1, void *object2, const PHY_CollData *coll_data)
@@ -68,7 +81,10 @@ bool KX_CollisionEventManager::NewHandleCollision(void *object1, void *object2,
 	PHY_IPhysicsController *obj1 = static_cast<PHY_IPhysicsController *>(object1);
 	PHY_IPhysicsController *obj2 = static_cast<PHY_IPhysicsController *>(object2);
 
-	m_newCollisions.insert(NewCollision(obj1, obj2, coll_data));
+	// Filter the pairs up front, most of the colliding objects don't use their collisions.
+	if (useCollisions(obj1) || useCollisions(obj2)) {
+		m_newCollisions.push_back({obj1, obj2, coll_data});
+	}
 
 	return false;
 }
@@ -191,75 +207,53 @@ void KX_CollisionEventManager::EndFrame()
 void KX_CollisionEventManager::NextFrame()
 {
 	for (SCA_ISensor *sensor : m_sensors) {
-        static_cast<SCA_CollisionSensor *>(sensor)->SynchronizeTransform();
+		SCA_CollisionSensor *collisionSensor = static_cast<SCA_CollisionSensor *>(sensor);
+		collisionSensor->SynchronizeTransform();
+		collisionSensor->QueryCollisions(m_physEnv);
 	}
 
-	for (std::set<NewCollision>::iterator cit = m_newCollisions.begin(); cit != m_newCollisions.end(); ++cit) {
+	/* Several contact manifolds can exist between the same objects, sorting
+	 * the pairs allows to notify the sensors only once per pair. */
+	std::sort(m_newCollisions.begin(), m_newCollisions.end(), [](const NewCollision& a, const NewCollision& b) {
+		return (a.first < b.first) || (a.first == b.first && a.second < b.second);
+	});
+
+	for (unsigned int i = 0, size = m_newCollisions.size(); i < size; ++i) {
+		const NewCollision& collision = m_newCollisions[i];
 		// Controllers
-		PHY_IPhysicsController *ctrl1 = (*cit).first;
-		PHY_IPhysicsController *ctrl2 = (*cit).second;
-		// Sensor iterator
-		std::list<SCA_ISensor *>::iterator sit;
-
-		// First client info
-		KX_ClientObjectInfo *client_info = static_cast<KX_ClientObjectInfo *>(ctrl1->GetNewClientInfo());
-		// First gameobject
-		KX_GameObject *kxObj1 = KX_GameObject::GetClientObject(client_info);
+		PHY_IPhysicsController *ctrl1 = collision.first;
+		PHY_IPhysicsController *ctrl2 = collision.second;
+
+		// First and second client info
+		KX_ClientObjectInfo *client_info1 = static_cast<KX_ClientObjectInfo *>(ctrl1->GetNewClientInfo());
+		KX_ClientObjectInfo *client_info2 = static_cast<KX_ClientObjectInfo *>(ctrl2->GetNewClientInfo());
+
 		// Invoke sensor response for each object
-		if (client_info) {
-			for (sit = client_info->m_sensors.begin(); sit != client_info->m_sensors.end(); ++sit) {
-				static_cast<SCA_CollisionSensor *>(*sit)->NewHandleCollision(ctrl1, ctrl2, nullptr);
+		if (i == 0 || ctrl1 != m_newCollisions[i - 1].first || ctrl2 != m_newCollisions[i - 1].second) {
+			if (client_info1) {
+				for (SCA_ISensor *sensor : client_info1->m_sensors) {
+					static_cast<SCA_CollisionSensor *>(sensor)->NewHandleCollision(ctrl1, ctrl2, nullptr);
+				}
+			}
+			if (client_info2) {
+				for (SCA_ISensor *sensor : client_info2->m_sensors) {
+					static_cast<SCA_CollisionSensor *>(sensor)->NewHandleCollision(ctrl2, ctrl1, nullptr);
+				}
 			}
 		}
 
-		// Second client info
-		client_info = static_cast<KX_ClientObjectInfo *>(ctrl2->GetNewClientInfo());
-		// Second gameobject
-		KX_GameObject *kxObj2 = KX_GameObject::GetClientObject(client_info);
-		if (client_info) {
-			for (sit = client_info->m_sensors.begin(); sit != client_info->m_sensors.end(); ++sit) {
-				static_cast<SCA_CollisionSensor *>(*sit)->NewHandleCollision(ctrl2, ctrl1, nullptr);
-			}
+		// Run python callbacks, the contact points are only created if a callback uses them.
+		KX_GameObject *kxObj1 = KX_GameObject::GetClientObject(client_info1);
+		KX_GameObject *kxObj2 = KX_GameObject::GetClientObject(client_info2);
+		if (kxObj1 && kxObj2) {
+			kxObj1->RunCollisionCallbacks(kxObj2, collision.colldata, true);
+			kxObj2->RunCollisionCallbacks(kxObj1, collision.colldata, false);
 		}
-		// Run python callbacks
-		const PHY_CollData *colldata = cit->colldata;
-		KX_CollisionContactPointList contactPointList0 = KX_CollisionContactPointList(colldata, true);
-		KX_CollisionContactPointList contactPointList1 = KX_CollisionContactPointList(colldata, false);
-		kxObj1->RunCollisionCallbacks(kxObj2, contactPointList0);
-		kxObj2->RunCollisionCallbacks(kxObj1, contactPointList1);
 	}
 
 	for (SCA_ISensor *sensor : m_sensors) {
 		sensor->Activate(m_logicmgr);
 	}
 
-	RemoveNewCollisions();
-}
-
-KX_CollisionEventManager::NewCollision::NewCollision(PHY_IPhysicsController *first,
-                                                     PHY_IPhysicsController *second,
-                                                     const PHY_CollData *colldata)
-	:first(first),
-	second(second),
-	colldata(colldata)
-{
-}
-
-KX_CollisionEventManager::NewCollision::NewCollision(const NewCollision &to_copy)
-	:first(to_copy.first),
-	second(to_copy.second),
-	colldata(to_copy.colldata)
-{
-}
-
-bool KX_CollisionEventManager::NewCollision::operator<(const NewCollision &other) const
-{
-	//see strict weak ordering: https://support.microsoft.com/en-us/kb/949171
-	if (first == other.first) {
-		if (second == other.second) {
-			return colldata < other.colldata;
-		}
-		return second < other.second;
-	}
-	return first < other.first;
+	m_newCollisions.clear();
 }
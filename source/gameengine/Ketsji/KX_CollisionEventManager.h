@@ -38,7 +38,6 @@
 #include "KX_GameObject.h"
 
 #include <vector>
-#include <set>
 
 class SCA_ISensor;
 class PHY_IPhysicsEnvironment;
@@ -46,32 +45,23 @@ class PHY_IPhysicsEnvironment;
 class KX_CollisionEventManager : public SCA_EventManager
 {
 	/**
-	 * Contains two colliding objects and the first contact point.
+	 * Contains two colliding objects and their contact points.
 	 */
-	class NewCollision
+	struct NewCollision
 	{
-	public:
 		PHY_IPhysicsController *first;
 		PHY_IPhysicsController *second;
+		/// Owned by the physics environment and valid until the next physics step.
 		const PHY_CollData *colldata;
-
-		/**
-		 * Creates a copy of the given PHY_CollData; freeing that copy should be done by the owner of
-		 * the NewCollision object.
-		 *
-		 * This allows us to efficiently store NewCollision objects in a std::set without creating more
-		 * copies of colldata, as the NewCollision copy constructor reuses the pointer and doesn't clone
-		 * it again. */
-		NewCollision(PHY_IPhysicsController *first,
-		             PHY_IPhysicsController *second,
-		             const PHY_CollData *colldata);
-		NewCollision(const NewCollision &to_copy);
-		bool operator<(const NewCollision &other) const;
 	};
 
 	PHY_IPhysicsEnvironment *m_physEnv;
 
-	std::set<NewCollision> m_newCollisions;
+	/// Collisions of the last physics step used by a sensor or a python callback, the buffer is reused every step.
+	std::vector<NewCollision> m_newCollisions;
+
+	/// Counter used to stagger the queries of the sensors skipping frames.
+	unsigned int m_queryPhase;
 
 	static bool newCollisionResponse(void *client_data,
 	                                 void *object1,
@@ -86,8 +76,6 @@ class KX_CollisionEventManager : public SCA_EventManager
 	virtual bool NewHandleCollision(void *obj1, void *obj2,
 									const PHY_CollData *coll_data);
 
-	void RemoveNewCollisions();
-
 public:
 	KX_CollisionEventManager(class SCA_LogicManager *logicmgr,
 	                         PHY_IPhysicsEnvironment *physEnv);
@@ -97,14 +85,16 @@ public:
 	virtual bool RegisterSensor(SCA_ISensor *sensor);
 	virtual bool RemoveSensor(SCA_ISensor *sensor);
 
-	SCA_LogicManager *GetLogicManager()
-	{
-		return m_logicmgr;
-	}
 	PHY_IPhysicsEnvironment *GetPhysicsEnvironment()
 	{
 		return m_physEnv;
 	}
+
+	/// Return a different phase for each query sensor registered.
+	unsigned int NextQueryPhase()
+	{
+		return m_queryPhase++;
+	}
 };
 
 #endif  // __KX_TOUCHEVENTMANAGER_H__
@@ -0,0 +1,127 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_FrameArena.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_FrameArena.h"
+
+#include <algorithm>
+
+// Alignment of every allocation, enough for any scalar or vector type.
+static const size_t ARENA_ALIGNMENT = 16;
+
+KX_FrameArena::KX_FrameArena(size_t blockSize)
+	:m_blockSize(0),
+	m_blockUsed(0),
+	m_totalSize(0),
+	m_numAllocations(0),
+	m_allocatedSize(0),
+	m_numBlockAllocations(0),
+	m_lastNumAllocations(0),
+	m_lastAllocatedSize(0),
+	m_lastNumBlockAllocations(0)
+{
+	AddBlock(blockSize);
+}
+
+KX_FrameArena::~KX_FrameArena()
+{
+	Reset();
+
+	for (char *block : m_blocks) {
+		delete[] block;
+	}
+}
+
+void KX_FrameArena::AddBlock(size_t size)
+{
+	m_blocks.push_back(new char[size]);
+	m_blockSize = size;
+	m_blockUsed = 0;
+	m_totalSize += size;
+}
+
+void *KX_FrameArena::Allocate(size_t size)
+{
+	size = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+
+	if (m_blockUsed + size > m_blockSize) {
+		// Grow geometrically to keep the number of blocks low on the first frames.
+		AddBlock(std::max(size, m_blockSize * 2));
+		++m_numBlockAllocations;
+	}
+
+	void *ptr = m_blocks.back() + m_blockUsed;
+	m_blockUsed += size;
+
+	++m_numAllocations;
+	m_allocatedSize += size;
+
+	return ptr;
+}
+
+void KX_FrameArena::Reset()
+{
+	// Destruct in reverse order of construction.
+	for (std::vector<std::pair<void *, void (*)(void *)> >::reverse_iterator it = m_destructors.rbegin(),
+	     end = m_destructors.rend(); it != end; ++it)
+	{
+		it->second(it->first);
+	}
+	m_destructors.clear();
+
+	// Merge the blocks to fit the whole frame in one block next time.
+	if (m_blocks.size() > 1) {
+		const size_t size = m_totalSize;
+		for (char *block : m_blocks) {
+			delete[] block;
+		}
+		m_blocks.clear();
+		m_totalSize = 0;
+		AddBlock(size);
+	}
+	m_blockUsed = 0;
+
+	m_lastNumAllocations = m_numAllocations;
+	m_lastAllocatedSize = m_allocatedSize;
+	m_lastNumBlockAllocations = m_numBlockAllocations;
+	m_numAllocations = 0;
+	m_allocatedSize = 0;
+	m_numBlockAllocations = 0;
+}
+
+unsigned int KX_FrameArena::GetNumAllocations() const
+{
+	return m_lastNumAllocations;
+}
+
+size_t KX_FrameArena::GetAllocatedSize() const
+{
+	return m_lastAllocatedSize;
+}
+
+unsigned int KX_FrameArena::GetNumBlockAllocations() const
+{
+	return m_lastNumBlockAllocations;
+}
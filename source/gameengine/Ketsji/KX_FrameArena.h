@@ -0,0 +1,114 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_FrameArena.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_FRAME_ARENA_H__
+#define __KX_FRAME_ARENA_H__
+
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+/** Memory arena for the temporaries of a logic frame.
+ * The allocations are bump allocated in blocks and all released by Reset() at the end
+ * of the frame. When a frame needed more than one block, the blocks are merged in one
+ * block large enough for the whole frame, the next frames then don't allocate memory.
+ */
+class KX_FrameArena
+{
+private:
+	/// Memory blocks, allocations are done in the last one.
+	std::vector<char *> m_blocks;
+	/// Size of the last block.
+	size_t m_blockSize;
+	/// Used size of the last block.
+	size_t m_blockUsed;
+	/// Size of all the blocks.
+	size_t m_totalSize;
+
+	/// Objects to destruct in Reset() with their destructor.
+	std::vector<std::pair<void *, void (*)(void *)> > m_destructors;
+
+	/// Statistics of the current frame.
+	unsigned int m_numAllocations;
+	size_t m_allocatedSize;
+	unsigned int m_numBlockAllocations;
+
+	/// Statistics of the last reset frame.
+	unsigned int m_lastNumAllocations;
+	size_t m_lastAllocatedSize;
+	unsigned int m_lastNumBlockAllocations;
+
+	void AddBlock(size_t size);
+
+	template <class Type>
+	static void Destruct(void *ptr)
+	{
+		static_cast<Type *>(ptr)->~Type();
+	}
+
+public:
+	KX_FrameArena(size_t blockSize = 16 * 1024);
+	~KX_FrameArena();
+
+	KX_FrameArena(const KX_FrameArena& other) = delete;
+	KX_FrameArena& operator=(const KX_FrameArena& other) = delete;
+
+	/// Allocate memory valid until the next Reset().
+	void *Allocate(size_t size);
+
+	/// Construct an object destructed by the next Reset().
+	template <class Type, class ... Args>
+	Type *New(Args&& ... args)
+	{
+		Type *ptr = new (Allocate(sizeof(Type))) Type(std::forward<Args>(args)...);
+		if (!std::is_trivially_destructible<Type>::value) {
+			m_destructors.emplace_back(ptr, Destruct<Type>);
+		}
+		return ptr;
+	}
+
+	/// Allocate an uninitialized array of trivial values.
+	template <class Type>
+	Type *NewArray(unsigned int size)
+	{
+		static_assert(std::is_trivially_destructible<Type>::value, "Array values are never destructed");
+		return static_cast<Type *>(Allocate(sizeof(Type) * size));
+	}
+
+	/// Destruct the objects and release all the allocations.
+	void Reset();
+
+	/// Number of allocations done in the last frame.
+	unsigned int GetNumAllocations() const;
+	/// Size allocated in the last frame.
+	size_t GetAllocatedSize() const;
+	/// Number of memory blocks allocated in the last frame, 0 when the frame used the arena only.
+	unsigned int GetNumBlockAllocations() const;
+};
+
+#endif  // __KX_FRAME_ARENA_H__
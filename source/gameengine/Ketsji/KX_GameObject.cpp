@@ -63,7 +63,9 @@
 #include "KX_Scene.h"
 #include "KX_LodLevel.h"
 #include "KX_LodManager.h"
+#include "BL_SkinDeformer.h"
 #include "KX_CollisionContactPoints.h"
+#include "PHY_IGraphicController.h"
 
 #include "BKE_object.h"
 
@@ -90,6 +92,7 @@
 #include "BLI_math.h"
 
 #include "CM_Message.h"
+#include "CM_Memory.h"
 
 /* eevee integration */
 #include "DRW_render.h"
@@ -102,6 +105,7 @@ extern "C" {
 #include "BKE_mesh.h"
 #include "BLI_alloca.h"
 #include "BLI_listbase.h"
+#include "MEM_guardedalloc.h"
 #include "depsgraph/DEG_depsgraph_build.h"
 #include "depsgraph/DEG_depsgraph_query.h"
 #include "DNA_mesh_types.h"
@@ -126,18 +130,23 @@ KX_GameObject::KX_GameObject(void *sgReplicationInfo, SG_Callbacks callbacks)
     : SCA_IObject(),
       m_castShadows(true),          // eevee
       m_isReplica(false),           // eevee
+      m_replicaMemorySize(0),
       m_staticObject(true),         // eevee
       m_visibleAtGameStart(false),  // eevee
       m_layer(0),
       m_lodManager(nullptr),
       m_currentLodLevel(0),
+      m_skinDeformer(nullptr),
       m_pBlenderObject(nullptr),
       m_pBlenderGroupObject(nullptr),
       m_bIsNegativeScaling(false),
       m_objectColor(1.0f, 1.0f, 1.0f, 1.0f),
       m_bVisible(true),
+      m_bCulled(false),
       m_bOccluder(false),
       m_pPhysicsController(nullptr),
+      m_pGraphicController(nullptr),
+      m_graphicTransformPending(false),
       m_components(NULL),
       m_pInstanceObjects(nullptr),
       m_pDupliGroupObject(nullptr),
@@ -148,9 +157,16 @@ KX_GameObject::KX_GameObject(void *sgReplicationInfo, SG_Callbacks callbacks)
       m_collisionCallbacks(nullptr)
 #endif
 {
+#ifdef WITH_PYTHON
+  std::fill(m_cachedMathObjects, m_cachedMathObjects + CACHED_MATH_MAX, nullptr);
+#endif  // WITH_PYTHON
+
   m_ignore_activity_culling = false;
   m_pClient_info = new KX_ClientObjectInfo(this, KX_ClientObjectInfo::ACTOR);
-  m_pSGNode = new SG_Node(this, sgReplicationInfo, callbacks);
+  m_pSGNode = new SG_Node(this,
+                          sgReplicationInfo,
+                          callbacks,
+                          static_cast<KX_Scene *>(sgReplicationInfo)->GetTransformStore());
 
   // define the relationship between this node and it's parent.
 
@@ -178,8 +194,16 @@ KX_GameObject::~KX_GameObject()
   if (m_components) {
     m_components->Release();
   }
+
+  ClearCachedMathObjects();
 #endif  // WITH_PYTHON
 
+  // Remove from the culling tree before SetVisible can activate it again.
+  if (m_pGraphicController) {
+    delete m_pGraphicController;
+    m_pGraphicController = nullptr;
+  }
+
   /* EEVEE INTEGRATION */
 
   Object *ob = GetBlenderObject();
@@ -188,6 +212,7 @@ KX_GameObject::~KX_GameObject()
     if (ob->gameflag & OB_OVERLAY_COLLECTION) {
       ob->gameflag &= ~OB_OVERLAY_COLLECTION;
     }
+    ob->gameflag &= ~OB_CULLED;
   }
 
   KX_Scene *scene = GetScene();
@@ -250,6 +275,10 @@ KX_GameObject::~KX_GameObject()
   if (m_lodManager) {
     m_lodManager->Release();
   }
+
+  if (m_skinDeformer) {
+    delete m_skinDeformer;
+  }
 }
 
 /************************EEVEE_INTEGRATION**********************/
@@ -269,7 +298,7 @@ void KX_GameObject::SetBlenderObject(Object *obj)
 void KX_GameObject::TagForUpdate(bool is_overlay_pass)
 {
   float obmat[4][4];
-  NodeGetWorldTransform().getValue(&obmat[0][0]);
+  NodeGetRenderTransform().getValue(&obmat[0][0]);
   m_staticObject = compare_m4m4(m_prevObmat, obmat, FLT_MIN);
 
   Scene *sc = GetScene()->GetBlenderScene();
@@ -333,6 +362,7 @@ void KX_GameObject::ReplicateBlenderObject()
 
   if (ob) {
     Main *bmain = KX_GetActiveEngine()->GetConverter()->GetMain();
+    const size_t memoryInUse = MEM_get_memory_in_use();
     Object *newob;
     BKE_id_copy_ex(bmain, &ob->id, (ID **)&newob, 0);
     Scene *scene = GetScene()->GetBlenderScene();
@@ -366,6 +396,11 @@ void KX_GameObject::ReplicateBlenderObject()
 
 	DEG_relations_tag_update(bmain);
 
+    // Estimation of the copied data, allocations from other threads are counted too.
+    const size_t memoryAfterCopy = MEM_get_memory_in_use();
+    m_replicaMemorySize = (memoryAfterCopy > memoryInUse) ? memoryAfterCopy - memoryInUse : 0;
+    CM_MemoryAdd(CM_MEMORY_REPLICA_ID, m_replicaMemorySize);
+
     m_pBlenderObject = newob;
     m_isReplica = true;
   }
@@ -380,6 +415,9 @@ void KX_GameObject::RemoveReplicaObject()
     BKE_id_free(bmain, &ob->id);
     SetBlenderObject(nullptr);
     DEG_relations_tag_update(bmain);
+
+    CM_MemoryRemove(CM_MEMORY_REPLICA_ID, m_replicaMemorySize);
+    m_replicaMemorySize = 0;
   }
 }
 
@@ -548,7 +586,18 @@ std::string KX_GameObject::GetName()
 /* Set the name of the value */
 void KX_GameObject::SetName(const std::string &name)
 {
+  if (name == m_name) {
+    return;
+  }
+
+  const std::string oldname = m_name;
   m_name = name;
+
+  // Keep the name index of the scene object lists consistent.
+  KX_Scene *scene = m_pSGNode ? GetScene() : nullptr;
+  if (scene) {
+    scene->RenameObject(this, oldname);
+  }
 }
 
 PHY_IPhysicsController *KX_GameObject::GetPhysicsController()
@@ -820,6 +869,8 @@ void KX_GameObject::ProcessReplica()
   ReplicateBlenderObject();
 
   m_pPhysicsController = nullptr;
+  m_pGraphicController = nullptr;
+  m_graphicTransformPending = false;
   m_pSGNode = nullptr;
 
   /* Dupli group and instance list are set later in replication.
@@ -835,11 +886,18 @@ void KX_GameObject::ProcessReplica()
     m_lodManager->AddRef();
   }
 
+  if (m_skinDeformer) {
+    m_skinDeformer = m_skinDeformer->GetReplica(this);
+  }
+
 #ifdef WITH_PYTHON
 
   if (m_attr_dict)
     m_attr_dict = PyDict_Copy(m_attr_dict);
 
+  // The cached objects use the proxy of the original object.
+  std::fill(m_cachedMathObjects, m_cachedMathObjects + CACHED_MATH_MAX, nullptr);
+
   if (m_components) {
     m_components = (CListValue<KX_PythonComponent> *)m_components->GetReplica();
     for (KX_PythonComponent *component : m_components) {
@@ -895,6 +953,19 @@ bool KX_GameObject::IsDynamic() const
   return false;
 }
 
+bool KX_GameObject::IsIsolated() const
+{
+  return (!m_pSGNode->GetSGParent() && m_pSGNode->GetSGChildren().empty());
+}
+
+void KX_GameObject::EndParallelUpdate()
+{
+  if (m_graphicTransformPending) {
+    m_pGraphicController->SetGraphicTransform();
+    m_graphicTransformPending = false;
+  }
+}
+
 bool KX_GameObject::IsDynamicsSuspended() const
 {
   if (m_pPhysicsController)
@@ -993,7 +1064,22 @@ void KX_GameObject::RemoveMeshes()
 
 bool KX_GameObject::UseCulling() const
 {
-  return false;
+  return (m_pGraphicController != nullptr);
+}
+
+void KX_GameObject::SetCulled(bool c)
+{
+  m_bCulled = c;
+
+  Object *ob = GetBlenderObject();
+  if (ob) {
+    if (c) {
+      ob->gameflag |= OB_CULLED;
+    }
+    else {
+      ob->gameflag &= ~OB_CULLED;
+    }
+  }
 }
 
 void KX_GameObject::SetLodManager(KX_LodManager *lodManager)
@@ -1024,6 +1110,20 @@ KX_LodManager *KX_GameObject::GetLodManager() const
 	return m_lodManager;
 }
 
+void KX_GameObject::SetSkinDeformer(BL_SkinDeformer *deformer)
+{
+	if (m_skinDeformer) {
+		delete m_skinDeformer;
+	}
+
+	m_skinDeformer = deformer;
+}
+
+BL_SkinDeformer *KX_GameObject::GetSkinDeformer() const
+{
+	return m_skinDeformer;
+}
+
 void KX_GameObject::UpdateLod(const MT_Vector3& cam_pos, float lodfactor)
 {
   if (!m_lodManager) {
@@ -1066,6 +1166,17 @@ void KX_GameObject::UpdateTransform()
   // HACK: saves function call for dynamic object, they are handled differently
   if (m_pPhysicsController && !m_pPhysicsController->IsDynamic())
     m_pPhysicsController->SetTransform();
+  if (m_pGraphicController) {
+    /* The culling tree is shared by all the objects, during the parallel actuator update
+     * it is updated later on the main thread, see EndParallelUpdate. */
+    if (GetScene()->GetLogicManager()->IsParallelUpdate()) {
+      m_graphicTransformPending = true;
+    }
+    else {
+      // update the culling tree
+      m_pGraphicController->SetGraphicTransform();
+    }
+  }
 }
 
 void KX_GameObject::UpdateTransformFunc(SG_Node *node, void *gameobj, void *scene)
@@ -1152,6 +1263,36 @@ void KX_GameObject::SetVisible(bool v, bool recursive)
   }
 
   m_bVisible = v;
+  // invisible objects are removed from the culling tree
+  if (m_pGraphicController) {
+    m_pGraphicController->Activate(m_bVisible);
+  }
+}
+
+static void setGraphicController_recursive(SG_Node *node)
+{
+  NodeList &children = node->GetSGChildren();
+
+  for (NodeList::iterator childit = children.begin(); !(childit == children.end()); ++childit) {
+    SG_Node *childnode = (*childit);
+    KX_GameObject *clientgameobj = static_cast<KX_GameObject *>((*childit)->GetSGClientObject());
+    if (clientgameobj != nullptr)  // This is a GameObject
+      clientgameobj->ActivateGraphicController(false);
+
+    // if the childobj is nullptr then this may be an inverse parent link
+    // so a non recursive search should still look down this node.
+    setGraphicController_recursive(childnode);
+  }
+}
+
+void KX_GameObject::ActivateGraphicController(bool recurse)
+{
+  if (m_pGraphicController) {
+    m_pGraphicController->Activate(m_bVisible);
+  }
+  if (recurse) {
+    setGraphicController_recursive(GetSGNode());
+  }
 }
 
 static void setOccluder_recursive(SG_Node *node, bool v)
@@ -1546,7 +1687,13 @@ void KX_GameObject::NodeSetWorldPosition(const MT_Vector3 &trans)
 
 void KX_GameObject::NodeUpdateGS(double time)
 {
-  m_pSGNode->UpdateWorldData(time);
+  // The actuators updated in parallel share the scene graph update list.
+  if (GetScene()->GetLogicManager()->IsParallelUpdate()) {
+    m_pSGNode->UpdateWorldDataThread(time);
+  }
+  else {
+    m_pSGNode->UpdateWorldData(time);
+  }
 }
 
 const MT_Matrix3x3 &KX_GameObject::NodeGetWorldOrientation() const
@@ -1584,6 +1731,15 @@ MT_Transform KX_GameObject::NodeGetWorldTransform() const
   return m_pSGNode->GetWorldTransform();
 }
 
+MT_Transform KX_GameObject::NodeGetRenderTransform() const
+{
+  MT_Vector3 position, scaling;
+  MT_Matrix3x3 rotation;
+  m_pSGNode->GetInterpolatedWorldTransform(
+      KX_GetActiveEngine()->GetInterpolationFactor(), position, rotation, scaling);
+  return MT_Transform(position, rotation.scaled(scaling[0], scaling[1], scaling[2]));
+}
+
 MT_Transform KX_GameObject::NodeGetLocalTransform() const
 {
   return m_pSGNode->GetLocalTransform();
@@ -1631,29 +1787,43 @@ void KX_GameObject::RegisterCollisionCallbacks()
   }
 }
 void KX_GameObject::RunCollisionCallbacks(KX_GameObject *collider,
-                                          KX_CollisionContactPointList &contactPointList)
+                                          const PHY_CollData *collData,
+                                          bool first)
 {
 #ifdef WITH_PYTHON
   if (!m_collisionCallbacks || PyList_GET_SIZE(m_collisionCallbacks) == 0) {
     return;
   }
 
-  CListWrapper *listWrapper = contactPointList.GetListWrapper();
-  PyObject *args[] = {collider->GetProxy(),
-                      PyObjectFrom(contactPointList.GetCollData()->GetWorldPoint(
-                          0, contactPointList.GetFirstObject())),
-                      PyObjectFrom(contactPointList.GetCollData()->GetNormal(
-                          0, contactPointList.GetFirstObject())),
-                      listWrapper->GetProxy()};
+  // Only create the arguments used by at least one callback.
+  const unsigned int argcount = GetPythonCallBackListMaxArgCount(m_collisionCallbacks, 1, 4);
+
+  PyObject *args[] = {collider->GetProxy(), nullptr, nullptr, nullptr};
+  if (argcount > 1) {
+    args[1] = PyObjectFrom(collData->GetWorldPoint(0, first));
+  }
+  if (argcount > 2) {
+    args[2] = PyObjectFrom(collData->GetNormal(0, first));
+  }
+
+  KX_CollisionContactPointList contactPointList(collData, first);
+  CListWrapper *listWrapper = nullptr;
+  if (argcount > 3) {
+    listWrapper = contactPointList.GetListWrapper(GetScene()->GetFrameArena());
+    args[3] = listWrapper->GetProxy();
+  }
+
   RunPythonCallBackList(m_collisionCallbacks, args, 1, ARRAY_SIZE(args));
 
   for (unsigned int i = 0; i < ARRAY_SIZE(args); ++i) {
-    Py_DECREF(args[i]);
+    Py_XDECREF(args[i]);
   }
 
-  // Invalidate the collison contact point to avoid acces to it in next frame
-  listWrapper->InvalidateProxy();
-  delete listWrapper;
+  if (listWrapper) {
+    /* Invalidate the collison contact point to avoid acces to it in next frame,
+     * the wrapper is released with the frame arena. */
+    listWrapper->InvalidateProxy();
+  }
 #endif
 }
 
@@ -2011,6 +2181,64 @@ void KX_GameObject_Mathutils_Callback_Init(void)
 
 #ifdef WITH_PYTHON
 /* ------- python stuff ---------------------------------------------------*/
+
+PyObject *KX_GameObject::GetCachedMathObject(CachedMathObject type)
+{
+#  ifdef USE_MATHUTILS
+  PyObject *proxy = BGE_PROXY_FROM_REF_BORROW(this);
+  PyObject *&object = m_cachedMathObjects[type];
+
+  // The proxy changes when the object is mutated to a python subclass.
+  if (object && ((BaseMathObject *)object)->cb_user == proxy) {
+    Py_INCREF(object);
+    return object;
+  }
+
+  Py_XDECREF(object);
+  switch (type) {
+    case CACHED_MATH_POS_LOCAL:
+      object = Vector_CreatePyObject_cb(
+          proxy, 3, mathutils_kxgameob_vector_cb_index, MATHUTILS_VEC_CB_POS_LOCAL);
+      break;
+    case CACHED_MATH_POS_GLOBAL:
+      object = Vector_CreatePyObject_cb(
+          proxy, 3, mathutils_kxgameob_vector_cb_index, MATHUTILS_VEC_CB_POS_GLOBAL);
+      break;
+    case CACHED_MATH_ORI_LOCAL:
+      object = Matrix_CreatePyObject_cb(
+          proxy, 3, 3, mathutils_kxgameob_matrix_cb_index, MATHUTILS_MAT_CB_ORI_LOCAL);
+      break;
+    case CACHED_MATH_ORI_GLOBAL:
+      object = Matrix_CreatePyObject_cb(
+          proxy, 3, 3, mathutils_kxgameob_matrix_cb_index, MATHUTILS_MAT_CB_ORI_GLOBAL);
+      break;
+    case CACHED_MATH_SCALE_LOCAL:
+      object = Vector_CreatePyObject_cb(
+          proxy, 3, mathutils_kxgameob_vector_cb_index, MATHUTILS_VEC_CB_SCALE_LOCAL);
+      break;
+    case CACHED_MATH_SCALE_GLOBAL:
+      object = Vector_CreatePyObject_cb(
+          proxy, 3, mathutils_kxgameob_vector_cb_index, MATHUTILS_VEC_CB_SCALE_GLOBAL);
+      break;
+    case CACHED_MATH_MAX:
+      object = nullptr;
+      break;
+  }
+
+  Py_XINCREF(object);
+  return object;
+#  else
+  return nullptr;
+#  endif
+}
+
+void KX_GameObject::ClearCachedMathObjects()
+{
+  for (PyObject *&object : m_cachedMathObjects) {
+    Py_CLEAR(object);
+  }
+}
+
 PyMethodDef KX_GameObject::Methods[] = {
     {"applyForce", (PyCFunction)KX_GameObject::sPyApplyForce, METH_VARARGS},
     {"applyTorque", (PyCFunction)KX_GameObject::sPyApplyTorque, METH_VARARGS},
@@ -2908,10 +3136,7 @@ PyObject *KX_GameObject::pyattr_get_worldPosition(PyObjectPlus *self_v,
                                                   const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_POS_GLOBAL);
+  return static_cast<KX_GameObject *>(self_v)->GetCachedMathObject(CACHED_MATH_POS_GLOBAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetWorldPosition());
@@ -2936,10 +3161,7 @@ PyObject *KX_GameObject::pyattr_get_localPosition(PyObjectPlus *self_v,
                                                   const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_POS_LOCAL);
+  return static_cast<KX_GameObject *>(self_v)->GetCachedMathObject(CACHED_MATH_POS_LOCAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetLocalPosition());
@@ -2980,11 +3202,7 @@ PyObject *KX_GameObject::pyattr_get_worldOrientation(PyObjectPlus *self_v,
                                                      const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Matrix_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  3,
-                                  mathutils_kxgameob_matrix_cb_index,
-                                  MATHUTILS_MAT_CB_ORI_GLOBAL);
+  return static_cast<KX_GameObject *>(self_v)->GetCachedMathObject(CACHED_MATH_ORI_GLOBAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetWorldOrientation());
@@ -3012,11 +3230,7 @@ PyObject *KX_GameObject::pyattr_get_localOrientation(PyObjectPlus *self_v,
                                                      const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Matrix_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  3,
-                                  mathutils_kxgameob_matrix_cb_index,
-                                  MATHUTILS_MAT_CB_ORI_LOCAL);
+  return static_cast<KX_GameObject *>(self_v)->GetCachedMathObject(CACHED_MATH_ORI_LOCAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetLocalOrientation());
@@ -3043,10 +3257,7 @@ PyObject *KX_GameObject::pyattr_get_worldScaling(PyObjectPlus *self_v,
                                                  const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_SCALE_GLOBAL);
+  return static_cast<KX_GameObject *>(self_v)->GetCachedMathObject(CACHED_MATH_SCALE_GLOBAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetWorldScaling());
@@ -3071,10 +3282,7 @@ PyObject *KX_GameObject::pyattr_get_localScaling(PyObjectPlus *self_v,
                                                  const KX_PYATTRIBUTE_DEF *attrdef)
 {
 #  ifdef USE_MATHUTILS
-  return Vector_CreatePyObject_cb(BGE_PROXY_FROM_REF_BORROW(self_v),
-                                  3,
-                                  mathutils_kxgameob_vector_cb_index,
-                                  MATHUTILS_VEC_CB_SCALE_LOCAL);
+  return static_cast<KX_GameObject *>(self_v)->GetCachedMathObject(CACHED_MATH_SCALE_LOCAL);
 #  else
   KX_GameObject *self = static_cast<KX_GameObject *>(self_v);
   return PyObjectFrom(self->NodeGetLocalScaling());
@@ -55,14 +55,17 @@
 struct KX_ClientObjectInfo;
 class KX_RayCast;
 class KX_LodManager;
+class BL_SkinDeformer;
 class KX_PythonComponent;
 class RAS_MeshObject;
 class PHY_IPhysicsEnvironment;
 class PHY_IPhysicsController;
+class PHY_IGraphicController;
 class BL_ActionManager;
 struct Object;
 class KX_ObstacleSimulation;
 class KX_CollisionContactPointList;
+class PHY_CollData;
 struct bAction;
 
 
@@ -89,6 +92,8 @@ protected:
 	float m_prevObmat[4][4];
 	bool m_castShadows;
 	bool m_isReplica;
+	/// Memory used by the replicated Blender object, accounted in CM_MEMORY_REPLICA_ID.
+	size_t m_replicaMemorySize;
 	bool m_staticObject;
   bool m_useCopy;
   bool m_visibleAtGameStart;
@@ -102,6 +107,8 @@ protected:
 	std::vector<RAS_MeshObject*>		m_meshes;
 	KX_LodManager						*m_lodManager;
 	short								m_currentLodLevel;
+	/// Deformer of the mesh by the parent armature, nullptr if the depsgraph deforms the mesh.
+	BL_SkinDeformer						*m_skinDeformer;
 	struct Object*						m_pBlenderObject;
 	struct Object*						m_pBlenderGroupObject;
 	
@@ -115,9 +122,13 @@ protected:
 	// visible = user setting
 	// culled = while rendering, depending on camera
 	bool       							m_bVisible; 
+	bool								m_bCulled; 
 	bool								m_bOccluder;
 
 	PHY_IPhysicsController*				m_pPhysicsController;
+	PHY_IGraphicController*				m_pGraphicController;
+	/// The culling tree update of a transform changed during the parallel actuator update is pending.
+	bool								m_graphicTransformPending;
 	SG_Node*							m_pSGNode;
 
 #ifdef WITH_PYTHON
@@ -184,6 +195,26 @@ public:
 	//
 	PyObject*							m_attr_dict;
 	PyObject*							m_collisionCallbacks;
+
+	/// Transform attributes with a cached mathutils object.
+	enum CachedMathObject {
+		CACHED_MATH_POS_LOCAL = 0,
+		CACHED_MATH_POS_GLOBAL,
+		CACHED_MATH_ORI_LOCAL,
+		CACHED_MATH_ORI_GLOBAL,
+		CACHED_MATH_SCALE_LOCAL,
+		CACHED_MATH_SCALE_GLOBAL,
+		CACHED_MATH_MAX
+	};
+
+	/** Mathutils objects returned by the transform attributes, they read and write
+	 * the transform with callbacks and are shared by all the attribute accesses.
+	 */
+	PyObject*							m_cachedMathObjects[CACHED_MATH_MAX];
+
+	/// Return a new reference to the cached mathutils object of a transform attribute.
+	PyObject *GetCachedMathObject(CachedMathObject type);
+	void ClearCachedMathObjects();
 #endif
 
 	virtual void	/* This function should be virtual - derived classed override it */
@@ -463,6 +494,24 @@ public:
 	{ 
 		m_pPhysicsController = physicscontroller;
 	}
+
+	/**
+	 * \return a pointer to the graphic controller owned by this class.
+	 */
+	PHY_IGraphicController* GetGraphicController()
+	{
+		return m_pGraphicController;
+	}
+
+	void SetGraphicController(PHY_IGraphicController* graphiccontroller)
+	{ 
+		m_pGraphicController = graphiccontroller;
+	}
+	/*
+	 * @add/remove the graphic controller to the physic system
+	 */
+	void ActivateGraphicController(bool recurse);
+
 	/// Return true when the game object is a .
 	virtual bool IsDeformable() const
 	{
@@ -511,6 +560,8 @@ public:
 	const MT_Vector3& NodeGetWorldScaling(  ) const;
 	const MT_Vector3& NodeGetWorldPosition(  ) const;
 	MT_Transform NodeGetWorldTransform() const;
+	/// World transform of the rendered frame, interpolated between the last two logic frames if enabled.
+	MT_Transform NodeGetRenderTransform() const;
 
 	const MT_Matrix3x3& NodeGetLocalOrientation(  ) const;
 	const MT_Vector3& NodeGetLocalScaling(  ) const;
@@ -575,6 +626,9 @@ public:
 	/// Is it a dynamic/physics object ?
 	bool IsDynamic() const;
 
+	virtual bool IsIsolated() const;
+	virtual void EndParallelUpdate();
+
 	bool IsDynamicsSuspended() const;
 
 	/**
@@ -725,6 +779,10 @@ public:
 	/// Get current lod manager.
 	KX_LodManager *GetLodManager() const;
 
+	/// Set the armature deformer of the mesh, the object takes the ownership of the deformer.
+	void SetSkinDeformer(BL_SkinDeformer *deformer);
+	BL_SkinDeformer *GetSkinDeformer() const;
+
 	/**
 	 * Updates the current lod level based on distance from camera.
 	 */
@@ -753,6 +811,22 @@ public:
 	/// Return true when the object can be culled.
 	bool UseCulling() const;
 
+	/**
+	 * Was this object culled by the camera being rendered?
+	 */
+	inline bool
+	GetCulled(
+		void
+	) { return m_bCulled; }
+
+	/**
+	 * Set culled flag of this object, the draw manager skips culled objects.
+	 */
+	void
+	SetCulled(
+		bool c
+	);
+
 	/**
 	 * Was this object marked visible? (only for the explicit
 	 * visibility system).
@@ -819,7 +893,11 @@ public:
 
 	void RegisterCollisionCallbacks();
 	void UnregisterCollisionCallbacks();
-	void RunCollisionCallbacks(KX_GameObject *collider, KX_CollisionContactPointList& contactPointList);
+	/** Run the python collision callbacks.
+	 * \param collData The contact points, exposed to python only if a callback uses them.
+	 * \param first The object is the first of the collision pair.
+	 */
+	void RunCollisionCallbacks(KX_GameObject *collider, const PHY_CollData *collData, bool first);
 	/**
 	 * Stop making progress
 	 */
@@ -0,0 +1,361 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_GlobalDictStorage.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_GlobalDictStorage.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_utildefines.h"
+#include "BLI_fileops.h"
+#include "BLI_fileops_types.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
+
+extern "C" {
+#  include "BLI_hash_mm2a.h"
+}
+
+#include "CM_Message.h"
+
+#include <zlib.h>
+#include <set>
+#include <cstring>
+#include <cstdio>
+
+#ifdef WIN32
+#  include <windows.h>
+#  include "utfconv.h"
+#endif
+
+static const char *chunkExtension = ".chunk";
+
+static uint64_t hashData(const std::string& data)
+{
+	const unsigned char *bytes = (const unsigned char *)data.data();
+	return ((uint64_t)BLI_hash_mm2(bytes, data.size(), 0) << 32) | BLI_hash_mm2(bytes, data.size(), 0x9747b28c);
+}
+
+/// The chunk file name only depends on the item key.
+static std::string chunkName(const std::string& key)
+{
+	char name[17];
+	BLI_snprintf(name, sizeof(name), "%016llx", (unsigned long long)hashData(key));
+	return std::string(name) + chunkExtension;
+}
+
+/// Replace a file by another, the destination is always either the old or the new file.
+static bool replaceFile(const std::string& from, const std::string& to)
+{
+#ifdef WIN32
+	bool success;
+	UTF16_ENCODE(from);
+	UTF16_ENCODE(to);
+	success = MoveFileExW(from_16, to_16, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+	UTF16_UN_ENCODE(to);
+	UTF16_UN_ENCODE(from);
+	return success;
+#else
+	return (rename(from.c_str(), to.c_str()) == 0);
+#endif
+}
+
+static bool writeFile(const std::string& path, const std::string& data, bool compress)
+{
+	const std::string tmppath = path + ".tmp";
+
+	bool success;
+	if (compress) {
+		gzFile file = (gzFile)BLI_gzopen(tmppath.c_str(), "wb");
+		if (!file) {
+			CM_Error("could not open '" << tmppath << "'");
+			return false;
+		}
+		success = (gzwrite(file, data.data(), data.size()) == (int)data.size());
+		success = (gzclose(file) == Z_OK) && success;
+	}
+	else {
+		FILE *file = BLI_fopen(tmppath.c_str(), "wb");
+		if (!file) {
+			CM_Error("could not open '" << tmppath << "'");
+			return false;
+		}
+		success = (fwrite(data.data(), 1, data.size(), file) == data.size());
+		success = (fclose(file) == 0) && success;
+	}
+
+	if (!success) {
+		CM_Error("could not write '" << tmppath << "'");
+		BLI_delete(tmppath.c_str(), false, false);
+		return false;
+	}
+
+	if (!replaceFile(tmppath, path)) {
+		CM_Error("could not replace '" << path << "'");
+		BLI_delete(tmppath.c_str(), false, false);
+		return false;
+	}
+
+	return true;
+}
+
+/// Read a file compressed or not.
+static bool readFile(const std::string& path, std::string& data)
+{
+	if (!BLI_is_file(path.c_str())) {
+		return false;
+	}
+
+	int size;
+	char *buffer = BLI_file_ungzip_to_mem(path.c_str(), &size);
+	if (!buffer) {
+		data.clear();
+		return (size == 0);
+	}
+
+	data.assign(buffer, size);
+	MEM_freeN(buffer);
+
+	return true;
+}
+
+KX_GlobalDictStorage::KX_GlobalDictStorage()
+	:m_job(nullptr)
+{
+	m_pool = BLI_task_pool_create(BLI_task_scheduler_get(), this);
+}
+
+KX_GlobalDictStorage::~KX_GlobalDictStorage()
+{
+	Wait();
+	BLI_task_pool_free(m_pool);
+}
+
+void KX_GlobalDictStorage::Write(Job *job)
+{
+	bool success;
+	if (job->m_chunked) {
+		success = WriteChunks(job);
+	}
+	else {
+		success = writeFile(job->m_path, job->m_data, job->m_flags & COMPRESS);
+	}
+
+	// Remove the data of the other format, it would be ambiguous to load.
+	if (success && BLI_exists(job->m_otherPath.c_str())) {
+		const bool isdir = BLI_is_dir(job->m_otherPath.c_str());
+		BLI_delete(job->m_otherPath.c_str(), isdir, isdir);
+	}
+	if (!job->m_chunked) {
+		m_chunkHashes.clear();
+	}
+
+	m_jobMutex.Lock();
+	job->m_done = true;
+	m_jobMutex.Unlock();
+}
+
+bool KX_GlobalDictStorage::WriteChunks(Job *job)
+{
+	const std::string& dirpath = job->m_path;
+	if (!BLI_is_dir(dirpath.c_str()) && !BLI_dir_create_recursive(dirpath.c_str())) {
+		CM_Error("could not create directory '" << dirpath << "'");
+		return false;
+	}
+
+	bool success = true;
+	std::set<std::string> names;
+	for (const Entry& entry : job->m_entries) {
+		const std::string name = chunkName(entry.m_key);
+		names.insert(name);
+
+		// The chunk contains the key size, the key and the value.
+		std::string data;
+		const uint32_t keysize = entry.m_key.size();
+		data.reserve(sizeof(keysize) + entry.m_key.size() + entry.m_value.size());
+		data.append((const char *)&keysize, sizeof(keysize));
+		data.append(entry.m_key);
+		data.append(entry.m_value);
+
+		const uint64_t hash = hashData(data);
+		const std::string path = dirpath + SEP_STR + name;
+		std::map<std::string, uint64_t>::const_iterator it = m_chunkHashes.find(name);
+		if (it != m_chunkHashes.end() && it->second == hash && BLI_is_file(path.c_str())) {
+			continue;
+		}
+
+		if (writeFile(path, data, job->m_flags & COMPRESS)) {
+			m_chunkHashes[name] = hash;
+		}
+		else {
+			m_chunkHashes.erase(name);
+			success = false;
+		}
+	}
+
+	// Delete the chunks of the removed items.
+	struct direntry *files;
+	const unsigned int numfiles = BLI_filelist_dir_contents(dirpath.c_str(), &files);
+	for (unsigned int i = 0; i < numfiles; ++i) {
+		const struct direntry& file = files[i];
+		if (BLI_path_extension_check(file.relname, chunkExtension) && names.find(file.relname) == names.end()) {
+			BLI_delete(file.path, false, false);
+			m_chunkHashes.erase(file.relname);
+		}
+	}
+	BLI_filelist_free(files, numfiles);
+
+	return success;
+}
+
+void KX_GlobalDictStorage::WriteTask(TaskPool *UNUSED(pool), void *taskdata, int UNUSED(threadid))
+{
+	Job *job = static_cast<Job *>(taskdata);
+	job->m_storage->Write(job);
+}
+
+void KX_GlobalDictStorage::Push(Job *job)
+{
+	// Only one write at a time, the files of the previous write could be overwritten in any order.
+	Wait();
+
+	job->m_storage = this;
+	job->m_done = false;
+
+	if (job->m_flags & SYNCHRONOUS) {
+		Write(job);
+		delete job;
+		return;
+	}
+
+	m_job = job;
+	BLI_task_pool_push(m_pool, WriteTask, job, false, TASK_PRIORITY_LOW);
+}
+
+void KX_GlobalDictStorage::Save(const std::string& path, const std::string& chunkPath, std::string&& data, int flags)
+{
+	Job *job = new Job();
+	job->m_flags = flags;
+	job->m_path = path;
+	job->m_otherPath = chunkPath;
+	job->m_data = std::move(data);
+	job->m_chunked = false;
+
+	Push(job);
+}
+
+void KX_GlobalDictStorage::SaveChunks(const std::string& chunkPath, const std::string& path,
+									  std::vector<Entry>&& entries, int flags)
+{
+	Job *job = new Job();
+	job->m_flags = flags;
+	job->m_path = chunkPath;
+	job->m_otherPath = path;
+	job->m_entries = std::move(entries);
+	job->m_chunked = true;
+
+	Push(job);
+}
+
+bool KX_GlobalDictStorage::Load(const std::string& path, std::string& data)
+{
+	Wait();
+
+	return readFile(path, data);
+}
+
+bool KX_GlobalDictStorage::LoadChunks(const std::string& chunkPath, std::vector<Entry>& entries)
+{
+	Wait();
+
+	if (!BLI_is_dir(chunkPath.c_str())) {
+		return false;
+	}
+
+	m_chunkHashes.clear();
+
+	bool success = true;
+	struct direntry *files;
+	const unsigned int numfiles = BLI_filelist_dir_contents(chunkPath.c_str(), &files);
+	for (unsigned int i = 0; i < numfiles; ++i) {
+		const struct direntry& file = files[i];
+		if (!BLI_path_extension_check(file.relname, chunkExtension)) {
+			continue;
+		}
+
+		std::string data;
+		uint32_t keysize;
+		if (!readFile(file.path, data) || data.size() < sizeof(keysize)) {
+			CM_Error("could not read '" << file.path << "'");
+			success = false;
+			continue;
+		}
+
+		memcpy(&keysize, data.data(), sizeof(keysize));
+		if (data.size() < sizeof(keysize) + keysize) {
+			CM_Error("invalid chunk '" << file.path << "'");
+			success = false;
+			continue;
+		}
+
+		Entry entry;
+		entry.m_key = data.substr(sizeof(keysize), keysize);
+		entry.m_value = data.substr(sizeof(keysize) + keysize);
+		entries.push_back(entry);
+
+		// The chunks just read don't need to be written again if they don't change.
+		m_chunkHashes[file.relname] = hashData(data);
+	}
+	BLI_filelist_free(files, numfiles);
+
+	return success;
+}
+
+void KX_GlobalDictStorage::Wait()
+{
+	if (!m_job) {
+		return;
+	}
+
+	BLI_task_pool_work_and_wait(m_pool);
+
+	delete m_job;
+	m_job = nullptr;
+}
+
+bool KX_GlobalDictStorage::IsWriting() const
+{
+	if (!m_job) {
+		return false;
+	}
+
+	m_jobMutex.Lock();
+	const bool done = m_job->m_done;
+	m_jobMutex.Unlock();
+
+	return !done;
+}
@@ -0,0 +1,114 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_GlobalDictStorage.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_GLOBAL_DICT_STORAGE_H__
+#define __KX_GLOBAL_DICT_STORAGE_H__
+
+#include "CM_Thread.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+struct TaskPool;
+
+/** Write and read the serialized globalDict.
+ * The data is serialized by the caller, this class only deals with
+ * compression and files so that the writing can be done in background.
+ * Files are written in a temporary file and renamed to never leave a
+ * partially written file.
+ */
+class KX_GlobalDictStorage
+{
+public:
+	enum Flag {
+		FLAG_NONE = 0,
+		/// Write the files compressed with gzip.
+		COMPRESS = (1 << 0),
+		/// Write the file in the calling thread.
+		SYNCHRONOUS = (1 << 1)
+	};
+
+	/// One serialized top level item of the dictionary.
+	struct Entry
+	{
+		std::string m_key;
+		std::string m_value;
+	};
+
+private:
+	/// Data of the pending write, owned by the storage.
+	struct Job
+	{
+		KX_GlobalDictStorage *m_storage;
+		int m_flags;
+		/// Single file path or chunk directory.
+		std::string m_path;
+		/// The file or directory of the other format, removed once the write succeeded.
+		std::string m_otherPath;
+		/// Whole dictionary for single file write.
+		std::string m_data;
+		/// Items for chunked write.
+		std::vector<Entry> m_entries;
+		bool m_chunked;
+		bool m_done;
+	};
+
+	TaskPool *m_pool;
+	Job *m_job;
+	mutable CM_ThreadMutex m_jobMutex;
+	/// Value hash of the chunks written or read per chunk file name, only used by the job.
+	std::map<std::string, uint64_t> m_chunkHashes;
+
+	static void WriteTask(TaskPool *pool, void *taskdata, int threadid);
+	void Write(Job *job);
+	bool WriteChunks(Job *job);
+	void Push(Job *job);
+
+public:
+	KX_GlobalDictStorage();
+	/// Wait for the pending write.
+	~KX_GlobalDictStorage();
+
+	/// Write the whole serialized dictionary in one file and remove the chunk directory.
+	void Save(const std::string& path, const std::string& chunkPath, std::string&& data, int flags);
+	/** Write the items in a directory using one file per item, only the items changed since the last
+	 * write are written and the files of removed items are deleted. The single file is removed.
+	 */
+	void SaveChunks(const std::string& chunkPath, const std::string& path, std::vector<Entry>&& entries, int flags);
+
+	/// Read a file written by Save, compressed or not.
+	bool Load(const std::string& path, std::string& data);
+	/// Read all the items written by SaveChunks.
+	bool LoadChunks(const std::string& chunkPath, std::vector<Entry>& entries);
+
+	/// Wait for the pending write.
+	void Wait();
+	bool IsWriting() const;
+};
+
+#endif  // __KX_GLOBAL_DICT_STORAGE_H__
@@ -85,11 +85,18 @@ const std::string& KX_GetOrigPath()
 
 void KX_RasterizerDrawDebugLine(const MT_Vector3& from,const MT_Vector3& to,const MT_Vector4& color)
 {
+	// Debug drawing needs a GPU context.
+	if (g_engine->GetFlag(KX_KetsjiEngine::HEADLESS)) {
+		return;
+	}
 	g_engine->GetRasterizer()->GetDebugDraw(g_scene).DrawLine(from, to, color);
 }
 
 void KX_RasterizerDrawDebugCircle(const MT_Vector3& center, const MT_Scalar radius, const MT_Vector4& color,
                                   const MT_Vector3& normal, int nsector)
 {
+	if (g_engine->GetFlag(KX_KetsjiEngine::HEADLESS)) {
+		return;
+	}
 	g_engine->GetRasterizer()->GetDebugDraw(g_scene).DrawCircle(center, radius, color, normal, nsector);
 }
@@ -35,10 +35,12 @@
 #endif
 
 #include "CM_Message.h"
+#include "CM_Memory.h"
 
 #include <boost/format.hpp>
 
 #include "BLI_task.h"
+#include "MEM_guardedalloc.h"
 
 #include "KX_KetsjiEngine.h"
 
@@ -54,15 +56,19 @@
 #include "MT_Vector3.h"
 #include "MT_Transform.h"
 #include "SCA_IInputDevice.h"
+#include "KX_Benchmark.h"
 #include "KX_Camera.h"
 #include "KX_Light.h"
 #include "KX_Globals.h"
 #include "KX_PyConstraintBinding.h"
+#include "KX_SoundManager.h"
 #include "PHY_IPhysicsEnvironment.h"
 
 #include "KX_NetworkMessageScene.h"
 
 #include "DEV_Joystick.h" // for DEV_Joystick::HandleEvents
+#include "DEV_InputRecorder.h"
+#include "DEV_InputReplay.h"
 #include "KX_PythonInit.h" // for updatePythonJoysticks
 
 #include "KX_BlenderConverter.h"
@@ -137,6 +143,19 @@ const std::string KX_KetsjiEngine::m_profileLabels[tc_numCategories] = {
 	"GPU Latency:" // tc_latency
 };
 
+const std::string KX_KetsjiEngine::m_benchmarkLabels[tc_numCategories] = {
+	"physics", // tc_physics
+	"logic", // tc_logic
+	"animations", // tc_animations
+	"network", // tc_network
+	"scenegraph", // tc_scenegraph
+	"rasterizer", // tc_rasterizer
+	"services", // tc_services
+	"overhead", // tc_overhead
+	"outside", // tc_outside
+	"latency" // tc_latency
+};
+
 /**
  * Constructor of the Ketsji Engine
  */
@@ -146,11 +165,16 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system, bContext *C)
 	m_rasterizer(nullptr),
 	m_kxsystem(system),
 	m_converter(nullptr),
+	m_soundManager(new KX_SoundManager()),
 	m_inputDevice(nullptr),
+	m_inputRecorder(nullptr),
+	m_inputReplay(nullptr),
 	m_bInitialized(false),
 	m_flags(AUTO_ADD_DEBUG_PROPERTIES),
 	m_frameTime(0.0f),
 	m_clockTime(0.0f),
+	m_interpolationFactor(1.0),
+	m_logicMemoryBlocks(0),
 	m_previousAnimTime(0.0f),
 	m_timescale(1.0f),
 	m_previousRealTime(0.0f),
@@ -166,6 +190,7 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system, bContext *C)
 	m_overrideCamZoom(1.0f),
 	m_logger(KX_TimeCategoryLogger(25)),
 	m_average_framerate(0.0),
+	m_benchmark(nullptr),
 	m_showBoundingBox(KX_DebugOption::DISABLE),
 	m_showArmature(KX_DebugOption::DISABLE),
 	m_showCameraFrustum(KX_DebugOption::DISABLE),
@@ -182,6 +207,9 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system, bContext *C)
 	m_taskscheduler = BLI_task_scheduler_create(1);
 
 	m_scenes = new CListValue<KX_Scene>();
+
+	// The memory peaks are measured for each game run.
+	CM_MemoryReset();
 }
 
 /**
@@ -196,7 +224,14 @@ KX_KetsjiEngine::~KX_KetsjiEngine()
 	if (m_taskscheduler)
 		BLI_task_scheduler_free(m_taskscheduler);
 
+	if (m_benchmark) {
+		delete m_benchmark;
+	}
+
 	m_scenes->Release();
+
+	// The sound actuators are removed with the scenes.
+	delete m_soundManager;
 }
 
 bContext *KX_KetsjiEngine::GetContext()
@@ -210,6 +245,16 @@ void KX_KetsjiEngine::SetInputDevice(SCA_IInputDevice *inputDevice)
 	m_inputDevice = inputDevice;
 }
 
+void KX_KetsjiEngine::SetInputRecorder(DEV_InputRecorder *recorder)
+{
+	m_inputRecorder = recorder;
+}
+
+void KX_KetsjiEngine::SetInputReplay(DEV_InputReplay *replay)
+{
+	m_inputReplay = replay;
+}
+
 void KX_KetsjiEngine::SetCanvas(RAS_ICanvas *canvas)
 {
 	BLI_assert(canvas);
@@ -235,6 +280,32 @@ PyObject *KX_KetsjiEngine::GetPyProfileDict()
 }
 #endif
 
+void KX_KetsjiEngine::StartBenchmark()
+{
+	if (!m_benchmark) {
+		m_benchmark = new KX_Benchmark(std::vector<std::string>(m_benchmarkLabels, m_benchmarkLabels + tc_numCategories));
+	}
+	m_benchmark->Start();
+}
+
+KX_Benchmark *KX_KetsjiEngine::GetBenchmark() const
+{
+	return m_benchmark;
+}
+
+void KX_KetsjiEngine::NextMeasurement()
+{
+	m_logger.NextMeasurement(m_kxsystem->GetTimeInSeconds());
+
+	if (m_benchmark) {
+		std::vector<double> times(tc_numCategories);
+		for (int i = tc_first; i < tc_numCategories; ++i) {
+			times[i] = m_logger.GetLastMeasurement((KX_TimeCategory)i);
+		}
+		m_benchmark->AddFrame(times);
+	}
+}
+
 void KX_KetsjiEngine::SetConverter(KX_BlenderConverter *converter)
 {
 	BLI_assert(converter);
@@ -283,7 +354,7 @@ void KX_KetsjiEngine::EndFrame()
 	m_average_framerate = 1.0 / tottime;
 
 	// Go to next profiling measurement, time spent after this call is shown in the next frame.
-	m_logger.NextMeasurement(m_kxsystem->GetTimeInSeconds());
+	NextMeasurement();
 
 	m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
 	m_rasterizer->EndFrame();
@@ -365,7 +436,11 @@ bool KX_KetsjiEngine::NextFrame()
 		frames = m_maxPhysicsFrame;
 	}
 
-	bool doRender = frames > 0; 
+	/* With transform interpolation the logic can run slower than the display,
+	 * every call renders the last two logic frames blended. */
+	const bool interpolate = (m_flags & FIXED_FRAMERATE) && (m_flags & INTERPOLATE_TRANSFORMS);
+
+	bool doRender = frames > 0 || interpolate;
 
 	if (frames > m_maxLogicFrame) {
 		framestep = (frames * timestep) / m_maxLogicFrame;
@@ -390,6 +465,17 @@ bool KX_KetsjiEngine::NextFrame()
 		}
 #endif  // WITH_SDL
 
+		/* The inputs are recorded or replayed once all the events of the frame
+		 * are received, exactly as the logic will see them. */
+		if (m_inputReplay) {
+			m_inputReplay->NextFrame();
+		}
+		else if (m_inputRecorder) {
+			m_inputRecorder->RecordFrame(m_inputDevice);
+		}
+
+		m_logicMemoryBlocks = 0;
+
 		// for each scene, call the proceed functions
 		for (KX_Scene *scene : m_scenes) {
 			/* Suspension holds the physics and logic processing for an
@@ -398,6 +484,12 @@ bool KX_KetsjiEngine::NextFrame()
 			 * update. */
 			m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
 
+			if (interpolate) {
+				m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
+				scene->SavePreviousTransforms();
+				m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
+			}
+
 			scene->UpdateObjectActivity();
 
 			if (!scene->IsSuspended()) {
@@ -412,6 +504,7 @@ bool KX_KetsjiEngine::NextFrame()
 
 				// Process sensors, and controllers
 				m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
+				const unsigned int memoryBlocks = MEM_get_memory_blocks_in_use();
 				scene->LogicBeginFrame(m_frameTime, framestep);
 
 				// Scenegraph needs to be updated again, because Logic Controllers
@@ -426,6 +519,7 @@ bool KX_KetsjiEngine::NextFrame()
 				scene->LogicUpdateFrame(m_frameTime);
 
 				scene->LogicEndFrame();
+				m_logicMemoryBlocks += (int)(MEM_get_memory_blocks_in_use() - memoryBlocks);
 
 				// Actuators can affect the scenegraph
 				m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
@@ -457,16 +551,38 @@ bool KX_KetsjiEngine::NextFrame()
 		}
 
 		UpdateSuspendedScenes(framestep);
+
+		// Release the temporaries allocated by the logic during this frame.
+		for (KX_Scene *scene : m_scenes) {
+			scene->GetFrameArena().Reset();
+		}
+
+		// Choose the mixed voices once all the actuators started or stopped their sounds.
+		m_soundManager->Update(framestep);
+
 		// scene management
 		ProcessScheduledScenes();
 
 		frames--;
 	}
 
+	if (interpolate) {
+		// The remaining time before the next logic frame gives the position between the last two logic frames.
+		m_interpolationFactor = std::min(std::max((m_clockTime - m_frameTime) / timestep, 0.0), 1.0);
+	}
+	else {
+		m_interpolationFactor = 1.0;
+	}
+
+	// Nothing is rendered in headless mode, the measurement is done for each logic update.
+	if ((m_flags & HEADLESS) && doRender) {
+		NextMeasurement();
+	}
+
 	// Start logging time spent outside main loop
 	m_logger.StartLog(tc_outside, m_kxsystem->GetTimeInSeconds());
 
-	return doRender && m_doRender;
+	return doRender && m_doRender && !(m_flags & HEADLESS);
 }
 
 void KX_KetsjiEngine::UpdateSuspendedScenes(double framestep)
@@ -484,14 +600,19 @@ KX_KetsjiEngine::CameraRenderData KX_KetsjiEngine::GetCameraRenderData(KX_Scene
 	KX_Camera *rendercam;
 	/* In case of stereo we must copy the camera because it is used twice with different settings
 	 * (modelview matrix). This copy use the same transform settings that the original camera
-	 * and its name is based on with the eye number in addition.
+	 * and its name is based on with the eye number in addition. The copy has no previous transform,
+	 * so it receives the interpolated transform of the original camera for both eyes.
 	 */
 	if (usestereo) {
+		MT_Vector3 position, scaling;
+		MT_Matrix3x3 rotation;
+		camera->GetSGNode()->GetInterpolatedWorldTransform(m_interpolationFactor, position, rotation, scaling);
+
 		rendercam = new KX_Camera(scene, scene->m_callbacks, *camera->GetCameraData(), true, true);
 		rendercam->SetName("__stereo_" + camera->GetName() + "_" + std::to_string(eye) + "__");
-		rendercam->NodeSetGlobalOrientation(camera->NodeGetWorldOrientation());
-		rendercam->NodeSetWorldPosition(camera->NodeGetWorldPosition());
-		rendercam->NodeSetWorldScale(camera->NodeGetWorldScaling());
+		rendercam->NodeSetGlobalOrientation(rotation);
+		rendercam->NodeSetWorldPosition(position);
+		rendercam->NodeSetWorldScale(scaling);
 		rendercam->NodeUpdateGS(0.0);
 	}
 	// Else use the native camera.
@@ -511,7 +632,7 @@ KX_KetsjiEngine::CameraRenderData KX_KetsjiEngine::GetCameraRenderData(KX_Scene
 	// Compute the area and the viewport based on the current display area and the optional camera viewport.
 	GetSceneViewport(scene, rendercam, displayArea, area, viewport);
 	// Compute the camera matrices: modelview and projection.
-	const MT_Matrix4x4 viewmat = m_rasterizer->GetViewMatrix(eye, rendercam->GetWorldToCamera(), rendercam->GetCameraData()->m_perspective);
+	const MT_Matrix4x4 viewmat = m_rasterizer->GetViewMatrix(eye, rendercam->GetRenderWorldToCamera(), rendercam->GetCameraData()->m_perspective);
 	const MT_Matrix4x4 projmat = GetCameraProjectionMatrix(scene, rendercam, eye, viewport, area);
 	rendercam->SetModelviewMatrix(viewmat);
 	rendercam->SetProjectionMatrix(projmat);
@@ -979,7 +1100,9 @@ void KX_KetsjiEngine::StopEngine()
 		}
 
 		// cleanup all the stuff
-		m_rasterizer->Exit();
+		if (!(m_flags & HEADLESS)) {
+			m_rasterizer->Exit();
+		}
 	}
 }
 
@@ -1094,10 +1217,58 @@ void KX_KetsjiEngine::RenderDebugProperties()
 			debugDraw.RenderBox2D(MT_Vector2(xcoord + (int)(2.2 * profile_indent), ycoord), boxSize, white);
 			ycoord += const_ysize;
 		}
+
+		/* Frame arena usage of the last logic frame, the block allocations
+		 * are the heap allocations done by the arenas and should stay at zero.
+		 * The heap difference counts the guarded allocator blocks still in use
+		 * after the logic of the scenes, it only covers MEM_mallocN allocations. */
+		unsigned int numAllocations = 0;
+		size_t allocatedSize = 0;
+		unsigned int numBlockAllocations = 0;
+		for (KX_Scene *scene : m_scenes) {
+			const KX_FrameArena& arena = scene->GetFrameArena();
+			numAllocations += arena.GetNumAllocations();
+			allocatedSize += arena.GetAllocatedSize();
+			numBlockAllocations += arena.GetNumBlockAllocations();
+		}
+
+		debugDraw.RenderText2D("Arena:", MT_Vector2(xcoord + const_xindent, ycoord), white);
+		debugtxt = (boost::format("%d allocs | %.1fKiB | %d blocks | heap %+d") % numAllocations % (allocatedSize / 1024.0f) %
+		            numBlockAllocations % m_logicMemoryBlocks).str();
+		debugDraw.RenderText2D(debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+		ycoord += const_ysize;
 	}
 	// Add the ymargin for titles below the other section of debug info
 	ycoord += title_y_top_margin;
 
+	// Memory display, current and peak memory per subsystem and per loaded library.
+	if (m_flags & SHOW_PROFILE) {
+		debugDraw.RenderText2D("Memory", MT_Vector2(xcoord + const_xindent + title_xmargin, ycoord), white);
+		ycoord += const_ysize;
+		ycoord += title_y_bottom_margin;
+
+		for (unsigned short i = 0; i < CM_MEMORY_CATEGORY_MAX; ++i) {
+			const CM_MemoryCategory category = (CM_MemoryCategory)i;
+			const CM_MemoryStats stats = CM_MemoryGetStats(category);
+			debugtxt = (boost::format("%s: %.2fMiB | peak %.2fMiB") % CM_MemoryGetName(category) %
+			            (stats.current / 1048576.0f) % (stats.peak / 1048576.0f)).str();
+			debugDraw.RenderText2D(debugtxt, MT_Vector2(xcoord + const_xindent, ycoord), white);
+			ycoord += const_ysize;
+		}
+
+		for (const std::pair<std::string, CM_MemoryStats>& pair : CM_MemoryGetLibraryStats()) {
+			// Only the file name of the library is displayed, indented below the library category.
+			const std::string::size_type pos = pair.first.find_last_of("/\\");
+			const std::string name = (pos == std::string::npos) ? pair.first : pair.first.substr(pos + 1);
+			debugtxt = (boost::format("%s: %.2fMiB | peak %.2fMiB") % name %
+			            (pair.second.current / 1048576.0f) % (pair.second.peak / 1048576.0f)).str();
+			debugDraw.RenderText2D(debugtxt, MT_Vector2(xcoord + 3 * const_xindent, ycoord), white);
+			ycoord += const_ysize;
+		}
+
+		ycoord += title_y_top_margin;
+	}
+
 	/* Property display */
 	if (m_flags & SHOW_DEBUG_PROPERTIES) {
 		// Title for debugging("Debug properties")
@@ -1423,6 +1594,11 @@ double KX_KetsjiEngine::GetFrameTime(void) const
 	return m_frameTime;
 }
 
+double KX_KetsjiEngine::GetInterpolationFactor() const
+{
+	return m_interpolationFactor;
+}
+
 double KX_KetsjiEngine::GetRealTime(void) const
 {
 	return m_kxsystem->GetTimeInSeconds();
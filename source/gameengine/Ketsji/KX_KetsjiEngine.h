@@ -46,7 +46,11 @@
 struct TaskScheduler;
 class KX_ISystem;
 class KX_BlenderConverter;
+class KX_Benchmark;
+class DEV_InputRecorder;
+class DEV_InputReplay;
 class KX_NetworkMessageManager;
+class KX_SoundManager;
 class RAS_ICanvas;
 class RAS_FrameBuffer;
 class SCA_IInputDevice;
@@ -99,7 +103,11 @@ public:
 		/// Automatic add debug properties to the debug list.
 		AUTO_ADD_DEBUG_PROPERTIES = (1 << 6),
 		/// Use override camera?
-		CAMERA_OVERRIDE = (1 << 7)
+		CAMERA_OVERRIDE = (1 << 7),
+		/// Render the object transforms interpolated between the last two logic frames (fixed framerate only).
+		INTERPOLATE_TRANSFORMS = (1 << 8),
+		/// Run without window nor GPU context, nothing is rendered (dedicated server).
+		HEADLESS = (1 << 9)
 	};
 
 private:
@@ -144,10 +152,16 @@ private:
 	KX_ISystem *m_kxsystem;
 	KX_BlenderConverter *m_converter;
 	KX_NetworkMessageManager *m_networkMessageManager;
+	/// Sounds shared by the sound actuators and voice budget.
+	KX_SoundManager *m_soundManager;
 #ifdef WITH_PYTHON
 	PyObject *m_pyprofiledict;
 #endif
 	SCA_IInputDevice *m_inputDevice;
+	/// Optional recorder of the inputs seen by every logic frame.
+	DEV_InputRecorder *m_inputRecorder;
+	/// Optional replay of recorded inputs, also used as input device.
+	DEV_InputReplay *m_inputReplay;
 
 	/// Lists of scenes scheduled to be removed at the end of the frame.
 	std::vector<std::string> m_removingScenes;
@@ -169,6 +183,10 @@ private:
 	double m_frameTime;
 	/// game time for the next rendering step
 	double m_clockTime;
+	/// Blend factor between the previous and current logic frame transforms for rendering.
+	double m_interpolationFactor;
+	/// Difference of guarded allocator blocks in use over the logic of the scenes in the last logic frame.
+	int m_logicMemoryBlocks;
 	///game time when the animations were last updated
 	double m_previousAnimTime;
 	double m_remainingTime;
@@ -222,8 +240,12 @@ private:
 
 	/// Labels for profiling display.
 	static const std::string m_profileLabels[tc_numCategories];
+	/// Names of the categories in the benchmark output.
+	static const std::string m_benchmarkLabels[tc_numCategories];
 	/// Last estimated framerate
 	double m_average_framerate;
+	/// Statistics recorded for each profiling measurement, nullptr when not benchmarking.
+	KX_Benchmark *m_benchmark;
 
 	/// Enable debug draw of culling bounding boxes.
 	KX_DebugOption m_showBoundingBox;
@@ -285,7 +307,8 @@ private:
 	void PostProcessScene(KX_Scene *scene);
 
 	void BeginFrame();
-	
+	/// Start the next profiling measurement and record the last one for the benchmark.
+	void NextMeasurement();
 
 public:
 	KX_KetsjiEngine(KX_ISystem *system, struct bContext *C);
@@ -299,12 +322,17 @@ public:
 
 	/// set the devices and stuff. the client must take care of creating these
 	void SetInputDevice(SCA_IInputDevice *inputDevice);
+	void SetInputRecorder(DEV_InputRecorder *recorder);
+	void SetInputReplay(DEV_InputReplay *replay);
 	void SetCanvas(RAS_ICanvas *canvas);
 	void SetRasterizer(RAS_Rasterizer *rasterizer);
 	void SetNetworkMessageManager(KX_NetworkMessageManager *manager);
 #ifdef WITH_PYTHON
 	PyObject *GetPyProfileDict();
 #endif
+	/// Start recording the time and memory statistics of every frame, restart if already recording.
+	void StartBenchmark();
+	KX_Benchmark *GetBenchmark() const;
 	void SetConverter(KX_BlenderConverter *converter);
 	KX_BlenderConverter *GetConverter()
 	{
@@ -327,6 +355,10 @@ public:
 	{
 		return m_networkMessageManager;
 	}
+	KX_SoundManager *GetSoundManager() const
+	{
+		return m_soundManager;
+	}
 
 	TaskScheduler *GetTaskScheduler()
 	{
@@ -389,6 +421,12 @@ public:
 	 */
 	double GetFrameTime(void) const;
 
+	/**
+	 * Returns the factor used to blend the previous and current logic frame transforms
+	 * when rendering, 1 if the transform interpolation is disabled.
+	 */
+	double GetInterpolationFactor() const;
+
 	/**
 	 * Returns the real (system) time
 	 */
@@ -37,6 +37,7 @@
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
+#include "DNA_scene_types.h"
 
 extern "C" {
 #include "BKE_global.h"
@@ -52,6 +53,7 @@ extern "C" {
 
 #include "KX_BlenderConverter.h"
 #include "KX_Globals.h"
+#include "KX_Scene.h"
 #include "KX_PyMath.h"
 #include "EXP_Value.h"
 #include "Recast.h"
@@ -61,6 +63,8 @@ extern "C" {
 #include "CM_Message.h"
 
 #define MAX_PATH_LEN 256
+/// Number of polygon corridors kept for the path queries.
+#define PATH_CACHE_SIZE 64
 static const float polyPickExt[3] = {2, 4, 2};
 
 static void calcMeshBounds(const float* vert, int nverts, float* bmin, float* bmax)
@@ -544,14 +548,21 @@ static int polyFindVertex(const unsigned short *p, const int vertsPerPoly, unsig
 KX_NavMeshObject::KX_NavMeshObject(void* sgReplicationInfo, SG_Callbacks callbacks)
 :	KX_GameObject(sgReplicationInfo, callbacks)
 ,	m_navMesh(nullptr)
+,	m_tileCache(nullptr)
+,	m_pathQueue(nullptr)
 {
 	
 }
 
 KX_NavMeshObject::~KX_NavMeshObject()
 {
+	// Stop the queries before freeing the navigation mesh they use.
+	if (m_pathQueue)
+		delete m_pathQueue;
 	if (m_navMesh)
 		delete m_navMesh;
+	if (m_tileCache)
+		delete m_tileCache;
 }
 
 CValue* KX_NavMeshObject::GetReplica()
@@ -565,6 +576,8 @@ void KX_NavMeshObject::ProcessReplica()
 {
 	KX_GameObject::ProcessReplica();
 	m_navMesh = nullptr;  /* without this, building frees the navmesh we copied from */
+	m_tileCache = nullptr;
+	m_pathQueue = nullptr;
 	if (!BuildNavMesh()) {
 		CM_FunctionError("unable to build navigation mesh");
 		return;
@@ -755,6 +768,14 @@ bool KX_NavMeshObject::BuildVertIndArrays(float *&vertices, int& nverts,
 
 bool KX_NavMeshObject::BuildNavMesh()
 {
+	if (!m_pathQueue)
+	{
+		m_pathQueue = new KX_NavMeshPathQueue(PATH_CACHE_SIZE);
+		GetScene()->AddNavMesh(this);
+	}
+	// The queries are kept and solved again once the new navigation mesh is set.
+	m_pathQueue->SetNavMesh(nullptr);
+
 	if (m_navMesh)
 	{
 		delete m_navMesh;
@@ -767,6 +788,12 @@ bool KX_NavMeshObject::BuildNavMesh()
 		return false;
 	}
 
+	const short tileSize = GetScene()->GetBlenderScene()->gm.recastData.tilesize;
+	if (tileSize > 0)
+	{
+		return BuildTiledNavMesh(tileSize);
+	}
+
 	float *vertices = nullptr, *dvertices = nullptr;
 	unsigned short *polys = nullptr, *dtris = nullptr, *dmeshes = nullptr;
 	int nverts = 0, npolys = 0, ndvertsuniq = 0, ndtris = 0;
@@ -938,6 +965,7 @@ bool KX_NavMeshObject::BuildNavMesh()
 
 	m_navMesh = new dtStatNavMesh;
 	m_navMesh->init(data, dataSize, true);
+	m_pathQueue->SetNavMesh(m_navMesh);
 
 	delete [] vertices;
 
@@ -955,13 +983,210 @@ bool KX_NavMeshObject::BuildNavMesh()
 	return true;
 }
 
+bool KX_NavMeshObject::GetObjectGeometry(KX_GameObject *gameobj, KX_NavMeshTileCache::Geometry& geometry)
+{
+	if (gameobj->GetMeshCount() == 0)
+		return false;
+
+	RAS_MeshObject *meshobj = gameobj->GetMesh(0);
+
+	// Transform the vertices from the object space to the navigation mesh space.
+	MT_Transform trans = MT_Transform::Identity();
+	if (gameobj != this)
+	{
+		MT_Matrix3x3 orientation = gameobj->NodeGetWorldOrientation();
+		const MT_Vector3& scaling = gameobj->NodeGetWorldScaling();
+		orientation.scale(scaling[0], scaling[1], scaling[2]);
+		const MT_Transform objtr(gameobj->NodeGetWorldPosition(), orientation);
+
+		orientation = NodeGetWorldOrientation();
+		const MT_Vector3& navscaling = NodeGetWorldScaling();
+		orientation.scale(navscaling[0], navscaling[1], navscaling[2]);
+		MT_Transform invnavtr;
+		invnavtr.invert(MT_Transform(NodeGetWorldPosition(), orientation));
+
+		trans = invnavtr * objtr;
+	}
+
+	const unsigned int nverts = meshobj->m_sharedvertex_map.size();
+	geometry.m_verts.resize(nverts * 3);
+	for (unsigned int vi = 0; vi < nverts; ++vi)
+	{
+		float *vert = &geometry.m_verts[vi * 3];
+		if (meshobj->m_sharedvertex_map[vi].empty())
+		{
+			zero_v3(vert);
+			continue;
+		}
+		const MT_Vector3 pos = trans(MT_Vector3(meshobj->GetVertexLocation(vi)));
+		pos.getValue(vert);
+		flipAxes(vert);
+	}
+
+	/* Polygons are converted to fans of triangles, flipping the axes
+	 * changes the handedness so the winding is reversed too. */
+	geometry.m_tris.clear();
+	for (int p = 0, nmeshpolys = meshobj->NumPolygons(); p < nmeshpolys; ++p)
+	{
+		RAS_Polygon *raspoly = meshobj->GetPolygon(p);
+		for (int v = 0; v < raspoly->VertexCount() - 2; ++v)
+		{
+			geometry.m_tris.push_back(raspoly->GetVertexInfo(0).getOrigIndex());
+			geometry.m_tris.push_back(raspoly->GetVertexInfo(v + 2).getOrigIndex());
+			geometry.m_tris.push_back(raspoly->GetVertexInfo(v + 1).getOrigIndex());
+		}
+	}
+
+	return !geometry.m_tris.empty();
+}
+
+bool KX_NavMeshObject::BuildTiledNavMesh(int tileSize)
+{
+	if (!m_tileCache)
+	{
+		m_tileCache = new KX_NavMeshTileCache(GetScene()->GetBlenderScene()->gm.recastData, tileSize);
+	}
+
+	KX_NavMeshTileCache::Geometry geometry;
+	if (!GetObjectGeometry(this, geometry))
+	{
+		CM_Error("can't build navigation mesh data for object: " << m_name);
+		return false;
+	}
+
+	m_tileCache->SetGeometry(this, geometry);
+	m_tileCache->Build();
+
+	return true;
+}
+
 dtStatNavMesh* KX_NavMeshObject::GetNavMesh()
 {
 	return m_navMesh;
 }
 
+KX_NavMeshTileCache *KX_NavMeshObject::GetTileCache() const
+{
+	return m_tileCache;
+}
+
+void KX_NavMeshObject::FinishPathRequests()
+{
+	if (m_pathQueue)
+		m_pathQueue->FinishBatch();
+}
+
+void KX_NavMeshObject::UpdateNavigation()
+{
+	if (m_tileCache)
+		m_tileCache->Update();
+	if (m_pathQueue)
+		m_pathQueue->StartBatch();
+}
+
+bool KX_NavMeshObject::AddGeometry(KX_GameObject *gameobj)
+{
+	if (!m_tileCache)
+		return false;
+
+	KX_NavMeshTileCache::Geometry geometry;
+	if (!GetObjectGeometry(gameobj, geometry))
+		return false;
+
+	m_tileCache->SetGeometry(gameobj, geometry);
+	return true;
+}
+
+bool KX_NavMeshObject::RemoveGeometry(KX_GameObject *gameobj)
+{
+	if (!m_tileCache)
+		return false;
+
+	return m_tileCache->RemoveGeometry(gameobj);
+}
+
+int KX_NavMeshObject::AddObstacle(const MT_Vector3& pos, float radius, float height)
+{
+	if (!m_tileCache)
+		return -1;
+
+	// The obstacle is a vertical cylinder, scale its dimensions as the navigation mesh.
+	const MT_Vector3& scaling = NodeGetWorldScaling();
+	float lpos[3];
+	TransformToLocalCoords(pos).getValue(lpos);
+	flipAxes(lpos);
+
+	return m_tileCache->AddObstacle(lpos, radius / std::max(fabsf(scaling[0]), fabsf(scaling[1])),
+									height / fabsf(scaling[2]));
+}
+
+bool KX_NavMeshObject::RemoveObstacle(int id)
+{
+	if (!m_tileCache)
+		return false;
+
+	return m_tileCache->RemoveObstacle(id);
+}
+
+static void drawTiledNavMesh(KX_NavMeshObject *navmeshobj, const dtTiledNavMesh *navmesh,
+							 KX_NavMeshObject::NavMeshRenderMode renderMode)
+{
+	const MT_Vector4 color(0.0f, 0.0f, 0.0f, 1.0f);
+
+	for (int ti = 0; ti < DT_MAX_TILES; ++ti)
+	{
+		const dtTileHeader *header = navmesh->getTile(ti)->header;
+		if (!header)
+			continue;
+
+		for (int pi = 0; pi < header->npolys; ++pi)
+		{
+			const dtTilePoly *poly = &header->polys[pi];
+
+			if (renderMode == KX_NavMeshObject::RM_TRIS)
+			{
+				const dtTilePolyDetail *pd = &header->dmeshes[pi];
+				for (int j = 0; j < pd->ntris; ++j)
+				{
+					const unsigned char *t = &header->dtris[(pd->tbase + j) * 4];
+					MT_Vector3 tri[3];
+					for (int k = 0; k < 3; ++k)
+					{
+						const float *v;
+						if (t[k] < poly->nv)
+							v = &header->verts[poly->v[t[k]] * 3];
+						else
+							v = &header->dverts[(pd->vbase + t[k] - poly->nv) * 3];
+						tri[k] = navmeshobj->TransformToWorldCoords(MT_Vector3(v[0], v[2], v[1]));
+					}
+
+					for (int k = 0; k < 3; ++k)
+						KX_RasterizerDrawDebugLine(tri[k], tri[(k + 1) % 3], color);
+				}
+				continue;
+			}
+
+			for (int i = 0, j = (int)poly->nv - 1; i < (int)poly->nv; j = i++)
+			{
+				if (poly->n[j] && renderMode == KX_NavMeshObject::RM_WALLS)
+					continue;
+				const float *vif = &header->verts[poly->v[i] * 3];
+				const float *vjf = &header->verts[poly->v[j] * 3];
+				const MT_Vector3 vi = navmeshobj->TransformToWorldCoords(MT_Vector3(vif[0], vif[2], vif[1]));
+				const MT_Vector3 vj = navmeshobj->TransformToWorldCoords(MT_Vector3(vjf[0], vjf[2], vjf[1]));
+				KX_RasterizerDrawDebugLine(vi, vj, color);
+			}
+		}
+	}
+}
+
 void KX_NavMeshObject::DrawNavMesh(NavMeshRenderMode renderMode)
 {
+	if (m_tileCache)
+	{
+		drawTiledNavMesh(this, m_tileCache->GetNavMesh(), renderMode);
+		return;
+	}
 	if (!m_navMesh)
 		return;
 	MT_Vector4 color(0.0f, 0.0f, 0.0f, 1.0f);
@@ -1047,35 +1272,19 @@ MT_Vector3 KX_NavMeshObject::TransformToWorldCoords(const MT_Vector3& lpos)
 	return wpos;
 }
 
-int KX_NavMeshObject::FindPath(const MT_Vector3& from, const MT_Vector3& to, float* path, int maxPathLen)
+template <class NavMesh, class PolyRef>
+static int findNavMeshPath(NavMesh *navmesh, const float spos[3], const float epos[3], float *path, int maxPathLen)
 {
-	if (!m_navMesh)
-		return 0;
-	MT_Vector3 localfrom = TransformToLocalCoords(from);
-	MT_Vector3 localto = TransformToLocalCoords(to);
-	float spos[3], epos[3];
-	localfrom.getValue(spos); flipAxes(spos);
-	localto.getValue(epos); flipAxes(epos);
-	dtStatPolyRef sPolyRef = m_navMesh->findNearestPoly(spos, polyPickExt);
-	dtStatPolyRef ePolyRef = m_navMesh->findNearestPoly(epos, polyPickExt);
+	const PolyRef sPolyRef = navmesh->findNearestPoly(spos, polyPickExt);
+	const PolyRef ePolyRef = navmesh->findNearestPoly(epos, polyPickExt);
 
 	int pathLen = 0;
 	if (sPolyRef && ePolyRef)
 	{
-		dtStatPolyRef* polys = new dtStatPolyRef[maxPathLen];
-		int npolys;
-		npolys = m_navMesh->findPath(sPolyRef, ePolyRef, spos, epos, polys, maxPathLen);
+		PolyRef *polys = new PolyRef[maxPathLen];
+		const int npolys = navmesh->findPath(sPolyRef, ePolyRef, spos, epos, polys, maxPathLen);
 		if (npolys)
-		{
-			pathLen = m_navMesh->findStraightPath(spos, epos, polys, npolys, path, maxPathLen);
-			for (int i=0; i<pathLen; i++)
-			{
-				flipAxes(&path[i*3]);
-				MT_Vector3 waypoint(&path[i*3]);
-				waypoint = TransformToWorldCoords(waypoint);
-				waypoint.getValue(&path[i*3]);
-			}
-		}
+			pathLen = navmesh->findStraightPath(spos, epos, polys, npolys, path, maxPathLen);
 
 		delete[] polys;
 	}
@@ -1083,15 +1292,97 @@ int KX_NavMeshObject::FindPath(const MT_Vector3& from, const MT_Vector3& to, flo
 	return pathLen;
 }
 
+void KX_NavMeshObject::ToNavMeshCoords(const MT_Vector3& wpos, float pos[3])
+{
+	TransformToLocalCoords(wpos).getValue(pos);
+	flipAxes(pos);
+}
+
+void KX_NavMeshObject::PathToWorldCoords(float *path, int pathLen)
+{
+	for (int i=0; i<pathLen; i++)
+	{
+		flipAxes(&path[i*3]);
+		MT_Vector3 waypoint(&path[i*3]);
+		waypoint = TransformToWorldCoords(waypoint);
+		waypoint.getValue(&path[i*3]);
+	}
+}
+
+int KX_NavMeshObject::FindPath(const MT_Vector3& from, const MT_Vector3& to, float* path, int maxPathLen)
+{
+	if (!m_navMesh && !m_tileCache)
+		return 0;
+	float spos[3], epos[3];
+	ToNavMeshCoords(from, spos);
+	ToNavMeshCoords(to, epos);
+
+	int pathLen;
+	if (m_tileCache)
+		pathLen = findNavMeshPath<dtTiledNavMesh, dtTilePolyRef>(m_tileCache->GetNavMesh(), spos, epos, path, maxPathLen);
+	else
+		pathLen = m_pathQueue->FindPath(spos, epos, path, maxPathLen);
+
+	PathToWorldCoords(path, pathLen);
+
+	return pathLen;
+}
+
+int KX_NavMeshObject::RequestPath(const MT_Vector3& from, const MT_Vector3& to)
+{
+	if (!m_navMesh && !m_tileCache)
+		return -1;
+	float spos[3], epos[3];
+	ToNavMeshCoords(from, spos);
+	ToNavMeshCoords(to, epos);
+
+	/* The tiled navigation mesh is modified by the main thread when merging tiles,
+	 * its paths are solved immediately and only delivered as the other requests. */
+	if (m_tileCache)
+	{
+		float path[KX_NavMeshPathQueue::MaxPathLength * 3];
+		const int pathLen = findNavMeshPath<dtTiledNavMesh, dtTilePolyRef>(m_tileCache->GetNavMesh(), spos, epos,
+																			path, KX_NavMeshPathQueue::MaxPathLength);
+		return m_pathQueue->AddResult(path, pathLen);
+	}
+
+	return m_pathQueue->RequestPath(spos, epos);
+}
+
+int KX_NavMeshObject::PollPath(int ticket, float *path, int maxPathLen)
+{
+	const int pathLen = m_pathQueue->PollPath(ticket, path, maxPathLen);
+	PathToWorldCoords(path, pathLen);
+	return pathLen;
+}
+
+void KX_NavMeshObject::CancelPath(int ticket)
+{
+	m_pathQueue->CancelPath(ticket);
+}
+
 float KX_NavMeshObject::Raycast(const MT_Vector3& from, const MT_Vector3& to)
 {
-	if (!m_navMesh)
+	if (!m_navMesh && !m_tileCache)
 		return 0.f;
 	MT_Vector3 localfrom = TransformToLocalCoords(from);
 	MT_Vector3 localto = TransformToLocalCoords(to);
 	float spos[3], epos[3];
 	localfrom.getValue(spos); flipAxes(spos);
 	localto.getValue(epos); flipAxes(epos);
+
+	if (m_tileCache)
+	{
+		dtTiledNavMesh *navmesh = m_tileCache->GetNavMesh();
+		const dtTilePolyRef sPolyRef = navmesh->findNearestPoly(spos, polyPickExt);
+		if (!sPolyRef)
+			return 0.f;
+		float t = 0;
+		dtTilePolyRef polys[MAX_PATH_LEN];
+		navmesh->raycast(sPolyRef, spos, epos, t, polys, MAX_PATH_LEN);
+		return t;
+	}
+
 	dtStatPolyRef sPolyRef = m_navMesh->findNearestPoly(spos, polyPickExt);
 	float t=0;
 	static dtStatPolyRef polys[MAX_PATH_LEN];
@@ -1141,6 +1432,8 @@ PyTypeObject KX_NavMeshObject::Type = {
 };
 
 PyAttributeDef KX_NavMeshObject::Attributes[] = {
+	KX_PYATTRIBUTE_RO_FUNCTION("tiled", KX_NavMeshObject, pyattr_get_tiled),
+	KX_PYATTRIBUTE_RO_FUNCTION("pendingTiles", KX_NavMeshObject, pyattr_get_pending_tiles),
 	KX_PYATTRIBUTE_NULL //Sentinel
 };
 
@@ -1150,6 +1443,10 @@ PyMethodDef KX_NavMeshObject::Methods[] = {
 	KX_PYMETHODTABLE(KX_NavMeshObject, raycast),
 	KX_PYMETHODTABLE(KX_NavMeshObject, draw),
 	KX_PYMETHODTABLE(KX_NavMeshObject, rebuild),
+	KX_PYMETHODTABLE(KX_NavMeshObject, addObstacle),
+	KX_PYMETHODTABLE(KX_NavMeshObject, removeObstacle),
+	KX_PYMETHODTABLE_O(KX_NavMeshObject, addGeometry),
+	KX_PYMETHODTABLE_O(KX_NavMeshObject, removeGeometry),
 	{nullptr,nullptr} //Sentinel
 };
 
@@ -1209,4 +1506,74 @@ KX_PYMETHODDEF_DOC_NOARGS(KX_NavMeshObject, rebuild,
 	Py_RETURN_NONE;
 }
 
+KX_PYMETHODDEF_DOC(KX_NavMeshObject, addObstacle,
+				   "addObstacle(position, radius, height): carve a vertical cylinder in a tiled navigation mesh\n"
+				   "Returns the obstacle identifier, the affected tiles are rebuilt in background\n")
+{
+	PyObject *ob_pos;
+	float radius, height;
+	if (!PyArg_ParseTuple(args, "Off:addObstacle", &ob_pos, &radius, &height))
+		return nullptr;
+	MT_Vector3 pos;
+	if (!PyVecTo(ob_pos, pos))
+		return nullptr;
+	if (!m_tileCache) {
+		PyErr_SetString(PyExc_RuntimeError, "navmesh.addObstacle(position, radius, height): navigation mesh is not tiled");
+		return nullptr;
+	}
+	return PyLong_FromLong(AddObstacle(pos, radius, height));
+}
+
+KX_PYMETHODDEF_DOC(KX_NavMeshObject, removeObstacle,
+				   "removeObstacle(id): remove an obstacle added with addObstacle\n"
+				   "Returns True if the obstacle existed\n")
+{
+	int id;
+	if (!PyArg_ParseTuple(args, "i:removeObstacle", &id))
+		return nullptr;
+	return PyBool_FromLong(RemoveObstacle(id));
+}
+
+KX_PYMETHODDEF_DOC_O(KX_NavMeshObject, addGeometry,
+					 "addGeometry(object): add or update the walkable geometry of an object in a tiled navigation mesh\n"
+					 "Returns True if the geometry was added\n")
+{
+	KX_GameObject *gameobj;
+	if (!ConvertPythonToGameObject(GetScene()->GetLogicManager(), value, &gameobj, false,
+								   "navmesh.addGeometry(object): KX_NavMeshObject"))
+	{
+		return nullptr;
+	}
+	if (!m_tileCache) {
+		PyErr_SetString(PyExc_RuntimeError, "navmesh.addGeometry(object): navigation mesh is not tiled");
+		return nullptr;
+	}
+	return PyBool_FromLong(AddGeometry(gameobj));
+}
+
+KX_PYMETHODDEF_DOC_O(KX_NavMeshObject, removeGeometry,
+					 "removeGeometry(object): remove the geometry of an object from a tiled navigation mesh\n"
+					 "Returns True if the object geometry was used\n")
+{
+	KX_GameObject *gameobj;
+	if (!ConvertPythonToGameObject(GetScene()->GetLogicManager(), value, &gameobj, false,
+								   "navmesh.removeGeometry(object): KX_NavMeshObject"))
+	{
+		return nullptr;
+	}
+	return PyBool_FromLong(RemoveGeometry(gameobj));
+}
+
+PyObject *KX_NavMeshObject::pyattr_get_tiled(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef)
+{
+	KX_NavMeshObject *self = static_cast<KX_NavMeshObject *>(self_v);
+	return PyBool_FromLong(self->m_tileCache != nullptr);
+}
+
+PyObject *KX_NavMeshObject::pyattr_get_pending_tiles(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef)
+{
+	KX_NavMeshObject *self = static_cast<KX_NavMeshObject *>(self_v);
+	return PyLong_FromLong(self->m_tileCache ? self->m_tileCache->GetPendingTileCount() : 0);
+}
+
 #endif // WITH_PYTHON
@@ -27,6 +27,8 @@
 #ifndef __KX_NAVMESHOBJECT_H__
 #define __KX_NAVMESHOBJECT_H__
 #include "DetourStatNavMesh.h"
+#include "KX_NavMeshTileCache.h"
+#include "KX_NavMeshPathQueue.h"
 #include "KX_GameObject.h"
 #include "EXP_PyObjectPlus.h"
 #include <vector>
@@ -40,11 +42,23 @@ class KX_NavMeshObject: public KX_GameObject
 
 protected:
 	dtStatNavMesh* m_navMesh;
+	/// Runtime rebuildable navigation mesh, used instead of m_navMesh when the scene tile size is not zero.
+	KX_NavMeshTileCache *m_tileCache;
+	/// Asynchronous path queries and corridor cache.
+	KX_NavMeshPathQueue *m_pathQueue;
 	
 	bool BuildVertIndArrays(float *&vertices, int& nverts,
 							unsigned short* &polys, int& npolys, unsigned short *&dmeshes, 
 							float *&dvertices, int &ndvertsuniq, unsigned short* &dtris, 
 							int& ndtris, int &vertsPerPoly);
+
+	bool BuildTiledNavMesh(int tileSize);
+	/// Convert the first mesh of an object to a triangle soup in the navigation mesh space.
+	bool GetObjectGeometry(KX_GameObject *gameobj, KX_NavMeshTileCache::Geometry& geometry);
+	/// Convert a world position to the navigation mesh space.
+	void ToNavMeshCoords(const MT_Vector3& wpos, float pos[3]);
+	/// Convert a path in the navigation mesh space to world positions.
+	void PathToWorldCoords(float *path, int pathLen);
 	
 public:
 	KX_NavMeshObject(void* sgReplicationInfo, SG_Callbacks callbacks);
@@ -56,7 +70,28 @@ public:
 
 	bool BuildNavMesh();
 	dtStatNavMesh* GetNavMesh();
+	KX_NavMeshTileCache *GetTileCache() const;
+
+	/// Publish the paths solved since the last logic frame, called before the actuators update.
+	void FinishPathRequests();
+	/** Merge the tiles computed since last call and schedule the dirty tiles and
+	 * the path requests, called once per logic frame after the logic update.
+	 */
+	void UpdateNavigation();
+	/// Add or update the walkable geometry of an object (e.g a LibLoad'ed level chunk) in a tiled navigation mesh.
+	bool AddGeometry(KX_GameObject *gameobj);
+	/// Remove the geometry of an object from a tiled navigation mesh.
+	bool RemoveGeometry(KX_GameObject *gameobj);
+	/// Carve a cylinder in a tiled navigation mesh, return the obstacle identifier or -1.
+	int AddObstacle(const MT_Vector3& pos, float radius, float height);
+	bool RemoveObstacle(int id);
+
 	int FindPath(const MT_Vector3& from, const MT_Vector3& to, float* path, int maxPathLen);
+	/// Request a path solved in background, return a ticket to poll the path during the next frames or -1.
+	int RequestPath(const MT_Vector3& from, const MT_Vector3& to);
+	/// Get the path of a request, return the number of points or -1 if the path isn't solved yet.
+	int PollPath(int ticket, float *path, int maxPathLen);
+	void CancelPath(int ticket);
 	float Raycast(const MT_Vector3& from, const MT_Vector3& to);
 
 	enum NavMeshRenderMode {RM_WALLS, RM_POLYS, RM_TRIS, RM_MAX};
@@ -74,6 +109,13 @@ public:
 	KX_PYMETHOD_DOC(KX_NavMeshObject, raycast);
 	KX_PYMETHOD_DOC(KX_NavMeshObject, draw);
 	KX_PYMETHOD_DOC_NOARGS(KX_NavMeshObject, rebuild);
+	KX_PYMETHOD_DOC(KX_NavMeshObject, addObstacle);
+	KX_PYMETHOD_DOC(KX_NavMeshObject, removeObstacle);
+	KX_PYMETHOD_DOC_O(KX_NavMeshObject, addGeometry);
+	KX_PYMETHOD_DOC_O(KX_NavMeshObject, removeGeometry);
+
+	static PyObject *pyattr_get_tiled(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+	static PyObject *pyattr_get_pending_tiles(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
 #endif  /* WITH_PYTHON */
 };
 
@@ -0,0 +1,343 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_NavMeshPathQueue.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_NavMeshPathQueue.h"
+
+#include "BLI_utildefines.h"
+#include "BLI_math.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
+
+#include <algorithm>
+#include <cstring>
+
+static const float polyPickExt[3] = {2, 4, 2};
+
+KX_NavMeshPathQueue::KX_NavMeshPathQueue(unsigned int cacheSize)
+	:m_navMesh(nullptr),
+	m_nextTicket(0),
+	m_cacheSize(cacheSize)
+{
+	m_pool = BLI_task_pool_create(BLI_task_scheduler_get(), this);
+}
+
+KX_NavMeshPathQueue::~KX_NavMeshPathQueue()
+{
+	BLI_task_pool_cancel(m_pool);
+	BLI_task_pool_free(m_pool);
+
+	for (dtStatNavMesh *query : m_threadQueries) {
+		delete query;
+	}
+}
+
+void KX_NavMeshPathQueue::SetNavMesh(dtStatNavMesh *navmesh)
+{
+	BLI_task_pool_work_and_wait(m_pool);
+
+	// The current batch was solved with the old mesh, solve it again with the new one.
+	std::vector<Request> requests;
+	for (const Group& group : m_groups) {
+		for (const Request& request : group.m_requests) {
+			if (m_cancelled.find(request.m_ticket) == m_cancelled.end()) {
+				requests.push_back(request);
+			}
+		}
+	}
+	m_requests.insert(m_requests.begin(), requests.begin(), requests.end());
+	m_groups.clear();
+	m_tasks.clear();
+	m_cancelled.clear();
+
+	m_cache.clear();
+	m_cacheMap.clear();
+
+	for (dtStatNavMesh *query : m_threadQueries) {
+		delete query;
+	}
+	m_threadQueries.clear();
+
+	m_navMesh = navmesh;
+	if (!m_navMesh) {
+		return;
+	}
+
+	/* The scheduler counts its workers and the main thread, the thread identifiers of a pool
+	 * are in [0, numThreads[ where the main thread (0) can run tasks while waiting the pool. */
+	const int numThreads = BLI_task_scheduler_num_threads(BLI_task_scheduler_get());
+	for (int i = 0; i < numThreads; ++i) {
+		dtStatNavMesh *query = new dtStatNavMesh();
+		// The query doesn't own the data, the header pointers are set to the same values as in m_navMesh.
+		query->init(m_navMesh->getData(), 0, false);
+		m_threadQueries.push_back(query);
+	}
+}
+
+int KX_NavMeshPathQueue::RequestPath(const float spos[3], const float epos[3])
+{
+	Request request;
+	request.m_ticket = m_nextTicket++;
+	copy_v3_v3(request.m_spos, spos);
+	copy_v3_v3(request.m_epos, epos);
+	m_requests.push_back(request);
+
+	return request.m_ticket;
+}
+
+int KX_NavMeshPathQueue::AddResult(const float *path, int pathLen)
+{
+	const int ticket = m_nextTicket++;
+	m_results[ticket].assign(path, path + pathLen * 3);
+	return ticket;
+}
+
+int KX_NavMeshPathQueue::PollPath(int ticket, float *path, int maxPathLen)
+{
+	std::map<int, std::vector<float> >::iterator it = m_results.find(ticket);
+	if (it == m_results.end()) {
+		return -1;
+	}
+
+	const int pathLen = std::min((int)it->second.size() / 3, maxPathLen);
+	memcpy(path, it->second.data(), sizeof(float) * 3 * pathLen);
+	m_results.erase(it);
+
+	return pathLen;
+}
+
+void KX_NavMeshPathQueue::CancelPath(int ticket)
+{
+	std::vector<Request>::iterator it = std::find_if(m_requests.begin(), m_requests.end(),
+		[ticket](const Request& request) { return request.m_ticket == ticket; });
+	if (it != m_requests.end()) {
+		m_requests.erase(it);
+		return;
+	}
+
+	if (m_results.erase(ticket) == 0) {
+		// The ticket may be in the batch being solved.
+		m_cancelled.insert(ticket);
+	}
+}
+
+const KX_NavMeshPathQueue::Corridor *KX_NavMeshPathQueue::FindCorridor(const CorridorKey& key)
+{
+	const auto it = m_cacheMap.find(key);
+	if (it == m_cacheMap.end()) {
+		return nullptr;
+	}
+
+	// Move the corridor at the front, the least recently used are at the back.
+	m_cache.splice(m_cache.begin(), m_cache, it->second);
+	return &it->second->second;
+}
+
+void KX_NavMeshPathQueue::CacheCorridor(const CorridorKey& key, const Corridor& corridor)
+{
+	if (m_cacheSize == 0) {
+		return;
+	}
+
+	const auto it = m_cacheMap.find(key);
+	if (it != m_cacheMap.end()) {
+		it->second->second = corridor;
+		m_cache.splice(m_cache.begin(), m_cache, it->second);
+		return;
+	}
+
+	m_cache.emplace_front(key, corridor);
+	m_cacheMap[key] = m_cache.begin();
+
+	if (m_cache.size() > m_cacheSize) {
+		m_cacheMap.erase(m_cache.back().first);
+		m_cache.pop_back();
+	}
+}
+
+void KX_NavMeshPathQueue::SolveGroup(dtStatNavMesh *navmesh, Group& group, int maxPathLen)
+{
+	if (!group.m_cached) {
+		const Request& first = group.m_requests.front();
+		group.m_corridor.resize(maxPathLen);
+		const int npolys = navmesh->findPath(group.m_key.first, group.m_key.second, first.m_spos, first.m_epos,
+											 group.m_corridor.data(), maxPathLen);
+		group.m_corridor.resize(npolys);
+	}
+
+	group.m_paths.resize(group.m_requests.size());
+	if (group.m_corridor.empty()) {
+		return;
+	}
+
+	std::vector<float> path(maxPathLen * 3);
+	for (unsigned int i = 0, size = group.m_requests.size(); i < size; ++i) {
+		const Request& request = group.m_requests[i];
+		const int pathLen = navmesh->findStraightPath(request.m_spos, request.m_epos, group.m_corridor.data(),
+													  group.m_corridor.size(), path.data(), maxPathLen);
+		group.m_paths[i].assign(path.begin(), path.begin() + pathLen * 3);
+	}
+}
+
+void KX_NavMeshPathQueue::SolveTask(TaskPool *UNUSED(pool), void *taskdata, int threadid)
+{
+	Task *task = static_cast<Task *>(taskdata);
+	KX_NavMeshPathQueue *queue = task->m_queue;
+	dtStatNavMesh *query = queue->m_threadQueries[threadid];
+
+	for (unsigned int i = task->m_begin; i < task->m_end; ++i) {
+		SolveGroup(query, queue->m_groups[i], MaxPathLength);
+	}
+}
+
+void KX_NavMeshPathQueue::FinishBatch()
+{
+	if (m_groups.empty()) {
+		m_cancelled.clear();
+		return;
+	}
+
+	BLI_task_pool_work_and_wait(m_pool);
+
+	for (Group& group : m_groups) {
+		if (!group.m_cached && !group.m_corridor.empty()) {
+			CacheCorridor(group.m_key, group.m_corridor);
+		}
+
+		for (unsigned int i = 0, size = group.m_requests.size(); i < size; ++i) {
+			const int ticket = group.m_requests[i].m_ticket;
+			if (m_cancelled.find(ticket) == m_cancelled.end()) {
+				m_results[ticket].swap(group.m_paths[i]);
+			}
+		}
+	}
+
+	m_groups.clear();
+	m_tasks.clear();
+	m_cancelled.clear();
+}
+
+void KX_NavMeshPathQueue::StartBatch()
+{
+	if (m_requests.empty()) {
+		return;
+	}
+
+	// Requests sharing the same start and end polygons are solved with a single corridor.
+	std::map<CorridorKey, unsigned int> groupIndices;
+	for (const Request& request : m_requests) {
+		const dtStatPolyRef sPolyRef = m_navMesh ? m_navMesh->findNearestPoly(request.m_spos, polyPickExt) : 0;
+		const dtStatPolyRef ePolyRef = m_navMesh ? m_navMesh->findNearestPoly(request.m_epos, polyPickExt) : 0;
+		if (!sPolyRef || !ePolyRef) {
+			// No path, the result is available immediately.
+			m_results[request.m_ticket].clear();
+			continue;
+		}
+
+		const CorridorKey key(sPolyRef, ePolyRef);
+		const auto it = groupIndices.find(key);
+		if (it != groupIndices.end()) {
+			m_groups[it->second].m_requests.push_back(request);
+			continue;
+		}
+
+		groupIndices[key] = m_groups.size();
+		m_groups.emplace_back();
+
+		Group& group = m_groups.back();
+		group.m_key = key;
+		const Corridor *corridor = FindCorridor(key);
+		group.m_cached = (corridor != nullptr);
+		if (corridor) {
+			group.m_corridor = *corridor;
+		}
+		group.m_requests.push_back(request);
+	}
+	m_requests.clear();
+
+	if (m_groups.empty()) {
+		return;
+	}
+
+	// Split the groups in one contiguous range per thread.
+	const unsigned int numGroups = m_groups.size();
+	const unsigned int numTasks = std::min(numGroups, (unsigned int)m_threadQueries.size());
+	const unsigned int groupsPerTask = (numGroups + numTasks - 1) / numTasks;
+
+	m_tasks.resize(numTasks);
+	for (unsigned int i = 0; i < numTasks; ++i) {
+		Task& task = m_tasks[i];
+		task.m_queue = this;
+		task.m_begin = i * groupsPerTask;
+		task.m_end = std::min(task.m_begin + groupsPerTask, numGroups);
+		BLI_task_pool_push(m_pool, SolveTask, &task, false, TASK_PRIORITY_LOW);
+	}
+}
+
+int KX_NavMeshPathQueue::FindPath(const float spos[3], const float epos[3], float *path, int maxPathLen)
+{
+	if (!m_navMesh) {
+		return 0;
+	}
+
+	const dtStatPolyRef sPolyRef = m_navMesh->findNearestPoly(spos, polyPickExt);
+	const dtStatPolyRef ePolyRef = m_navMesh->findNearestPoly(epos, polyPickExt);
+	if (!sPolyRef || !ePolyRef) {
+		return 0;
+	}
+
+	Group group;
+	group.m_key = CorridorKey(sPolyRef, ePolyRef);
+	const Corridor *corridor = FindCorridor(group.m_key);
+	group.m_cached = (corridor != nullptr);
+	if (corridor) {
+		group.m_corridor = *corridor;
+	}
+
+	Request request;
+	copy_v3_v3(request.m_spos, spos);
+	copy_v3_v3(request.m_epos, epos);
+	group.m_requests.push_back(request);
+
+	// The main navigation mesh is never used by the worker threads.
+	SolveGroup(m_navMesh, group, maxPathLen);
+
+	if (!group.m_cached && !group.m_corridor.empty()) {
+		CacheCorridor(group.m_key, group.m_corridor);
+	}
+
+	const std::vector<float>& result = group.m_paths.front();
+	memcpy(path, result.data(), sizeof(float) * result.size());
+	return result.size() / 3;
+}
+
+unsigned int KX_NavMeshPathQueue::GetPendingCount() const
+{
+	unsigned int count = m_requests.size();
+	for (const Group& group : m_groups) {
+		count += group.m_requests.size();
+	}
+	return count;
+}
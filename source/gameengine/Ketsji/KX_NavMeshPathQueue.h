@@ -0,0 +1,142 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_NavMeshPathQueue.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_NAVMESH_PATH_QUEUE_H__
+#define __KX_NAVMESH_PATH_QUEUE_H__
+
+#include "DetourStatNavMesh.h"
+
+#include <vector>
+#include <list>
+#include <map>
+#include <set>
+
+struct TaskPool;
+
+/** Batched path queries over a static navigation mesh.
+ * Requests made during a logic frame are solved on worker threads after
+ * the logic and their results are published before the actuators of the
+ * next frame.
+ * Polygon corridors are shared between the requests of a batch using the
+ * same start and end polygons and kept in a LRU cache for the next batches.
+ * All positions are in the navigation mesh space (Y up).
+ */
+class KX_NavMeshPathQueue
+{
+private:
+	typedef std::pair<dtStatPolyRef, dtStatPolyRef> CorridorKey;
+	typedef std::vector<dtStatPolyRef> Corridor;
+
+	struct Request
+	{
+		int m_ticket;
+		float m_spos[3];
+		float m_epos[3];
+	};
+
+	/// Requests of a batch sharing the same corridor.
+	struct Group
+	{
+		CorridorKey m_key;
+		/// True if the corridor comes from the cache and must not be computed.
+		bool m_cached;
+		Corridor m_corridor;
+		std::vector<Request> m_requests;
+		/// Straight path of each request.
+		std::vector<std::vector<float> > m_paths;
+	};
+
+	/// Range of groups solved by one task.
+	struct Task
+	{
+		KX_NavMeshPathQueue *m_queue;
+		unsigned int m_begin;
+		unsigned int m_end;
+	};
+
+	dtStatNavMesh *m_navMesh;
+	/// One query navigation mesh per thread sharing the data of m_navMesh, Detour 1.4 stores the search nodes in the mesh.
+	std::vector<dtStatNavMesh *> m_threadQueries;
+
+	/// Requests waiting for the next batch.
+	std::vector<Request> m_requests;
+	/// Batch being solved in the task pool.
+	std::vector<Group> m_groups;
+	std::vector<Task> m_tasks;
+	/// Solved paths waiting to be polled.
+	std::map<int, std::vector<float> > m_results;
+	/// Tickets of the current batch cancelled before being solved.
+	std::set<int> m_cancelled;
+	int m_nextTicket;
+
+	std::list<std::pair<CorridorKey, Corridor> > m_cache;
+	std::map<CorridorKey, std::list<std::pair<CorridorKey, Corridor> >::iterator> m_cacheMap;
+	unsigned int m_cacheSize;
+
+	TaskPool *m_pool;
+
+	static void SolveTask(TaskPool *pool, void *taskdata, int threadid);
+	static void SolveGroup(dtStatNavMesh *navmesh, Group& group, int maxPathLen);
+
+	const Corridor *FindCorridor(const CorridorKey& key);
+	void CacheCorridor(const CorridorKey& key, const Corridor& corridor);
+
+public:
+	/// Maximum number of points in a path.
+	static const int MaxPathLength = 256;
+
+	KX_NavMeshPathQueue(unsigned int cacheSize);
+	~KX_NavMeshPathQueue();
+
+	/** Set the navigation mesh used by the queries, the cache is cleared and the requests
+	 * not yet solved are kept for the new navigation mesh. A null mesh resolve the requests
+	 * with empty paths.
+	 */
+	void SetNavMesh(dtStatNavMesh *navmesh);
+
+	/// Queue a path query and return its ticket.
+	int RequestPath(const float spos[3], const float epos[3]);
+	/// Store a path already computed by the caller and return its ticket.
+	int AddResult(const float *path, int pathLen);
+	/** Get the result of a query, return the number of points in the path or -1 if the
+	 * query is not solved yet. The ticket is released once the result is returned.
+	 */
+	int PollPath(int ticket, float *path, int maxPathLen);
+	/// Discard a query and its result.
+	void CancelPath(int ticket);
+
+	/// Synchronous path query using the corridor cache.
+	int FindPath(const float spos[3], const float epos[3], float *path, int maxPathLen);
+
+	/// Wait for the current batch and publish its results, called before the actuators update.
+	void FinishBatch();
+	/// Group the waiting requests and push them to the worker threads, called after the logic update.
+	void StartBatch();
+
+	unsigned int GetPendingCount() const;
+};
+
+#endif  // __KX_NAVMESH_PATH_QUEUE_H__
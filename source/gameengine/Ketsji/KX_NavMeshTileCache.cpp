@@ -0,0 +1,475 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_NavMeshTileCache.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_NavMeshTileCache.h"
+
+#include "Recast.h"
+#include "DetourTileNavMeshBuilder.h"
+
+#include "DNA_scene_types.h"
+
+#include "BLI_math.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
+
+#include "CM_Message.h"
+
+#include <cfloat>
+
+void KX_NavMeshTileCache::Geometry::UpdateBounds()
+{
+	if (m_verts.empty()) {
+		zero_v3(m_bmin);
+		zero_v3(m_bmax);
+		return;
+	}
+
+	rcCalcBounds(m_verts.data(), m_verts.size() / 3, m_bmin, m_bmax);
+}
+
+KX_NavMeshTileCache::KX_NavMeshTileCache(const RecastData& params, int tileCells)
+	:m_navMesh(new dtTiledNavMesh()),
+	m_nextObstacleId(0)
+{
+	const float cs = params.cellsize;
+	const float ch = params.cellheight;
+
+	m_config.m_cellSize = cs;
+	m_config.m_cellHeight = ch;
+	m_config.m_walkableSlope = RAD2DEGF(params.agentmaxslope);
+	m_config.m_walkableHeight = (int)ceilf(params.agentheight / ch);
+	m_config.m_walkableClimb = (int)floorf(params.agentmaxclimb / ch);
+	m_config.m_walkableRadius = (int)ceilf(params.agentradius / cs);
+	m_config.m_maxEdgeLen = (int)(params.edgemaxlen / cs);
+	m_config.m_maxSimplificationError = params.edgemaxerror;
+	m_config.m_minRegionArea = (int)(params.regionminsize * params.regionminsize);
+	m_config.m_mergeRegionArea = (int)(params.regionmergesize * params.regionmergesize);
+	m_config.m_detailSampleDist = (params.detailsampledist < 0.9f) ? 0.0f : cs * params.detailsampledist;
+	m_config.m_detailSampleMaxError = ch * params.detailsamplemaxerror;
+	m_config.m_partitioning = params.partitioning;
+	m_config.m_tileCells = tileCells;
+	// Use a tile size multiple of the cell size to keep the tile borders on the voxel grid.
+	m_config.m_tileSize = tileCells * cs;
+	m_config.m_borderSize = m_config.m_walkableRadius + 3;
+
+	const float orig[3] = {0.0f, 0.0f, 0.0f};
+	m_navMesh->init(orig, m_config.m_tileSize, m_config.m_walkableClimb * ch);
+
+	m_pool = BLI_task_pool_create(BLI_task_scheduler_get(), this);
+}
+
+KX_NavMeshTileCache::~KX_NavMeshTileCache()
+{
+	// Cancel the queued jobs and wait for the running ones.
+	BLI_task_pool_cancel(m_pool);
+	BLI_task_pool_free(m_pool);
+
+	for (TileJob *job : m_jobs) {
+		delete[] job->m_data;
+		delete job;
+	}
+
+	/* The Detour mesh doesn't release the data of its tiles in its
+	 * destructor, remove them to free it. */
+	while (!m_tiles.empty()) {
+		RemoveTile(*m_tiles.begin());
+	}
+
+	delete m_navMesh;
+}
+
+dtTiledNavMesh *KX_NavMeshTileCache::GetNavMesh() const
+{
+	return m_navMesh;
+}
+
+void KX_NavMeshTileCache::GetTileBounds(const TileKey& key, float bmin[3], float bmax[3]) const
+{
+	bmin[0] = key.first * m_config.m_tileSize;
+	bmin[1] = -FLT_MAX;
+	bmin[2] = key.second * m_config.m_tileSize;
+	bmax[0] = bmin[0] + m_config.m_tileSize;
+	bmax[1] = FLT_MAX;
+	bmax[2] = bmin[2] + m_config.m_tileSize;
+}
+
+void KX_NavMeshTileCache::TagTilesDirty(const float bmin[3], const float bmax[3])
+{
+	// A tile sees the geometry in its border, tag the neighbour tiles too.
+	const float border = m_config.m_borderSize * m_config.m_cellSize;
+	const int minx = (int)floorf((bmin[0] - border) / m_config.m_tileSize);
+	const int maxx = (int)floorf((bmax[0] + border) / m_config.m_tileSize);
+	const int miny = (int)floorf((bmin[2] - border) / m_config.m_tileSize);
+	const int maxy = (int)floorf((bmax[2] + border) / m_config.m_tileSize);
+
+	for (int y = miny; y <= maxy; ++y) {
+		for (int x = minx; x <= maxx; ++x) {
+			m_dirtyTiles.insert(TileKey(x, y));
+		}
+	}
+}
+
+KX_NavMeshTileCache::TileJob *KX_NavMeshTileCache::CreateJob(const TileKey& key)
+{
+	TileJob *job = new TileJob();
+	job->m_cache = this;
+	job->m_key = key;
+	job->m_generation = ++m_generations[key];
+	job->m_data = nullptr;
+	job->m_dataSize = 0;
+	job->m_done = false;
+
+	float bmin[3], bmax[3];
+	GetTileBounds(key, bmin, bmax);
+	copy_v3_v3(job->m_bmin, bmin);
+	copy_v3_v3(job->m_bmax, bmax);
+
+	// Gather the triangles overlapping the tile and its border.
+	const float border = m_config.m_borderSize * m_config.m_cellSize;
+	bmin[0] -= border;
+	bmin[2] -= border;
+	bmax[0] += border;
+	bmax[2] += border;
+
+	Geometry& tilegeom = job->m_geometry;
+	for (const std::pair<void * const, Geometry>& pair : m_geometries) {
+		const Geometry& geom = pair.second;
+		if (geom.m_bmin[0] > bmax[0] || geom.m_bmax[0] < bmin[0] ||
+			geom.m_bmin[2] > bmax[2] || geom.m_bmax[2] < bmin[2])
+		{
+			continue;
+		}
+
+		for (unsigned int i = 0, size = geom.m_tris.size(); i < size; i += 3) {
+			const float *v[3];
+			float tmin[3], tmax[3];
+			for (unsigned short j = 0; j < 3; ++j) {
+				v[j] = &geom.m_verts[geom.m_tris[i + j] * 3];
+			}
+			copy_v3_v3(tmin, v[0]);
+			copy_v3_v3(tmax, v[0]);
+			minmax_v3v3_v3(tmin, tmax, v[1]);
+			minmax_v3v3_v3(tmin, tmax, v[2]);
+
+			if (tmin[0] > bmax[0] || tmax[0] < bmin[0] || tmin[2] > bmax[2] || tmax[2] < bmin[2]) {
+				continue;
+			}
+
+			for (unsigned short j = 0; j < 3; ++j) {
+				tilegeom.m_tris.push_back(tilegeom.m_verts.size() / 3);
+				tilegeom.m_verts.insert(tilegeom.m_verts.end(), v[j], v[j] + 3);
+			}
+		}
+	}
+	tilegeom.UpdateBounds();
+
+	for (const std::pair<const int, Obstacle>& pair : m_obstacles) {
+		const Obstacle& obs = pair.second;
+		if (obs.m_pos[0] - obs.m_radius > bmax[0] || obs.m_pos[0] + obs.m_radius < bmin[0] ||
+			obs.m_pos[2] - obs.m_radius > bmax[2] || obs.m_pos[2] + obs.m_radius < bmin[2])
+		{
+			continue;
+		}
+		job->m_obstacles.push_back(obs);
+	}
+
+	return job;
+}
+
+bool KX_NavMeshTileCache::BuildTilePolyMesh(rcContext *ctx, const Config& config, const TileJob *job,
+											const float bmin[3], const float bmax[3], rcHeightfield& solid,
+											rcCompactHeightfield& chf, rcContourSet& cset, rcPolyMesh& pmesh,
+											rcPolyMeshDetail& dmesh)
+{
+	const Geometry& geom = job->m_geometry;
+	const int nverts = geom.m_verts.size() / 3;
+	const int ntris = geom.m_tris.size() / 3;
+	const int size = config.m_tileCells + config.m_borderSize * 2;
+	const int walkableHeight = config.m_walkableHeight;
+	const int walkableClimb = config.m_walkableClimb;
+
+	if (!rcCreateHeightfield(ctx, solid, size, size, bmin, bmax, config.m_cellSize, config.m_cellHeight)) {
+		return false;
+	}
+
+	std::vector<unsigned char> areas(ntris, RC_NULL_AREA);
+	rcMarkWalkableTriangles(ctx, config.m_walkableSlope, geom.m_verts.data(), nverts, geom.m_tris.data(), ntris, areas.data());
+	if (!rcRasterizeTriangles(ctx, geom.m_verts.data(), nverts, geom.m_tris.data(), areas.data(), ntris,
+							  solid, walkableClimb))
+	{
+		return false;
+	}
+
+	rcFilterLowHangingWalkableObstacles(ctx, walkableClimb, solid);
+	rcFilterLedgeSpans(ctx, walkableHeight, walkableClimb, solid);
+	rcFilterWalkableLowHeightSpans(ctx, walkableHeight, solid);
+
+	if (!rcBuildCompactHeightfield(ctx, walkableHeight, walkableClimb, solid, chf)) {
+		return false;
+	}
+
+	if (!rcErodeWalkableArea(ctx, config.m_walkableRadius, chf)) {
+		return false;
+	}
+
+	for (const Obstacle& obs : job->m_obstacles) {
+		rcMarkCylinderArea(ctx, obs.m_pos, obs.m_radius, obs.m_height, RC_NULL_AREA, chf);
+	}
+
+	if (config.m_partitioning == RC_PARTITION_WATERSHED) {
+		if (!rcBuildDistanceField(ctx, chf) ||
+			!rcBuildRegions(ctx, chf, config.m_borderSize, config.m_minRegionArea, config.m_mergeRegionArea))
+		{
+			return false;
+		}
+	}
+	else if (config.m_partitioning == RC_PARTITION_MONOTONE) {
+		if (!rcBuildRegionsMonotone(ctx, chf, config.m_borderSize, config.m_minRegionArea,
+									config.m_mergeRegionArea)) {
+			return false;
+		}
+	}
+	else if (!rcBuildLayerRegions(ctx, chf, config.m_borderSize, config.m_minRegionArea)) {
+		return false;
+	}
+
+	if (!rcBuildContours(ctx, chf, config.m_maxSimplificationError, config.m_maxEdgeLen, cset) || cset.nconts == 0) {
+		return false;
+	}
+
+	if (!rcBuildPolyMesh(ctx, cset, DT_TILE_VERTS_PER_POLYGON, pmesh) || pmesh.npolys == 0) {
+		return false;
+	}
+
+	if (!rcBuildPolyMeshDetail(ctx, pmesh, chf, config.m_detailSampleDist, config.m_detailSampleMaxError, dmesh)) {
+		return false;
+	}
+
+	return true;
+}
+
+void KX_NavMeshTileCache::BuildTile(const Config& config, TileJob *job)
+{
+	const Geometry& geom = job->m_geometry;
+	if (geom.m_tris.empty()) {
+		return;
+	}
+
+	const float border = config.m_borderSize * config.m_cellSize;
+	const float bmin[3] = {job->m_bmin[0] - border, geom.m_bmin[1], job->m_bmin[2] - border};
+	const float bmax[3] = {job->m_bmax[0] + border, geom.m_bmax[1], job->m_bmax[2] + border};
+
+	// Disable logs and timers, the context is used from a worker thread.
+	rcContext ctx(false);
+
+	rcHeightfield *solid = rcAllocHeightfield();
+	rcCompactHeightfield *chf = rcAllocCompactHeightfield();
+	rcContourSet *cset = rcAllocContourSet();
+	rcPolyMesh *pmesh = rcAllocPolyMesh();
+	rcPolyMeshDetail *dmesh = rcAllocPolyMeshDetail();
+
+	const bool built = BuildTilePolyMesh(&ctx, config, job, bmin, bmax, *solid, *chf, *cset, *pmesh, *dmesh);
+
+	/* Detour polygon references can only address DT_MAX_POLYGONS per tile
+	 * and the detail meshes use 16 bits indices. */
+	if (built && pmesh->npolys <= DT_MAX_POLYGONS && dmesh->nverts < 0xffff) {
+		std::vector<unsigned short> dmeshes(dmesh->nmeshes * 4);
+		for (unsigned int i = 0, size = dmeshes.size(); i < size; ++i) {
+			dmeshes[i] = (unsigned short)dmesh->meshes[i];
+		}
+
+		if (!dtCreateNavMeshTileData(pmesh->verts, pmesh->nverts, pmesh->polys, pmesh->npolys, pmesh->nvp,
+									 dmeshes.data(), dmesh->verts, dmesh->nverts, dmesh->tris, dmesh->ntris,
+									 pmesh->bmin, pmesh->bmax, config.m_cellSize, config.m_cellHeight,
+									 config.m_tileCells, config.m_walkableClimb, &job->m_data, &job->m_dataSize))
+		{
+			job->m_data = nullptr;
+			job->m_dataSize = 0;
+		}
+	}
+
+	rcFreeHeightField(solid);
+	rcFreeCompactHeightfield(chf);
+	rcFreeContourSet(cset);
+	rcFreePolyMesh(pmesh);
+	rcFreePolyMeshDetail(dmesh);
+}
+
+void KX_NavMeshTileCache::BuildTileTask(TaskPool *UNUSED(pool), void *taskdata, int UNUSED(threadid))
+{
+	TileJob *job = (TileJob *)taskdata;
+	KX_NavMeshTileCache *cache = job->m_cache;
+
+	BuildTile(cache->m_config, job);
+
+	cache->m_jobsMutex.Lock();
+	job->m_done = true;
+	cache->m_jobsMutex.Unlock();
+}
+
+void KX_NavMeshTileCache::RemoveTile(const TileKey& key)
+{
+	if (m_tiles.erase(key) == 0) {
+		return;
+	}
+
+	// The tile owns its data, Detour frees it.
+	m_navMesh->removeTileAt(key.first, key.second, nullptr, nullptr);
+}
+
+bool KX_NavMeshTileCache::MergeJob(TileJob *job)
+{
+	// The tile was tagged dirty again after this job was pushed, a newer result is coming.
+	if (m_generations[job->m_key] != job->m_generation) {
+		delete[] job->m_data;
+		return false;
+	}
+
+	RemoveTile(job->m_key);
+
+	if (job->m_data) {
+		if (m_navMesh->addTileAt(job->m_key.first, job->m_key.second, job->m_data, job->m_dataSize, true)) {
+			m_tiles.insert(job->m_key);
+		}
+		else {
+			CM_Warning("unable to add navigation mesh tile (" << job->m_key.first << ", " << job->m_key.second
+					   << "), the maximum number of tiles is " << DT_MAX_TILES);
+			delete[] job->m_data;
+		}
+	}
+
+	return true;
+}
+
+void KX_NavMeshTileCache::SetGeometry(void *key, const Geometry& geometry)
+{
+	std::map<void *, Geometry>::iterator it = m_geometries.find(key);
+	if (it != m_geometries.end()) {
+		TagTilesDirty(it->second.m_bmin, it->second.m_bmax);
+		it->second = geometry;
+	}
+	else {
+		it = m_geometries.insert(std::make_pair(key, geometry)).first;
+	}
+
+	it->second.UpdateBounds();
+	TagTilesDirty(it->second.m_bmin, it->second.m_bmax);
+}
+
+bool KX_NavMeshTileCache::RemoveGeometry(void *key)
+{
+	std::map<void *, Geometry>::iterator it = m_geometries.find(key);
+	if (it == m_geometries.end()) {
+		return false;
+	}
+
+	TagTilesDirty(it->second.m_bmin, it->second.m_bmax);
+	m_geometries.erase(it);
+	return true;
+}
+
+int KX_NavMeshTileCache::AddObstacle(const float pos[3], float radius, float height)
+{
+	Obstacle obs;
+	copy_v3_v3(obs.m_pos, pos);
+	obs.m_radius = radius;
+	obs.m_height = height;
+
+	const int id = m_nextObstacleId++;
+	m_obstacles[id] = obs;
+
+	const float bmin[3] = {pos[0] - radius, pos[1], pos[2] - radius};
+	const float bmax[3] = {pos[0] + radius, pos[1] + height, pos[2] + radius};
+	TagTilesDirty(bmin, bmax);
+
+	return id;
+}
+
+bool KX_NavMeshTileCache::RemoveObstacle(int id)
+{
+	std::map<int, Obstacle>::iterator it = m_obstacles.find(id);
+	if (it == m_obstacles.end()) {
+		return false;
+	}
+
+	const Obstacle& obs = it->second;
+	const float bmin[3] = {obs.m_pos[0] - obs.m_radius, obs.m_pos[1], obs.m_pos[2] - obs.m_radius};
+	const float bmax[3] = {obs.m_pos[0] + obs.m_radius, obs.m_pos[1] + obs.m_height, obs.m_pos[2] + obs.m_radius};
+	TagTilesDirty(bmin, bmax);
+
+	m_obstacles.erase(it);
+	return true;
+}
+
+void KX_NavMeshTileCache::Build()
+{
+	while (!m_tiles.empty()) {
+		RemoveTile(*m_tiles.begin());
+	}
+
+	for (const std::pair<void * const, Geometry>& pair : m_geometries) {
+		TagTilesDirty(pair.second.m_bmin, pair.second.m_bmax);
+	}
+
+	// Push all the tiles, wait for them while helping the workers, then merge.
+	Update();
+	BLI_task_pool_work_and_wait(m_pool);
+	Update();
+}
+
+void KX_NavMeshTileCache::Update()
+{
+	std::vector<TileJob *> finished;
+
+	m_jobsMutex.Lock();
+	for (std::vector<TileJob *>::iterator it = m_jobs.begin(); it != m_jobs.end();) {
+		if ((*it)->m_done) {
+			finished.push_back(*it);
+			it = m_jobs.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+	m_jobsMutex.Unlock();
+
+	for (TileJob *job : finished) {
+		MergeJob(job);
+		delete job;
+	}
+
+	for (const TileKey& key : m_dirtyTiles) {
+		TileJob *job = CreateJob(key);
+		m_jobs.push_back(job);
+		BLI_task_pool_push(m_pool, BuildTileTask, job, false, TASK_PRIORITY_LOW);
+	}
+	m_dirtyTiles.clear();
+}
+
+unsigned int KX_NavMeshTileCache::GetPendingTileCount() const
+{
+	return m_dirtyTiles.size() + m_jobs.size();
+}
@@ -0,0 +1,180 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_NavMeshTileCache.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_NAVMESH_TILE_CACHE_H__
+#define __KX_NAVMESH_TILE_CACHE_H__
+
+#include "DetourTileNavMesh.h"
+#include "CM_Thread.h"
+
+#include <vector>
+#include <map>
+#include <set>
+
+struct RecastData;
+struct TaskPool;
+struct rcHeightfield;
+struct rcCompactHeightfield;
+struct rcContourSet;
+struct rcPolyMesh;
+struct rcPolyMeshDetail;
+class rcContext;
+
+/** Tiled navigation mesh built with Recast from a set of geometry sources.
+ * Tiles touched by a geometry or obstacle change are rebuilt on worker threads
+ * and swapped into the Detour mesh on the main thread in Update().
+ * All coordinates are in the navigation mesh object space using the Recast
+ * axes convention (Y up).
+ */
+class KX_NavMeshTileCache
+{
+public:
+	/// Triangle soup contributing to the walkable surface.
+	struct Geometry
+	{
+		std::vector<float> m_verts;
+		std::vector<int> m_tris;
+		float m_bmin[3];
+		float m_bmax[3];
+
+		void UpdateBounds();
+	};
+
+	/// Cylinder carved out of the walkable surface.
+	struct Obstacle
+	{
+		/// Center of the cylinder base.
+		float m_pos[3];
+		float m_radius;
+		float m_height;
+	};
+
+private:
+	/// Recast build parameters converted in voxel units.
+	struct Config
+	{
+		float m_cellSize;
+		float m_cellHeight;
+		float m_walkableSlope;
+		int m_walkableHeight;
+		int m_walkableClimb;
+		int m_walkableRadius;
+		int m_maxEdgeLen;
+		float m_maxSimplificationError;
+		int m_minRegionArea;
+		int m_mergeRegionArea;
+		float m_detailSampleDist;
+		float m_detailSampleMaxError;
+		char m_partitioning;
+		/// Tile width in cells.
+		int m_tileCells;
+		/// Tile width in object space units.
+		float m_tileSize;
+		/// Border in cells added around the tile to get seamless tile edges.
+		int m_borderSize;
+	};
+
+	typedef std::pair<int, int> TileKey;
+
+	/// Input and output of one tile build, the input is a copy so the job is independent of the cache state.
+	struct TileJob
+	{
+		KX_NavMeshTileCache *m_cache;
+		TileKey m_key;
+		unsigned int m_generation;
+		float m_bmin[3];
+		float m_bmax[3];
+		Geometry m_geometry;
+		std::vector<Obstacle> m_obstacles;
+		unsigned char *m_data;
+		int m_dataSize;
+		bool m_done;
+	};
+
+	Config m_config;
+	dtTiledNavMesh *m_navMesh;
+
+	/// All geometry sources indexed by an opaque key, usually the owner object.
+	std::map<void *, Geometry> m_geometries;
+	std::map<int, Obstacle> m_obstacles;
+	int m_nextObstacleId;
+
+	/// Tiles currently added in the Detour mesh.
+	std::set<TileKey> m_tiles;
+	/// Tiles waiting to be rebuilt.
+	std::set<TileKey> m_dirtyTiles;
+	/// Last requested build generation per tile, used to drop outdated results.
+	std::map<TileKey, unsigned int> m_generations;
+
+	/// Jobs pushed in the task pool and not yet merged.
+	std::vector<TileJob *> m_jobs;
+	CM_ThreadMutex m_jobsMutex;
+	TaskPool *m_pool;
+
+	static void BuildTileTask(TaskPool *pool, void *taskdata, int threadid);
+	/// Build the tile data, called from worker threads.
+	static void BuildTile(const Config& config, TileJob *job);
+	/// Run the Recast pipeline over the tile geometry, return false if the tile has no walkable polygon.
+	static bool BuildTilePolyMesh(rcContext *ctx, const Config& config, const TileJob *job,
+								  const float bmin[3], const float bmax[3], rcHeightfield& solid,
+								  rcCompactHeightfield& chf, rcContourSet& cset, rcPolyMesh& pmesh,
+								  rcPolyMeshDetail& dmesh);
+
+	void GetTileBounds(const TileKey& key, float bmin[3], float bmax[3]) const;
+	void TagTilesDirty(const float bmin[3], const float bmax[3]);
+	TileJob *CreateJob(const TileKey& key);
+	/// Replace the tile in the Detour mesh by the job result, return false if the result was outdated.
+	bool MergeJob(TileJob *job);
+	void RemoveTile(const TileKey& key);
+
+public:
+	KX_NavMeshTileCache(const RecastData& params, int tileCells);
+	~KX_NavMeshTileCache();
+
+	dtTiledNavMesh *GetNavMesh() const;
+
+	/// Add or replace the geometry identified by key, tiles overlapping the old and new geometry are rebuilt.
+	void SetGeometry(void *key, const Geometry& geometry);
+	/// Remove the geometry identified by key, return false if it doesn't exist.
+	bool RemoveGeometry(void *key);
+
+	/// Add a cylinder obstacle and return its identifier.
+	int AddObstacle(const float pos[3], float radius, float height);
+	/// Remove an obstacle, return false if the identifier is unknown.
+	bool RemoveObstacle(int id);
+
+	/// Rebuild synchronously all the tiles covering the geometry.
+	void Build();
+	/** Push dirty tiles to the worker threads and merge the tiles finished since last call.
+	 * Must be called from the main thread.
+	 */
+	void Update();
+
+	/// Number of tiles dirty or being rebuilt.
+	unsigned int GetPendingTileCount() const;
+};
+
+#endif  // __KX_NAVMESH_TILE_CACHE_H__
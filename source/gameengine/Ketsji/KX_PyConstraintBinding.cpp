@@ -126,6 +126,10 @@ PyDoc_STRVAR(gPySetSolverType__doc__,
 "setSolverType(int solverType)\n"
 "Very experimental, not recommended"
 );
+PyDoc_STRVAR(gPySetCharacterBatching__doc__,
+"setCharacterBatching(bool batching)\n"
+"Step all the characters in one multithreaded pass"
+);
 
 PyDoc_STRVAR(gPyCreateConstraint__doc__,
 "createConstraint(ob1,ob2,float restLength,float restitution,float damping)\n"
@@ -417,6 +421,23 @@ static PyObject *gPySetUseEpa(PyObject *self,
 	}
 	Py_RETURN_NONE;
 }
+static PyObject *gPySetCharacterBatching(PyObject *self,
+                                         PyObject *args,
+                                         PyObject *kwds)
+{
+	int batching;
+	if (PyArg_ParseTuple(args,"i",&batching))
+	{
+		if (PHY_GetActiveEnvironment())
+		{
+			PHY_GetActiveEnvironment()->SetCharacterBatching(batching);
+		}
+	}
+	else {
+		return nullptr;
+	}
+	Py_RETURN_NONE;
+}
 static PyObject *gPySetSolverType(PyObject *self,
                                   PyObject *args,
                                   PyObject *kwds)
@@ -687,6 +708,8 @@ static struct PyMethodDef physicsconstraints_methods[] = {
 	 METH_VARARGS, (const char *)gPySetUseEpa__doc__},
 	{"setSolverType",(PyCFunction) gPySetSolverType,
 	 METH_VARARGS, (const char *)gPySetSolverType__doc__},
+	{"setCharacterBatching",(PyCFunction) gPySetCharacterBatching,
+	 METH_VARARGS, (const char *)gPySetCharacterBatching__doc__},
 
 
 	{"createConstraint",(PyCFunction) gPyCreateConstraint,
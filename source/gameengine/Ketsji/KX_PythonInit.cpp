@@ -125,6 +125,7 @@ extern "C" {
 #include "KX_PythonInitTypes.h"
 
 #include "CM_Message.h"
+#include "CM_Memory.h"
 
 /* we only need this to get a list of libraries from the main struct */
 #include "DNA_ID.h"
@@ -152,6 +153,8 @@ extern "C" {
 /* for converting new scenes */
 #include "KX_BlenderConverter.h"
 #include "KX_LibLoadStatus.h"
+#include "KX_GlobalDictStorage.h"
+#include "KX_SoundManager.h"
 #include "KX_MeshProxy.h" /* for creating a new library of mesh objects */
 extern "C" {
 	#include "BKE_idcode.h"
@@ -164,6 +167,7 @@ extern "C" {
 static SCA_PythonKeyboard* gp_PythonKeyboard = nullptr;
 static SCA_PythonMouse* gp_PythonMouse = nullptr;
 static SCA_PythonJoystick* gp_PythonJoysticks[JOYINDEX_MAX] = {nullptr};
+static KX_GlobalDictStorage *gp_GlobalDictStorage = nullptr;
 
 static struct {
 	PyObject *path;
@@ -279,16 +283,38 @@ static PyObject *gPyRestartGame(PyObject *)
 }
 
 PyDoc_STRVAR(gPySaveGlobalDict_doc,
-"saveGlobalDict()\n"
-"Saves bge.logic.globalDict to a file"
+"saveGlobalDict(asynchronous=False, compress=False, chunked=False)\n"
+"Saves bge.logic.globalDict to a file\n"
+"asynchronous: write the file in background, the dictionary is still serialized before returning\n"
+"compress: compress the file with gzip\n"
+"chunked: write one file per key, only the keys changed since the last save are written"
 );
-static PyObject *gPySaveGlobalDict(PyObject *)
+static PyObject *gPySaveGlobalDict(PyObject *, PyObject *args, PyObject *kwds)
 {
-	saveGamePythonConfig();
+	int asynchronous = 0, compress = 0, chunked = 0;
+
+	static const char *kwlist[] = {"asynchronous", "compress", "chunked", nullptr};
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "|iii:saveGlobalDict", const_cast<char **>(kwlist),
+	                                 &asynchronous, &compress, &chunked))
+	{
+		return nullptr;
+	}
+
+	saveGamePythonConfig(asynchronous, compress, chunked);
 
 	Py_RETURN_NONE;
 }
 
+PyDoc_STRVAR(gPyIsGlobalDictSaving_doc,
+"isGlobalDictSaving()\n"
+"Returns True if an asynchronous save of bge.logic.globalDict is not finished"
+);
+static PyObject *gPyIsGlobalDictSaving(PyObject *)
+{
+	return PyBool_FromLong(gp_GlobalDictStorage && gp_GlobalDictStorage->IsWriting());
+}
+
 PyDoc_STRVAR(gPyLoadGlobalDict_doc,
 "LoadGlobalDict()\n"
 "Loads bge.logic.globalDict from a file"
@@ -309,6 +335,40 @@ static PyObject *gPyGetProfileInfo(PyObject *)
 	return KX_GetActiveEngine()->GetPyProfileDict();
 }
 
+PyDoc_STRVAR(gPyGetMemoryInfo_doc,
+"getMemoryInfo()\n"
+"returns a dictionary with the current and peak memory in bytes per subsystem"
+);
+static PyObject *gPyGetMemoryInfo(PyObject *)
+{
+	PyObject *dict = PyDict_New();
+	for (unsigned short i = 0; i < CM_MEMORY_CATEGORY_MAX; ++i) {
+		const CM_MemoryCategory category = (CM_MemoryCategory)i;
+		const CM_MemoryStats stats = CM_MemoryGetStats(category);
+		PyObject *item = Py_BuildValue("(nn)", (Py_ssize_t)stats.current, (Py_ssize_t)stats.peak);
+		PyDict_SetItemString(dict, CM_MemoryGetName(category), item);
+		Py_DECREF(item);
+	}
+
+	return dict;
+}
+
+PyDoc_STRVAR(gPyGetLibMemoryInfo_doc,
+"getLibMemoryInfo()\n"
+"returns a dictionary with the current and peak memory in bytes per library loaded with LibLoad"
+);
+static PyObject *gPyGetLibMemoryInfo(PyObject *)
+{
+	PyObject *dict = PyDict_New();
+	for (const std::pair<std::string, CM_MemoryStats>& pair : CM_MemoryGetLibraryStats()) {
+		PyObject *item = Py_BuildValue("(nn)", (Py_ssize_t)pair.second.current, (Py_ssize_t)pair.second.peak);
+		PyDict_SetItemString(dict, pair.first.c_str(), item);
+		Py_DECREF(item);
+	}
+
+	return dict;
+}
+
 PyDoc_STRVAR(gPySendMessage_doc,
 "sendMessage(subject, [body, to, from])\n"
 "sends a message in same manner as a message actuator"
@@ -425,6 +485,129 @@ static PyObject *gPyGetMaxPhysicsFrame(PyObject *)
 	return PyLong_FromLong(KX_GetActiveEngine()->GetMaxPhysicsFrame());
 }
 
+static PyObject *gPySetMaxSoundVoices(PyObject *, PyObject *args)
+{
+	int voices;
+	if (!PyArg_ParseTuple(args, "i:setMaxSoundVoices", &voices))
+		return nullptr;
+
+	if (voices < 0) {
+		PyErr_SetString(PyExc_ValueError, "bge.logic.setMaxSoundVoices(voices): expected a positive integer or 0");
+		return nullptr;
+	}
+
+	KX_GetActiveEngine()->GetSoundManager()->SetMaxVoices(voices);
+	Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetMaxSoundVoices(PyObject *)
+{
+	return PyLong_FromLong(KX_GetActiveEngine()->GetSoundManager()->GetMaxVoices());
+}
+
+/** Get the game objects of a python sequence and a float buffer of 3 floats per object.
+ * The caller must release the buffer and the sequence on success.
+ */
+static bool gPyGetObjectsVectorBuffer(PyObject *args, const char *format, bool writable,
+                                      PyObject **r_objects, std::vector<KX_GameObject *>& objects, Py_buffer *r_buffer)
+{
+	PyObject *pyobjects;
+	PyObject *pybuffer;
+	if (!PyArg_ParseTuple(args, format, &pyobjects, &pybuffer)) {
+		return false;
+	}
+
+	// The items of a CListValue are proxies already created, the sequence is cheap.
+	PyObject *sequence = PySequence_Fast(pyobjects, "expected a sequence of KX_GameObject");
+	if (!sequence) {
+		return false;
+	}
+
+	const Py_ssize_t size = PySequence_Fast_GET_SIZE(sequence);
+	PyObject **items = PySequence_Fast_ITEMS(sequence);
+	objects.resize(size);
+	for (Py_ssize_t i = 0; i < size; ++i) {
+		if (!PyObject_TypeCheck(items[i], &KX_GameObject::Type)) {
+			PyErr_Format(PyExc_TypeError, "item %d is not a KX_GameObject", (int)i);
+			Py_DECREF(sequence);
+			return false;
+		}
+		objects[i] = static_cast<KX_GameObject *>(BGE_PROXY_REF(items[i]));
+		if (!objects[i]) {
+			PyErr_SetString(PyExc_SystemError, BGE_PROXY_ERROR_MSG);
+			Py_DECREF(sequence);
+			return false;
+		}
+	}
+
+	if (PyObject_GetBuffer(pybuffer, r_buffer, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS | (writable ? PyBUF_WRITABLE : 0)) == -1) {
+		Py_DECREF(sequence);
+		return false;
+	}
+
+	const char *bufferFormat = r_buffer->format ? r_buffer->format : "B";
+	const char type = bufferFormat[strlen(bufferFormat) - 1];
+	if (type != 'f' || r_buffer->itemsize != sizeof(float) || r_buffer->len < (Py_ssize_t)(size * 3 * sizeof(float))) {
+		PyErr_Format(PyExc_ValueError, "expected a contiguous float32 buffer of at least %d items", (int)(size * 3));
+		PyBuffer_Release(r_buffer);
+		Py_DECREF(sequence);
+		return false;
+	}
+
+	*r_objects = sequence;
+	return true;
+}
+
+PyDoc_STRVAR(gPyGetWorldPositions_doc,
+"getWorldPositions(objects, buffer)\n"
+"Write the world position of each object in a float32 buffer of 3 floats per object."
+);
+static PyObject *gPyGetWorldPositions(PyObject *, PyObject *args)
+{
+	PyObject *sequence;
+	std::vector<KX_GameObject *> objects;
+	Py_buffer buffer;
+	if (!gPyGetObjectsVectorBuffer(args, "OO:getWorldPositions", true, &sequence, objects, &buffer)) {
+		return nullptr;
+	}
+
+	float *data = (float *)buffer.buf;
+	for (KX_GameObject *gameobj : objects) {
+		gameobj->NodeGetWorldPosition().getValue(data);
+		data += 3;
+	}
+
+	PyBuffer_Release(&buffer);
+	Py_DECREF(sequence);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPySetWorldPositions_doc,
+"setWorldPositions(objects, buffer)\n"
+"Set the world position of each object from a float32 buffer of 3 floats per object."
+);
+static PyObject *gPySetWorldPositions(PyObject *, PyObject *args)
+{
+	PyObject *sequence;
+	std::vector<KX_GameObject *> objects;
+	Py_buffer buffer;
+	if (!gPyGetObjectsVectorBuffer(args, "OO:setWorldPositions", false, &sequence, objects, &buffer)) {
+		return nullptr;
+	}
+
+	const float *data = (const float *)buffer.buf;
+	for (KX_GameObject *gameobj : objects) {
+		// Same as setting worldPosition, the children of an object must be updated before the next object.
+		gameobj->NodeSetWorldPosition(MT_Vector3(data));
+		gameobj->NodeUpdateGS(0.0f);
+		data += 3;
+	}
+
+	PyBuffer_Release(&buffer);
+	Py_DECREF(sequence);
+	Py_RETURN_NONE;
+}
+
 static PyObject *gPySetPhysicsTicRate(PyObject *, PyObject *args)
 {
 	float ticrate;
@@ -798,8 +981,9 @@ static struct PyMethodDef game_methods[] = {
 	{"startGame", (PyCFunction)gPyStartGame, METH_VARARGS, (const char *)gPyStartGame_doc},
 	{"endGame", (PyCFunction)gPyEndGame, METH_NOARGS, (const char *)gPyEndGame_doc},
 	{"restartGame", (PyCFunction)gPyRestartGame, METH_NOARGS, (const char *)gPyRestartGame_doc},
-	{"saveGlobalDict", (PyCFunction)gPySaveGlobalDict, METH_NOARGS, (const char *)gPySaveGlobalDict_doc},
+	{"saveGlobalDict", (PyCFunction)gPySaveGlobalDict, METH_VARARGS | METH_KEYWORDS, (const char *)gPySaveGlobalDict_doc},
 	{"loadGlobalDict", (PyCFunction)gPyLoadGlobalDict, METH_NOARGS, (const char *)gPyLoadGlobalDict_doc},
+	{"isGlobalDictSaving", (PyCFunction)gPyIsGlobalDictSaving, METH_NOARGS, (const char *)gPyIsGlobalDictSaving_doc},
 	{"sendMessage", (PyCFunction)gPySendMessage, METH_VARARGS, (const char *)gPySendMessage_doc},
 	{"getCurrentController", (PyCFunction) SCA_PythonController::sPyGetCurrentController, METH_NOARGS, SCA_PythonController::sPyGetCurrentController__doc__},
 	{"getCurrentScene", (PyCFunction) gPyGetCurrentScene, METH_NOARGS, gPyGetCurrentScene_doc},
@@ -813,6 +997,10 @@ static struct PyMethodDef game_methods[] = {
 	{"setMaxLogicFrame", (PyCFunction) gPySetMaxLogicFrame, METH_VARARGS, (const char *)"Sets the max number of logic frame per render frame"},
 	{"getMaxPhysicsFrame", (PyCFunction) gPyGetMaxPhysicsFrame, METH_NOARGS, (const char *)"Gets the max number of physics frame per render frame"},
 	{"setMaxPhysicsFrame", (PyCFunction) gPySetMaxPhysicsFrame, METH_VARARGS, (const char *)"Sets the max number of physics farme per render frame"},
+	{"getMaxSoundVoices", (PyCFunction) gPyGetMaxSoundVoices, METH_NOARGS, (const char *)"Gets the max number of mixed sound actuator voices"},
+	{"setMaxSoundVoices", (PyCFunction) gPySetMaxSoundVoices, METH_VARARGS, (const char *)"Sets the max number of mixed sound actuator voices"},
+	{"getWorldPositions", (PyCFunction) gPyGetWorldPositions, METH_VARARGS, (const char *)gPyGetWorldPositions_doc},
+	{"setWorldPositions", (PyCFunction) gPySetWorldPositions, METH_VARARGS, (const char *)gPySetWorldPositions_doc},
 	{"getLogicTicRate", (PyCFunction) gPyGetLogicTicRate, METH_NOARGS, (const char *)"Gets the logic tic rate"},
 	{"setLogicTicRate", (PyCFunction) gPySetLogicTicRate, METH_VARARGS, (const char *)"Sets the logic tic rate"},
 	{"getPhysicsTicRate", (PyCFunction) gPyGetPhysicsTicRate, METH_NOARGS, (const char *)"Gets the physics tic rate"},
@@ -839,6 +1027,8 @@ static struct PyMethodDef game_methods[] = {
 	{"PrintMemInfo", (PyCFunction)pyPrintStats, METH_NOARGS, (const char *)"Print engine statistics"},
 	{"NextFrame", (PyCFunction)gPyNextFrame, METH_NOARGS, (const char *)"Render next frame (if Python has control)"},
 	{"getProfileInfo", (PyCFunction)gPyGetProfileInfo, METH_NOARGS, gPyGetProfileInfo_doc},
+	{"getMemoryInfo", (PyCFunction)gPyGetMemoryInfo, METH_NOARGS, gPyGetMemoryInfo_doc},
+	{"getLibMemoryInfo", (PyCFunction)gPyGetLibMemoryInfo, METH_NOARGS, gPyGetLibMemoryInfo_doc},
 	/* library functions */
 	{"LibLoad", (PyCFunction)gLibLoad, METH_VARARGS|METH_KEYWORDS, (const char *)""},
 	{"LibNew", (PyCFunction)gLibNew, METH_VARARGS, (const char *)""},
@@ -2060,6 +2250,10 @@ void exitGamePlayerPythonScripting()
 		}
 	}
 
+	// Wait for the pending globalDict save.
+	delete gp_GlobalDictStorage;
+	gp_GlobalDictStorage = nullptr;
+
 	/* since python restarts we cant let the python backup of the sys.path hang around in a global pointer */
 	restorePySysObjects(); /* get back the original sys.path and clear the backup */
 	
@@ -2157,6 +2351,10 @@ void exitGamePythonScripting()
 		}
 	}
 
+	// Wait for the pending globalDict save.
+	delete gp_GlobalDictStorage;
+	gp_GlobalDictStorage = nullptr;
+
 	restorePySysObjects(); /* get back the original sys.path and clear the backup */
 	bpy_import_main_set(nullptr);
 	PyObjectPlus::ClearDeprecationWarning();
@@ -2585,130 +2783,175 @@ PyMODINIT_FUNC initApplicationPythonBinding()
 
 
 // utility function for loading and saving the globalDict
-void saveGamePythonConfig()
+static KX_GlobalDictStorage *getGlobalDictStorage()
+{
+	if (!gp_GlobalDictStorage) {
+		gp_GlobalDictStorage = new KX_GlobalDictStorage();
+	}
+	return gp_GlobalDictStorage;
+}
+
+static std::string pathGamePythonConfigChunks()
+{
+	return pathGamePythonConfig() + std::string(".chunks");
+}
+
+static PyObject *marshalGamePythonConfig(PyObject *value)
 {
-	char *marshal_buffer = nullptr;
-	int marshal_length = 0;
-	PyObject *gameLogic = PyImport_ImportModule("GameLogic");
-	if (gameLogic) {
-		PyObject *pyGlobalDict = PyDict_GetItemString(PyModule_GetDict(gameLogic), "globalDict"); // Same as importing the module
-		if (pyGlobalDict) {
 #ifdef Py_MARSHAL_VERSION
-			PyObject *pyGlobalDictMarshal = PyMarshal_WriteObjectToString(	pyGlobalDict, 2); // Py_MARSHAL_VERSION == 2 as of Py2.5
+	return PyMarshal_WriteObjectToString(value, 2); // Py_MARSHAL_VERSION == 2 as of Py2.5
 #else
-			PyObject *pyGlobalDictMarshal = PyMarshal_WriteObjectToString(	pyGlobalDict );
+	return PyMarshal_WriteObjectToString(value);
 #endif
-			if (pyGlobalDictMarshal) {
-				// for testing only
-				// PyObject_Print(pyGlobalDictMarshal, stderr, 0);
-				char *marshal_cstring;
-				
-				marshal_cstring = PyBytes_AsString(pyGlobalDictMarshal); // py3 uses byte arrays
-				marshal_length = PyBytes_Size(pyGlobalDictMarshal);
-				marshal_buffer = new char[marshal_length + 1];
-				memcpy(marshal_buffer, marshal_cstring, marshal_length);
-				Py_DECREF(pyGlobalDictMarshal);
-			}
-			else {
-				CM_Error("bge.logic.globalDict could not be marshal'd");
-			}
-		}
-		else {
-			CM_Error("bge.logic.globalDict was removed");
-		}
-		Py_DECREF(gameLogic);
-	}
-	else {
+}
+
+/** The dictionary is marshalled in the calling thread as it needs the GIL and a consistent
+ * state, only the compression and the file writing are done in background.
+ * The game holds the GIL on the main thread for its whole duration and the scripts can modify
+ * the dictionary at any time, a worker thread can't marshal it and a consistent snapshot
+ * (e.g. a deep copy) costs as much as marshalling it.
+ */
+void saveGamePythonConfig(bool asynchronous, bool compress, bool chunked)
+{
+	PyObject *gameLogic = PyImport_ImportModule("GameLogic");
+	if (!gameLogic) {
 		PyErr_Clear();
 		CM_Error("bge.logic failed to import bge.logic.globalDict will be lost");
+		return;
+	}
+
+	PyObject *pyGlobalDict = PyDict_GetItemString(PyModule_GetDict(gameLogic), "globalDict"); // Same as importing the module
+	if (!pyGlobalDict) {
+		CM_Error("bge.logic.globalDict was removed");
+		Py_DECREF(gameLogic);
+		return;
 	}
 
-	std::string marshal_path = pathGamePythonConfig();
+	const int flags = (compress ? KX_GlobalDictStorage::COMPRESS : 0) |
+	                  (asynchronous ? 0 : KX_GlobalDictStorage::SYNCHRONOUS);
 
-	if (marshal_length && marshal_buffer) {
-		FILE *fp = fopen(marshal_path.c_str(), "wb");
+	if (chunked && PyDict_Check(pyGlobalDict)) {
+		std::vector<KX_GlobalDictStorage::Entry> entries;
 
-		if (fp) {
-			if (fwrite(marshal_buffer, 1, marshal_length, fp) != marshal_length) {
-				CM_Error("could not write marshal data");
+		PyObject *key;
+		PyObject *value;
+		Py_ssize_t pos = 0;
+		while (PyDict_Next(pyGlobalDict, &pos, &key, &value)) {
+			PyObject *keyMarshal = marshalGamePythonConfig(key);
+			PyObject *valueMarshal = marshalGamePythonConfig(value);
+			if (!keyMarshal || !valueMarshal) {
+				// Don't write a partial dictionary, the missing keys would be deleted.
+				Py_XDECREF(keyMarshal);
+				Py_XDECREF(valueMarshal);
+				PyErr_Clear();
+				CM_Error("bge.logic.globalDict could not be marshal'd");
+				Py_DECREF(gameLogic);
+				return;
 			}
 
-			fclose(fp);
-		}
-		else {
-			CM_Error("could not open marshal file");
+			KX_GlobalDictStorage::Entry entry;
+			entry.m_key.assign(PyBytes_AsString(keyMarshal), PyBytes_Size(keyMarshal));
+			entry.m_value.assign(PyBytes_AsString(valueMarshal), PyBytes_Size(valueMarshal));
+			entries.push_back(entry);
+
+			Py_DECREF(keyMarshal);
+			Py_DECREF(valueMarshal);
 		}
+
+		getGlobalDictStorage()->SaveChunks(pathGamePythonConfigChunks(), pathGamePythonConfig(), std::move(entries), flags);
 	}
 	else {
-		CM_Error("could not create marshal buffer");
-	}
+		PyObject *pyGlobalDictMarshal = marshalGamePythonConfig(pyGlobalDict);
+		if (!pyGlobalDictMarshal) {
+			PyErr_Clear();
+			CM_Error("bge.logic.globalDict could not be marshal'd");
+			Py_DECREF(gameLogic);
+			return;
+		}
+
+		std::string data(PyBytes_AsString(pyGlobalDictMarshal), PyBytes_Size(pyGlobalDictMarshal)); // py3 uses byte arrays
+		Py_DECREF(pyGlobalDictMarshal);
 
-	if (marshal_buffer) {
-		delete [] marshal_buffer;
+		getGlobalDictStorage()->Save(pathGamePythonConfig(), pathGamePythonConfigChunks(), std::move(data), flags);
 	}
+
+	Py_DECREF(gameLogic);
 }
 
-void loadGamePythonConfig()
+/// Read the dictionary saved in one file or in chunks, return a new reference or nullptr.
+static PyObject *readGamePythonConfig()
 {
-	std::string marshal_path = pathGamePythonConfig();
+	KX_GlobalDictStorage *storage = getGlobalDictStorage();
+	const std::string chunkPath = pathGamePythonConfigChunks();
 
-	FILE *fp = fopen(marshal_path.c_str(), "rb");
+	// A pending save can still create or remove the chunk directory, wait for it before choosing the format.
+	storage->Wait();
 
-	if (fp) {
-		// obtain file size:
-		fseek (fp, 0, SEEK_END);
-		size_t marshal_length = ftell(fp);
-		if (marshal_length == -1) {
-			CM_Error("could not read position of '" << marshal_path << "'");
-			fclose(fp);
-			return;
+	if (BLI_is_dir(chunkPath.c_str())) {
+		std::vector<KX_GlobalDictStorage::Entry> entries;
+		if (!storage->LoadChunks(chunkPath, entries)) {
+			CM_Error("could not read all of '" << chunkPath << "'");
 		}
-		rewind(fp);
-
-		char *marshal_buffer = (char*)malloc (sizeof(char)*marshal_length);
-
-		int result = fread(marshal_buffer, 1, marshal_length, fp);
-
-		if (result == marshal_length) {
-			/* Restore the dict */
-			PyObject *gameLogic = PyImport_ImportModule("GameLogic");
-
-			if (gameLogic) {
-				PyObject *pyGlobalDict = PyMarshal_ReadObjectFromString(marshal_buffer, marshal_length);
-				if (pyGlobalDict) {
-					PyObject *pyGlobalDict_orig = PyDict_GetItemString(PyModule_GetDict(gameLogic), "globalDict"); // Same as importing the module.
-					if (pyGlobalDict_orig) {
-						PyDict_Clear(pyGlobalDict_orig);
-						PyDict_Update(pyGlobalDict_orig, pyGlobalDict);
-					}
-					else {
-						/* this should not happen, but cant find the original globalDict, just assign it then */
-						PyDict_SetItemString(PyModule_GetDict(gameLogic), "globalDict", pyGlobalDict); // Same as importing the module.
-					}
-					Py_DECREF(gameLogic);
-					Py_DECREF(pyGlobalDict);
-				}
-				else {
-					Py_DECREF(gameLogic);
-					PyErr_Clear();
-					CM_Error("could not marshall string");
-				}
+
+		PyObject *pyGlobalDict = PyDict_New();
+		for (const KX_GlobalDictStorage::Entry& entry : entries) {
+			PyObject *key = PyMarshal_ReadObjectFromString(entry.m_key.data(), entry.m_key.size());
+			PyObject *value = key ? PyMarshal_ReadObjectFromString(entry.m_value.data(), entry.m_value.size()) : nullptr;
+			if (value) {
+				PyDict_SetItem(pyGlobalDict, key, value);
 			}
 			else {
 				PyErr_Clear();
-				CM_Error("bge.logic failed to import bge.logic.globalDict will be lost");
+				CM_Error("could not marshall string");
 			}
-		}
-		else {
-			CM_Error("could not read all of '" << marshal_path << "'");
+			Py_XDECREF(key);
+			Py_XDECREF(value);
 		}
 
-		free(marshal_buffer);
-		fclose(fp);
+		return pyGlobalDict;
 	}
-	else {
-		CM_Error("could not open '" << marshal_path << "'");
+
+	const std::string marshal_path = pathGamePythonConfig();
+	std::string data;
+	if (!storage->Load(marshal_path, data)) {
+		CM_Error("could not read '" << marshal_path << "'");
+		return nullptr;
+	}
+
+	PyObject *pyGlobalDict = PyMarshal_ReadObjectFromString(data.data(), data.size());
+	if (!pyGlobalDict) {
+		PyErr_Clear();
+		CM_Error("could not marshall string");
 	}
+
+	return pyGlobalDict;
+}
+
+void loadGamePythonConfig()
+{
+	PyObject *gameLogic = PyImport_ImportModule("GameLogic");
+	if (!gameLogic) {
+		PyErr_Clear();
+		CM_Error("bge.logic failed to import bge.logic.globalDict will be lost");
+		return;
+	}
+
+	/* Restore the dict */
+	PyObject *pyGlobalDict = readGamePythonConfig();
+	if (pyGlobalDict) {
+		PyObject *pyGlobalDict_orig = PyDict_GetItemString(PyModule_GetDict(gameLogic), "globalDict"); // Same as importing the module.
+		if (pyGlobalDict_orig) {
+			PyDict_Clear(pyGlobalDict_orig);
+			PyDict_Update(pyGlobalDict_orig, pyGlobalDict);
+		}
+		else {
+			/* this should not happen, but cant find the original globalDict, just assign it then */
+			PyDict_SetItemString(PyModule_GetDict(gameLogic), "globalDict", pyGlobalDict); // Same as importing the module.
+		}
+		Py_DECREF(pyGlobalDict);
+	}
+
+	Py_DECREF(gameLogic);
 }
 
 std::string pathGamePythonConfig()
@@ -58,7 +58,10 @@ void exitGamePythonScripting();
 void setupGamePython(KX_KetsjiEngine *ketsjiengine, Main *blenderdata,
                      PyObject *pyGlobalDict, PyObject **gameLogic, int argc, char **argv, struct bContext *C);
 std::string pathGamePythonConfig();
-void saveGamePythonConfig();
+/** Save bge.logic.globalDict, asynchronous writes the file in background, compress uses gzip
+ * and chunked writes one file per key and only the keys changed since the last save.
+ */
+void saveGamePythonConfig(bool asynchronous = false, bool compress = false, bool chunked = false);
 void loadGamePythonConfig();
 
 /// Create a python interpreter and stop the engine until the interpreter is active.
@@ -152,11 +152,17 @@ bool KX_SCA_ReplaceMeshActuator::Update()
 		return false; // do nothing on negative events
 
 	if (m_mesh || m_use_phys) /* nullptr mesh is ok if were updating physics */
-		m_scene->ReplaceMesh(static_cast<KX_GameObject *>(GetParent()),m_mesh, m_use_gfx, m_use_phys);
+		m_scene->GetCommandBuffer().ReplaceMesh(static_cast<KX_GameObject *>(GetParent()), m_mesh, m_use_gfx, m_use_phys);
 
 	return false;
 }
 
+bool KX_SCA_ReplaceMeshActuator::IsOwnerLocal() const
+{
+	// Only records a command in the scene command buffer.
+	return true;
+}
+
 
 
 CValue* KX_SCA_ReplaceMeshActuator::GetReplica()
@@ -72,6 +72,7 @@ class KX_SCA_ReplaceMeshActuator : public SCA_IActuator
 
 	virtual bool 
 	Update();
+	virtual bool IsOwnerLocal() const;
 
 	void	InstantReplaceMesh();
 
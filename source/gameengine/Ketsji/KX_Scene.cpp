@@ -57,6 +57,7 @@
 #include "RAS_MeshObject.h"
 #include "SCA_IScene.h"
 #include "KX_LodManager.h"
+#include "BL_SkinDeformer.h"
 
 #include "RAS_Rasterizer.h"
 #include "RAS_ICanvas.h"
@@ -85,9 +86,11 @@
 #include "KX_NetworkMessageScene.h"
 #include "PHY_IPhysicsEnvironment.h"
 #include "PHY_IPhysicsController.h"
+#include "PHY_IGraphicController.h"
 #include "KX_BlenderConverter.h"
 #include "KX_MotionState.h"
 #include "KX_ObstacleSimulation.h"
+#include "KX_NavMeshObject.h"
 
 #include "KX_BlenderCanvas.h"
 
@@ -201,6 +204,12 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
   m_cameralist = new CListValue<KX_Camera>();
   m_fontlist = new CListValue<KX_FontObject>();
 
+  /* Scripts look up objects by name every frame and end objects from large lists,
+   * index the object lists by name to avoid iterating over them. */
+  m_objectlist->EnableNameIndex(true);
+  m_parentlist->EnableNameIndex(true);
+  m_inactivelist->EnableNameIndex(true);
+
   m_filterManager = new KX_2DFilterManager();
   m_logicmgr = new SCA_LogicManager();
 
@@ -223,6 +232,7 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
   m_networkScene = new KX_NetworkMessageScene(messageManager);
 
   m_rootnode = nullptr;
+  m_transformStore = std::make_shared<SG_TransformStore>();
 
   m_bucketmanager = new RAS_BucketManager();
 
@@ -288,7 +298,10 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
      * depsgraph code too later */
     scene->flag |= SCE_INTERACTIVE;
 
-    RenderAfterCameraSetup(nullptr, false);
+    // A headless player has no GPU context to initialize the render.
+    if (!KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::HEADLESS)) {
+      RenderAfterCameraSetup(nullptr, false);
+    }
   }
   else {
     Depsgraph *depsgraph = BKE_scene_get_depsgraph(
@@ -324,8 +337,11 @@ KX_Scene::~KX_Scene()
   ViewLayer *view_layer = BKE_view_layer_default_view(scene);
   Main *bmain = KX_GetActiveEngine()->GetConverter()->GetMain();
 
-  if ((scene->gm.flag & GAME_USE_VIEWPORT_RENDER) == 0 ||
-      !ar) {  // if no ar, we are in blenderplayer
+  // A headless player never rendered anything.
+  const bool headless = KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::HEADLESS);
+
+  if (!headless && ((scene->gm.flag & GAME_USE_VIEWPORT_RENDER) == 0 ||
+                    !ar)) {  // if no ar, we are in blenderplayer
     if (m_shadingTypeBackup != 0) {
       View3D *v3d = CTX_wm_view3d(KX_GetActiveEngine()->GetContext());
       v3d->shading.type = m_shadingTypeBackup;
@@ -685,10 +701,22 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam, bool is_overlay_pass)
 
   BKE_scene_graph_update_tagged(depsgraph, bmain);
 
+  ARegion *ar = canvas->GetARegion();
+
+  // The viewport render draws all the objects.
+  if (!(scene->gm.flag & GAME_USE_VIEWPORT_RENDER && ar)) {
+    CalculateVisibleObjects(cam);
+  }
+
   for (KX_GameObject *gameobj : GetObjectList()) {
-    gameobj->TagForUpdate(is_overlay_pass);
+    // Culled objects are not drawn, their sync can wait until they are visible.
+    if (!gameobj->GetCulled()) {
+      gameobj->TagForUpdate(is_overlay_pass);
+    }
   }
 
+  UpdateSkinDeformers(depsgraph);
+
   bool reset_taa_samples = !ObjectsAreStatic() || m_resetTaaSamples;
   m_resetTaaSamples = false;
   m_staticObjects.clear();
@@ -721,8 +749,6 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam, bool is_overlay_pass)
   m.pers.getValue(&pers[0][0]);
   m.persinv.getValue(&persinv[0][0]);
 
-  ARegion *ar = canvas->GetARegion();
-
   /* Ensure there is a valid ARegion *ar (this is not the case in blenderplayer)
    * Here we'll render directly the scene with viewport code.
    */
@@ -815,12 +841,19 @@ void KX_Scene::RenderAfterCameraSetupImageRender(KX_Camera *cam,
                                                  RAS_Rasterizer *rasty,
                                                  const rcti *window)
 {
+  CalculateVisibleObjects(cam);
+
   for (KX_GameObject *gameobj : GetObjectList()) {
-    gameobj->TagForUpdate(false);
+    if (!gameobj->GetCulled()) {
+      gameobj->TagForUpdate(false);
+    }
   }
 
   Main *bmain = KX_GetActiveEngine()->GetConverter()->GetMain();
   Scene *scene = GetBlenderScene();
+  ViewLayer *view_layer = BKE_view_layer_default_view(scene);
+
+  UpdateSkinDeformers(BKE_scene_get_depsgraph(bmain, scene, view_layer, false));
 
   SetCurrentGPUViewport(cam->GetGPUViewport());
 
@@ -901,6 +934,26 @@ SCA_LogicManager *KX_Scene::GetLogicManager() const
   return m_logicmgr;
 }
 
+KX_FrameArena &KX_Scene::GetFrameArena()
+{
+  return m_frameArena;
+}
+
+BL_ActionCache &KX_Scene::GetActionCache()
+{
+  return m_actionCache;
+}
+
+KX_SceneCommandBuffer &KX_Scene::GetCommandBuffer()
+{
+  return m_commandBuffer;
+}
+
+const std::shared_ptr<SG_TransformStore> &KX_Scene::GetTransformStore() const
+{
+  return m_transformStore;
+}
+
 SCA_TimeEventManager *KX_Scene::GetTimeEventManager() const
 {
   return m_timemgr;
@@ -1012,7 +1065,7 @@ KX_GameObject *KX_Scene::AddNodeReplicaObject(SG_Node *node, KX_GameObject *game
     newobj->SetSGNode(node);
   }
   else {
-    m_rootnode = new SG_Node(newobj, this, KX_Scene::m_callbacks);
+    m_rootnode = new SG_Node(newobj, this, KX_Scene::m_callbacks, m_transformStore);
 
     // this fixes part of the scaling-added object bug
     SG_Node *orgnode = gameobj->GetSGNode();
@@ -1094,6 +1147,14 @@ KX_GameObject *KX_Scene::AddNodeReplicaObject(SG_Node *node, KX_GameObject *game
       newctrl->SuspendDynamics();
   }
 
+  // replicate graphic controller, it is activated once the hierarchy is placed
+  if (gameobj->GetGraphicController()) {
+    PHY_IMotionState *motionstate = new KX_MotionState(newobj->GetSGNode());
+    PHY_IGraphicController *newctrl = gameobj->GetGraphicController()->GetReplica(motionstate);
+    newctrl->SetNewClientInfo(newobj->getClientInfo());
+    newobj->SetGraphicController(newctrl);
+  }
+
   return newobj;
 }
 
@@ -1402,6 +1463,9 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobject,
 
   replica->GetSGNode()->UpdateWorldData(0);
 
+  // The scene graph is updated, we can activate the graphic controllers.
+  replica->ActivateGraphicController(true);
+
   // now replicate logic
   for (KX_GameObject *gameobj : m_logicHierarchicalGameObjects) {
     gameobj->ReParentLogic();
@@ -1474,6 +1538,13 @@ void KX_Scene::DelayedRemoveObject(KX_GameObject *gameobj)
   }
 }
 
+void KX_Scene::RenameObject(KX_GameObject *gameobj, const std::string &oldname)
+{
+  m_objectlist->RenameValue(gameobj, oldname);
+  m_parentlist->RenameValue(gameobj, oldname);
+  m_inactivelist->RenameValue(gameobj, oldname);
+}
+
 bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 {
   /* remove property from debug list */
@@ -1542,6 +1613,14 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
     m_obstacleSimulation->DestroyObstacleForObj(gameobj);
   }
 
+  /* Remove the walkable geometry of the object from the tiled navigation meshes and rebuild
+   * the tiles it covered, this is also the path of the objects freed by LibFree. */
+  for (KX_NavMeshObject *navmesh : m_navMeshList) {
+    if (navmesh != gameobj) {
+      navmesh->RemoveGeometry(gameobj);
+    }
+  }
+
   gameobj->RemoveMeshes();
 
   bool ret = true;
@@ -1550,9 +1629,10 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
     ret = (gameobj->Release() != nullptr);
   if (m_objectlist->RemoveValue(gameobj))
     ret = (gameobj->Release() != nullptr);
-  if (m_parentlist->RemoveValue(gameobj))
+  // The order of the root parents and inactive objects doesn't matter.
+  if (m_parentlist->RemoveValueUnordered(gameobj))
     ret = (gameobj->Release() != nullptr);
-  if (m_inactivelist->RemoveValue(gameobj))
+  if (m_inactivelist->RemoveValueUnordered(gameobj))
     ret = (gameobj->Release() != nullptr);
   if (m_fontlist->RemoveValue(static_cast<KX_FontObject *>(gameobj))) {
     ret = (gameobj->Release() != nullptr);
@@ -1569,6 +1649,14 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
     m_animatedlist.erase(animit);
   }
 
+  const std::vector<KX_NavMeshObject *>::const_iterator navmeshit = std::find(
+      m_navMeshList.begin(), m_navMeshList.end(), gameobj);
+  if (navmeshit != m_navMeshList.end()) {
+    m_navMeshList.erase(navmeshit);
+  }
+
+  m_commandBuffer.UnlinkObject(gameobj);
+
   const std::vector<KX_GameObject *>::const_iterator euthit = std::find(
       m_euthanasyobjects.begin(), m_euthanasyobjects.end(), gameobj);
   if (euthit != m_euthanasyobjects.end()) {
@@ -1673,6 +1761,54 @@ void KX_Scene::PhysicsCullingCallback(KX_ClientObjectInfo *objectInfo, void *cul
     // ideally, invisible objects should be removed from the culling tree temporarily
     return;
   }
+  // the object is in the frustum and not occluded
+  gameobj->SetCulled(false);
+}
+
+void KX_Scene::CalculateVisibleObjects(KX_Camera *cam)
+{
+  KX_Camera *cullingcam = (m_overrideCullingCamera) ? m_overrideCullingCamera : cam;
+  bool dbvt_culling = false;
+
+  if (m_dbvt_culling && cullingcam && cullingcam->GetFrustumCulling()) {
+    // Cull all the objects of the culling tree, the test restores the visible ones.
+    for (KX_GameObject *gameobj : GetObjectList()) {
+      gameobj->SetCulled(gameobj->UseCulling());
+    }
+
+    const SG_Frustum &frustum = cullingcam->GetFrustum();
+    const RAS_Rect &area = KX_GetActiveEngine()->GetCanvas()->GetViewportArea();
+    const int viewport[4] = {area.GetLeft(), area.GetBottom(), area.GetWidth() + 1, area.GetHeight() + 1};
+    dbvt_culling = m_physicsEnvironment->CullingTest(PhysicsCullingCallback,
+                                                     this,
+                                                     frustum.GetPlanes(),
+                                                     m_dbvt_occlusion_res,
+                                                     viewport,
+                                                     frustum.GetMatrix());
+  }
+
+  if (!dbvt_culling) {
+    for (KX_GameObject *gameobj : GetObjectList()) {
+      gameobj->SetCulled(false);
+    }
+  }
+}
+
+void KX_Scene::UpdateSkinDeformers(Depsgraph *depsgraph)
+{
+  if (!depsgraph) {
+    return;
+  }
+
+  std::vector<BL_SkinDeformer *> deformers;
+  for (KX_GameObject *gameobj : GetObjectList()) {
+    BL_SkinDeformer *deformer = gameobj->GetSkinDeformer();
+    if (deformer && !gameobj->GetCulled() && gameobj->GetVisible()) {
+      deformers.push_back(deformer);
+    }
+  }
+
+  BL_SkinDeformer::UpdateDeformers(deformers, depsgraph);
 }
 
 void KX_Scene::RenderDebugProperties(RAS_DebugDraw &debugDraw,
@@ -1749,6 +1885,12 @@ void KX_Scene::LogicBeginFrame(double curtime, double framestep)
       BLI_assert(false);
     }
   }
+
+  // The paths requested during the last frame are available to the actuators of this frame.
+  for (KX_NavMeshObject *navmesh : m_navMeshList) {
+    navmesh->FinishPathRequests();
+  }
+
   m_logicmgr->BeginFrame(curtime, framestep);
 }
 
@@ -1761,6 +1903,15 @@ void KX_Scene::AddAnimatedObject(KX_GameObject *gameobj)
   }
 }
 
+void KX_Scene::AddNavMesh(KX_NavMeshObject *navmesh)
+{
+  const std::vector<KX_NavMeshObject *>::const_iterator it = std::find(
+      m_navMeshList.begin(), m_navMeshList.end(), navmesh);
+  if (it == m_navMeshList.end()) {
+    m_navMeshList.push_back(navmesh);
+  }
+}
+
 static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(threadid))
 {
   KX_GameObject *gameobj, *parent;
@@ -1819,6 +1970,9 @@ void KX_Scene::UpdateAnimations(double curtime)
 {
   // m_animationPoolData.curtime = curtime;
 
+  // The poses sampled in the previous frame are not played anymore.
+  m_actionCache.ClearSamples();
+
   for (KX_GameObject *gameobj : m_animatedlist) {
     // BLI_task_pool_push(m_animationPool, update_anim_thread_func, gameobj, false,
     // TASK_PRIORITY_LOW);
@@ -1832,20 +1986,24 @@ void KX_Scene::LogicUpdateFrame(double curtime)
 {
   /* Update object components, we copy the object pointer in a second list to make sure that we
    * iterate on a list which will not be modified, indeed components can add objects in theirs
-   * initialization.
+   * initialization. The copy is a temporary of the frame arena.
    */
 
-  std::vector<KX_GameObject *> objects;
+  const unsigned int numObjects = m_objectlist->GetCount();
+  KX_GameObject **objects = m_frameArena.NewArray<KX_GameObject *>(numObjects);
+  unsigned int numCopied = 0;
   for (KX_GameObject *gameobj : m_objectlist) {
-    objects.push_back(gameobj);
+    objects[numCopied++] = gameobj;
   }
 
-  for (std::vector<KX_GameObject *>::iterator it = objects.begin(), end = objects.end(); it != end;
-       ++it) {
-    (*it)->UpdateComponents();
+  for (unsigned int i = 0; i < numObjects; ++i) {
+    objects[i]->UpdateComponents();
   }
 
   m_logicmgr->UpdateFrame(curtime);
+
+  // Apply the objects added, ended, parented or with a replaced mesh by the actuators.
+  m_commandBuffer.Apply(this);
 }
 
 void KX_Scene::LogicEndFrame()
@@ -1866,6 +2024,12 @@ void KX_Scene::LogicEndFrame()
   if (m_obstacleSimulation)
     m_obstacleSimulation->UpdateObstacles();
 
+  /* Merge the navigation mesh tiles computed in background and schedule
+   * the tiles and path queries requested during this frame. */
+  for (KX_NavMeshObject *navmesh : m_navMeshList) {
+    navmesh->UpdateNavigation();
+  }
+
   for (KX_FontObject *font : m_fontlist) {
     font->UpdateTextFromProperty();
   }
@@ -1891,6 +2055,13 @@ void KX_Scene::UpdateParents(double curtime)
   }
 }
 
+void KX_Scene::SavePreviousTransforms()
+{
+  for (KX_GameObject *gameobj : GetObjectList()) {
+    gameobj->GetSGNode()->SavePreviousWorldTransform();
+  }
+}
+
 RAS_MaterialBucket *KX_Scene::FindBucket(class RAS_IPolyMaterial *polymat, bool &bucketCreated)
 {
   return m_bucketmanager->FindBucket(polymat, bucketCreated);
@@ -2067,12 +2238,18 @@ static void MergeScene_GameObject(KX_GameObject *gameobj, KX_Scene *to, KX_Scene
     }
   }
 
-  /* graphics controller */
+  /* physics controller */
   PHY_IController *ctrl = gameobj->GetPhysicsController();
   if (ctrl) {
     ctrl->SetPhysicsEnvironment(to->GetPhysicsEnvironment());
   }
 
+  /* graphics controller */
+  ctrl = gameobj->GetGraphicController();
+  if (ctrl) {
+    ctrl->SetPhysicsEnvironment(to->GetPhysicsEnvironment());
+  }
+
   /* SG_Node can hold a scene reference */
   SG_Node *sg = gameobj->GetSGNode();
   if (sg) {
@@ -2570,6 +2747,32 @@ int KX_Scene::pyattr_set_gravity(PyObjectPlus *self_v,
   return PY_SET_ATTR_SUCCESS;
 }
 
+PyObject *KX_Scene::pyattr_get_sensor_pulse_budget(PyObjectPlus *self_v,
+                                                   const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  return PyLong_FromLong(self->GetLogicManager()->GetPulseBudget());
+}
+
+int KX_Scene::pyattr_set_sensor_pulse_budget(PyObjectPlus *self_v,
+                                             const KX_PYATTRIBUTE_DEF *attrdef,
+                                             PyObject *value)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  // 0 disables the budget, negative values and values overflowing an unsigned int are rejected.
+  const unsigned long budget = PyLong_AsUnsignedLong(value);
+  if (PyErr_Occurred() || budget > UINT_MAX) {
+    PyErr_SetString(PyExc_ValueError,
+                    "scene.sensorPulseBudget = int: KX_Scene, expected a non-negative integer");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->GetLogicManager()->SetPulseBudget((unsigned int)budget);
+  return PY_SET_ATTR_SUCCESS;
+}
+
 PyAttributeDef KX_Scene::Attributes[] = {
     KX_PYATTRIBUTE_RO_FUNCTION("name", KX_Scene, pyattr_get_name),
     KX_PYATTRIBUTE_RO_FUNCTION("objects", KX_Scene, pyattr_get_objects),
@@ -2591,6 +2794,10 @@ PyAttributeDef KX_Scene::Attributes[] = {
     KX_PYATTRIBUTE_RW_FUNCTION(
         "pre_draw_setup", KX_Scene, pyattr_get_drawing_callback, pyattr_set_drawing_callback),
     KX_PYATTRIBUTE_RW_FUNCTION("gravity", KX_Scene, pyattr_get_gravity, pyattr_set_gravity),
+    KX_PYATTRIBUTE_RW_FUNCTION("sensorPulseBudget",
+                               KX_Scene,
+                               pyattr_get_sensor_pulse_budget,
+                               pyattr_set_sensor_pulse_budget),
     KX_PYATTRIBUTE_BOOL_RO("suspended", KX_Scene, m_suspend),
     KX_PYATTRIBUTE_BOOL_RO("activity_culling", KX_Scene, m_activity_culling),
     KX_PYATTRIBUTE_FLOAT_RW(
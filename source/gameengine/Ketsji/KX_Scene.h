@@ -34,6 +34,9 @@
 
 
 #include "KX_PhysicsEngineEnums.h"
+#include "KX_FrameArena.h"
+#include "BL_ActionCache.h"
+#include "KX_SceneCommandBuffer.h"
 
 #include <vector>
 #include <set>
@@ -75,6 +78,7 @@ class KX_Camera;
 class KX_FontObject;
 class KX_GameObject;
 class KX_LightObject;
+class KX_NavMeshObject;
 class RAS_MeshObject;
 class RAS_BucketManager;
 class RAS_MaterialBucket;
@@ -91,6 +95,7 @@ class KX_BlenderSceneConverter;
 struct KX_ClientObjectInfo;
 class KX_ObstacleSimulation;
 struct TaskPool;
+struct Depsgraph;
 
 /*********EEVEE INTEGRATION************/
 struct GPUTexture;
@@ -167,6 +172,17 @@ protected:
 	CListValue<KX_GameObject> *m_inactivelist;	// all objects that are not in the active layer
 	/// All animated objects, no need of CListValue because the list isn't exposed in python.
 	std::vector<KX_GameObject *> m_animatedlist;
+	/// All navigation mesh objects, updated at the end of each logic frame.
+	std::vector<KX_NavMeshObject *> m_navMeshList;
+
+	/// Temporaries of the logic frame, reset by the engine at the end of each logic frame.
+	KX_FrameArena m_frameArena;
+	/// Poses sampled from the actions played by the armatures.
+	BL_ActionCache m_actionCache;
+	/// Scene mutations of the actuators, applied at the end of the logic update.
+	KX_SceneCommandBuffer m_commandBuffer;
+	/// Transforms of the scene graph nodes created in this scene.
+	std::shared_ptr<SG_TransformStore> m_transformStore;
 
 	/// The set of cameras for this scene
 	CListValue<KX_Camera> *m_cameralist;
@@ -378,11 +394,15 @@ public:
 	void RemoveObject(KX_GameObject *gameobj);
 	void RemoveDupliGroup(KX_GameObject *gameobj);
 	void DelayedRemoveObject(KX_GameObject *gameobj);
+	/// Update the name lookup of the object lists after an object was renamed.
+	void RenameObject(KX_GameObject *gameobj, const std::string& oldname);
 
 	bool NewRemoveObject(KX_GameObject *gameobj);
 	void ReplaceMesh(KX_GameObject *gameobj, RAS_MeshObject *mesh, bool use_gfx, bool use_phys);
 
 	void AddAnimatedObject(KX_GameObject *gameobj);
+	/// Register a navigation mesh object to update its tiles and path queries every logic frame.
+	void AddNavMesh(KX_NavMeshObject *navmesh);
 
 	/**
 	 * \section Logic stuff
@@ -402,6 +422,10 @@ public:
 	CListValue<KX_LightObject> *GetLightList() const;
 
 	SCA_LogicManager *GetLogicManager() const;
+	KX_FrameArena& GetFrameArena();
+	BL_ActionCache& GetActionCache();
+	KX_SceneCommandBuffer& GetCommandBuffer();
+	const std::shared_ptr<SG_TransformStore>& GetTransformStore() const;
 
 	SCA_TimeEventManager *GetTimeEventManager() const;
 
@@ -516,6 +540,14 @@ public:
 	/// Update the mesh for objects based on level of detail settings
 	void UpdateObjectLods(KX_Camera *cam/*, const KX_CullingNodeList& nodes*/);
 
+	/** Flag the objects outside of the camera frustum or occluded as culled,
+	 * culled objects are not synchronized with the depsgraph nor drawn.
+	 */
+	void CalculateVisibleObjects(KX_Camera *cam);
+
+	/// Deform the meshes of the visible objects deformed by the game engine, see BL_SkinDeformer.
+	void UpdateSkinDeformers(Depsgraph *depsgraph);
+
 	// LoD Hysteresis functions
 	void SetLodHysteresis(bool active);
 	bool IsActivedLodHysteresis();
@@ -525,6 +557,9 @@ public:
 	// Update the activity box settings for objects in this scene, if needed.
 	void UpdateObjectActivity(void);
 
+	/// Store the object transforms before a logic frame to interpolate them at render.
+	void SavePreviousTransforms();
+
 	// Enable/disable activity culling.
 	void SetActivityCulling(bool b);
 
@@ -596,6 +631,8 @@ public:
 	static int			pyattr_set_drawing_callback(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef, PyObject *value);
 	static PyObject*	pyattr_get_gravity(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
 	static int			pyattr_set_gravity(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef, PyObject *value);
+	static PyObject*	pyattr_get_sensor_pulse_budget(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+	static int			pyattr_set_sensor_pulse_budget(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef, PyObject *value);
 	
 	/* getitem/setitem */
 	static PyMappingMethods	Mapping;
@@ -0,0 +1,170 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_SceneCommandBuffer.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_SceneCommandBuffer.h"
+#include "KX_Scene.h"
+#include "KX_GameObject.h"
+#include "SCA_AddObjectActuator.h"
+
+#include <algorithm>
+#include <functional>
+#include <tuple>
+
+KX_SceneCommandBuffer::KX_SceneCommandBuffer()
+{
+}
+
+KX_SceneCommandBuffer::~KX_SceneCommandBuffer()
+{
+}
+
+void KX_SceneCommandBuffer::Record(CommandType type, KX_GameObject *object, void *templ,
+								   SCA_AddObjectActuator *actuator, bool option1, bool option2)
+{
+	const Command command = {type, object->GetActuatorOrder(), 0, 0, object, templ, actuator, option1, option2};
+
+	m_lock.Lock();
+	m_commands.push_back(command);
+	m_lock.Unlock();
+}
+
+void KX_SceneCommandBuffer::AddObject(SCA_AddObjectActuator *actuator, KX_GameObject *owner, KX_GameObject *templ)
+{
+	Record(COMMAND_ADD_OBJECT, owner, templ, actuator, false, false);
+}
+
+void KX_SceneCommandBuffer::EndObject(KX_GameObject *gameobj)
+{
+	Record(COMMAND_END_OBJECT, gameobj, nullptr, nullptr, false, false);
+}
+
+void KX_SceneCommandBuffer::SetParent(KX_GameObject *gameobj, KX_GameObject *parent, bool addToCompound, bool ghost)
+{
+	Record(COMMAND_SET_PARENT, gameobj, parent, nullptr, addToCompound, ghost);
+}
+
+void KX_SceneCommandBuffer::RemoveParent(KX_GameObject *gameobj)
+{
+	Record(COMMAND_REMOVE_PARENT, gameobj, nullptr, nullptr, false, false);
+}
+
+void KX_SceneCommandBuffer::ReplaceMesh(KX_GameObject *gameobj, RAS_MeshObject *mesh, bool useGfx, bool usePhys)
+{
+	Record(COMMAND_REPLACE_MESH, gameobj, mesh, nullptr, useGfx, usePhys);
+}
+
+void KX_SceneCommandBuffer::UnlinkObject(KX_GameObject *gameobj)
+{
+	m_commands.erase(std::remove_if(m_commands.begin(), m_commands.end(),
+		[gameobj](const Command& command) { return (command.m_object == gameobj || command.m_template == gameobj); }),
+		m_commands.end());
+}
+
+void KX_SceneCommandBuffer::Apply(KX_Scene *scene)
+{
+	if (m_commands.empty()) {
+		return;
+	}
+
+	KX_FrameArena& arena = scene->GetFrameArena();
+
+	/* The commands recorded while applying are kept for the next call, the commands to apply
+	 * are copied in the frame arena so that the buffer keeps its capacity. */
+	const unsigned int numCommands = m_commands.size();
+	Command *commands = arena.NewArray<Command>(numCommands);
+	std::copy(m_commands.begin(), m_commands.end(), commands);
+	m_commands.clear();
+
+	/* The recording order depends on the threads of the parallel actuator update, the commands
+	 * are sorted on the update order of their object instead. The commands of an object are
+	 * recorded by a single thread in actuator priority order, so the relative recording order
+	 * of two commands of the same object is deterministic and is used to break the ties. */
+	unsigned int *indices = arena.NewArray<unsigned int>(numCommands);
+	for (unsigned int i = 0; i < numCommands; ++i) {
+		indices[i] = i;
+	}
+
+	// Group the commands by type and template, the first command of a group has the lowest order.
+	std::sort(indices, indices + numCommands, [commands](unsigned int a, unsigned int b) {
+		const Command& ca = commands[a];
+		const Command& cb = commands[b];
+		if (ca.m_type != cb.m_type) {
+			return (ca.m_type < cb.m_type);
+		}
+		if (ca.m_template != cb.m_template) {
+			return std::less<void *>()(ca.m_template, cb.m_template);
+		}
+		return std::tie(ca.m_order, a) < std::tie(cb.m_order, b);
+	});
+
+	for (unsigned int i = 0, group = 0; i < numCommands; ++i) {
+		Command& command = commands[indices[i]];
+		const Command& first = commands[indices[group]];
+		if (command.m_type != first.m_type || command.m_template != first.m_template) {
+			group = i;
+		}
+		command.m_groupOrder = commands[indices[group]].m_order;
+		command.m_group = indices[group];
+	}
+
+	std::sort(indices, indices + numCommands, [commands](unsigned int a, unsigned int b) {
+		const Command& ca = commands[a];
+		const Command& cb = commands[b];
+		return std::tie(ca.m_type, ca.m_groupOrder, ca.m_group, ca.m_order, a) <
+		       std::tie(cb.m_type, cb.m_groupOrder, cb.m_group, cb.m_order, b);
+	});
+
+	for (unsigned int i = 0; i < numCommands; ++i) {
+		const Command& command = commands[indices[i]];
+		switch (command.m_type) {
+			case COMMAND_ADD_OBJECT:
+			{
+				command.m_actuator->InstantAddObject();
+				break;
+			}
+			case COMMAND_REMOVE_PARENT:
+			{
+				command.m_object->RemoveParent();
+				break;
+			}
+			case COMMAND_SET_PARENT:
+			{
+				command.m_object->SetParent((KX_GameObject *)command.m_template, command.m_option1, command.m_option2);
+				break;
+			}
+			case COMMAND_REPLACE_MESH:
+			{
+				scene->ReplaceMesh(command.m_object, (RAS_MeshObject *)command.m_template, command.m_option1, command.m_option2);
+				break;
+			}
+			case COMMAND_END_OBJECT:
+			{
+				scene->DelayedRemoveObject(command.m_object);
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,102 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_SceneCommandBuffer.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_SCENE_COMMAND_BUFFER_H__
+#define __KX_SCENE_COMMAND_BUFFER_H__
+
+#include "CM_Thread.h"
+
+#include <vector>
+
+class KX_GameObject;
+class KX_Scene;
+class RAS_MeshObject;
+class SCA_AddObjectActuator;
+
+/** Scene mutations recorded during the logic update and applied together at the end of it.
+ * The recording is thread safe, the actuators using the buffer can be updated in parallel.
+ * The commands are applied by operation in the order of the CommandType enumeration, and
+ * the commands of an operation are grouped by template (added object, parent or mesh).
+ * The groups and the commands of a group follow the actuator update order of the objects,
+ * not the recording order, so the result doesn't depend on the thread scheduling.
+ * Each command is still applied individually, e.g. the objects added from one template
+ * are replicated and inserted in the physics one after the other.
+ */
+class KX_SceneCommandBuffer
+{
+public:
+	enum CommandType {
+		COMMAND_ADD_OBJECT = 0,
+		COMMAND_REMOVE_PARENT,
+		COMMAND_SET_PARENT,
+		COMMAND_REPLACE_MESH,
+		COMMAND_END_OBJECT
+	};
+
+private:
+	struct Command
+	{
+		CommandType m_type;
+		/// Actuator update order of the object recording the command.
+		unsigned int m_order;
+		/// Lowest order of the commands of the same type and template.
+		unsigned int m_groupOrder;
+		/// Recording index of the first command of the group with the lowest order.
+		unsigned int m_group;
+		/// The object modified by the command, the reference object for an added object.
+		KX_GameObject *m_object;
+		/// The added object, the parent or the mesh.
+		void *m_template;
+		SCA_AddObjectActuator *m_actuator;
+		bool m_option1;
+		bool m_option2;
+	};
+
+	std::vector<Command> m_commands;
+	CM_ThreadSpinLock m_lock;
+
+	void Record(CommandType type, KX_GameObject *object, void *templ, SCA_AddObjectActuator *actuator,
+				bool option1, bool option2);
+
+public:
+	KX_SceneCommandBuffer();
+	~KX_SceneCommandBuffer();
+
+	/// Add an object with the settings of an add object actuator, owner is the reference object.
+	void AddObject(SCA_AddObjectActuator *actuator, KX_GameObject *owner, KX_GameObject *templ);
+	void EndObject(KX_GameObject *gameobj);
+	void SetParent(KX_GameObject *gameobj, KX_GameObject *parent, bool addToCompound, bool ghost);
+	void RemoveParent(KX_GameObject *gameobj);
+	void ReplaceMesh(KX_GameObject *gameobj, RAS_MeshObject *mesh, bool useGfx, bool usePhys);
+
+	/// Remove the commands using an object being freed.
+	void UnlinkObject(KX_GameObject *gameobj);
+
+	/// Apply and remove all the recorded commands, called from the main thread.
+	void Apply(KX_Scene *scene);
+};
+
+#endif  // __KX_SCENE_COMMAND_BUFFER_H__
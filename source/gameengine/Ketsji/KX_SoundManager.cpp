@@ -0,0 +1,168 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_SoundManager.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_SoundManager.h"
+#include "SCA_SoundActuator.h"
+
+#ifdef WITH_AUDASPACE
+#  include <AUD_Special.h>
+#endif
+
+extern "C" {
+#  include "BKE_global.h"
+#  include "BKE_sound.h"
+}
+
+#include "DNA_sound_types.h"
+
+#include <algorithm>
+
+/// Maximum size of the decoded samples of a sound kept in memory, longer sounds are streamed.
+static const double maxDecodedSize = 16.0 * 1024.0 * 1024.0;
+
+KX_SoundManager::KX_SoundManager()
+	:m_maxVoices(0)
+{
+}
+
+KX_SoundManager::~KX_SoundManager()
+{
+#ifdef WITH_AUDASPACE
+	for (const auto& pair : m_sounds) {
+		AUD_Sound_free(pair.second);
+	}
+#endif  // WITH_AUDASPACE
+}
+
+#ifdef WITH_AUDASPACE
+AUD_Sound *KX_SoundManager::GetSound(bSound *sound, bool mono)
+{
+	const std::pair<bSound *, bool> key(sound, mono);
+	const std::map<std::pair<bSound *, bool>, AUD_Sound *>::const_iterator it = m_sounds.find(key);
+	if (it != m_sounds.end()) {
+		return it->second;
+	}
+
+	BKE_sound_load_no_assert(G_MAIN, sound);
+	AUD_Sound *source = (AUD_Sound *)sound->playback_handle;
+	if (!source) {
+		return nullptr;
+	}
+
+	// if sound shall be 3D but isn't mono, we have to make it mono!
+	AUD_Sound *result = mono ? AUD_Sound_rechannel(source, AUD_CHANNELS_MONO) : AUD_Sound_copy(source);
+
+	// The datablock caching option already keeps the samples in memory.
+	if (!(sound->flags & SOUND_FLAGS_CACHING)) {
+		const AUD_SoundInfo info = AUD_getInfo(result);
+		const double size = (double)info.length * info.specs.rate * info.specs.channels * sizeof(float);
+		if (info.length > 0.0f && size <= maxDecodedSize) {
+			AUD_Sound *cached = AUD_Sound_cache(result);
+			if (cached) {
+				AUD_Sound_free(result);
+				result = cached;
+			}
+		}
+	}
+
+	m_sounds[key] = result;
+
+	return result;
+}
+#endif  // WITH_AUDASPACE
+
+void KX_SoundManager::RemoveSound(bSound *sound)
+{
+#ifdef WITH_AUDASPACE
+	for (bool mono : {false, true}) {
+		const std::map<std::pair<bSound *, bool>, AUD_Sound *>::iterator it = m_sounds.find(std::make_pair(sound, mono));
+		if (it != m_sounds.end()) {
+			// The actuators hold their own copy of the sound.
+			AUD_Sound_free(it->second);
+			m_sounds.erase(it);
+		}
+	}
+#endif  // WITH_AUDASPACE
+}
+
+void KX_SoundManager::AddVoice(SCA_SoundActuator *actuator)
+{
+	if (std::find(m_voices.begin(), m_voices.end(), actuator) == m_voices.end()) {
+		m_voices.push_back(actuator);
+	}
+}
+
+void KX_SoundManager::RemoveVoice(SCA_SoundActuator *actuator)
+{
+	m_voices.erase(std::remove(m_voices.begin(), m_voices.end(), actuator), m_voices.end());
+}
+
+unsigned int KX_SoundManager::GetMaxVoices() const
+{
+	return m_maxVoices;
+}
+
+void KX_SoundManager::SetMaxVoices(unsigned int maxVoices)
+{
+	m_maxVoices = maxVoices;
+}
+
+void KX_SoundManager::Update(double deltatime)
+{
+	// Advance the virtual voices first, the ones reaching their end are stopped.
+	for (SCA_SoundActuator *actuator : m_voices) {
+		if (actuator->IsVirtualVoice()) {
+			actuator->UpdateVirtualVoice(deltatime);
+		}
+	}
+
+	m_voices.erase(std::remove_if(m_voices.begin(), m_voices.end(),
+		[](SCA_SoundActuator *actuator) { return !actuator->IsVoicePlaying(); }), m_voices.end());
+
+	if (m_maxVoices == 0 || m_voices.size() <= m_maxVoices) {
+		for (SCA_SoundActuator *actuator : m_voices) {
+			actuator->SetVirtualVoice(false);
+		}
+		return;
+	}
+
+	std::vector<std::pair<float, SCA_SoundActuator *> > voices;
+	voices.reserve(m_voices.size());
+	for (SCA_SoundActuator *actuator : m_voices) {
+		voices.emplace_back(actuator->GetAudibility(), actuator);
+	}
+
+	/* The most audible voices are mixed, a stable sort keeps the oldest voices
+	 * mixed when their audibility is equal. */
+	std::stable_sort(voices.begin(), voices.end(),
+		[](const std::pair<float, SCA_SoundActuator *>& a, const std::pair<float, SCA_SoundActuator *>& b) {
+			return a.first > b.first;
+		});
+
+	for (unsigned int i = 0, size = voices.size(); i < size; ++i) {
+		voices[i].second->SetVirtualVoice(i >= m_maxVoices);
+	}
+}
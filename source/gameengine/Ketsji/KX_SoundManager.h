@@ -0,0 +1,89 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_SoundManager.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_SOUND_MANAGER_H__
+#define __KX_SOUND_MANAGER_H__
+
+#ifdef WITH_AUDASPACE
+#  include <AUD_Sound.h>
+#endif
+
+#include <vector>
+#include <map>
+
+class SCA_SoundActuator;
+struct bSound;
+
+/** Sounds shared by all the sound actuators of the engine and voice budget.
+ *
+ * The samples of a sound are decoded once and shared by all the actuators using
+ * the same sound datablock, including their replicas. The playing actuators are
+ * registered as voices, when more voices than the budget are playing only the most
+ * audible ones are mixed, the others are virtual: their handle is paused and their
+ * position keeps advancing until they are audible again.
+ */
+class KX_SoundManager
+{
+private:
+#ifdef WITH_AUDASPACE
+	/// Sounds per sound datablock and per mono conversion.
+	std::map<std::pair<bSound *, bool>, AUD_Sound *> m_sounds;
+#endif  // WITH_AUDASPACE
+
+	/// All the actuators playing a sound, mixed or virtual.
+	std::vector<SCA_SoundActuator *> m_voices;
+	/// Maximum number of mixed voices, 0 for no limit.
+	unsigned int m_maxVoices;
+
+public:
+	KX_SoundManager();
+	~KX_SoundManager();
+
+#ifdef WITH_AUDASPACE
+	/** Return the shared sound of a sound datablock, decoded in memory if not too long.
+	 * The sound is owned by the manager, the users must copy it.
+	 * \param mono Convert the sound to mono, used for 3D sounds.
+	 */
+	AUD_Sound *GetSound(bSound *sound, bool mono);
+#endif  // WITH_AUDASPACE
+	/// Remove the shared sounds of a sound datablock about to be freed.
+	void RemoveSound(bSound *sound);
+
+	/// Register an actuator playing a sound, does nothing if already registered.
+	void AddVoice(SCA_SoundActuator *actuator);
+	void RemoveVoice(SCA_SoundActuator *actuator);
+
+	unsigned int GetMaxVoices() const;
+	void SetMaxVoices(unsigned int maxVoices);
+
+	/** Remove the finished voices, mix the most audible voices in the budget
+	 * and advance the virtual voices.
+	 * \param deltatime The time elapsed since the last update in seconds.
+	 */
+	void Update(double deltatime);
+};
+
+#endif  // __KX_SOUND_MANAGER_H__
@@ -116,6 +116,12 @@ public:
 	 */
 	double GetAverage();
 
+	/**
+	 * Returns the last complete measurement for the given category.
+	 * \param tc	The category.
+	 */
+	double GetLastMeasurement(TimeCategory tc);
+
 protected:
 	/// Storage for the loggers.
 	TimeLoggerMap m_loggers;
@@ -106,3 +106,12 @@ double KX_TimeLogger::GetAverage() const
 
 	return avg;
 }
+
+double KX_TimeLogger::GetLastMeasurement() const
+{
+	if (m_measurements.size() > 1) {
+		return m_measurements[1];
+	}
+
+	return 0.0;
+}
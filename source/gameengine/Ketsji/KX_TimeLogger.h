@@ -89,6 +89,12 @@ public:
 	 */
 	double GetAverage() const;
 
+	/**
+	 * Returns the last complete measurement.
+	 * \return The measurement before the current one or 0 if there is none.
+	 */
+	double GetLastMeasurement() const;
+
 protected:
 	/// Storage for the measurements.
 	std::deque<double> m_measurements;
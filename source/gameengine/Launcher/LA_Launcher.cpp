@@ -37,6 +37,7 @@
 #include "GPG_Canvas.h"
 
 #include "KX_KetsjiEngine.h"
+#include "KX_Benchmark.h"
 #include "KX_Globals.h"
 #include "KX_PythonInit.h"
 #include "KX_PythonMain.h"
@@ -56,6 +57,8 @@
 
 #include "DEV_EventConsumer.h"
 #include "DEV_InputDevice.h"
+#include "DEV_InputRecorder.h"
+#include "DEV_InputReplay.h"
 
 #include "DEV_Joystick.h"
 
@@ -63,6 +66,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "PIL_time.h"
+
 extern "C" {
 #  include "GPU_extensions.h"
 #  include "GPU_framebuffer.h"
@@ -94,6 +99,8 @@ LA_Launcher::LA_Launcher(GHOST_ISystem *system, Main *maggie, Scene *scene, Glob
 	m_kxsystem(nullptr), 
 	m_inputDevice(nullptr),
 	m_eventConsumer(nullptr),
+	m_inputRecorder(nullptr),
+	m_inputReplay(nullptr),
 	m_canvas(nullptr),
 	m_rasterizer(nullptr), 
 	m_converter(nullptr),
@@ -103,6 +110,8 @@ LA_Launcher::LA_Launcher(GHOST_ISystem *system, Main *maggie, Scene *scene, Glob
 #endif  // WITH_PYTHON
 	m_samples(samples),
 	m_stereoMode(stereoMode),
+	m_headless(false),
+	m_benchmarkFrames(0),
 	m_argc(argc),
 	m_argv(argv),
     m_context(C)
@@ -153,11 +162,17 @@ void LA_Launcher::InitEngine()
 	bool frameRate = (SYS_GetCommandLineInt(syshandle, "show_framerate", 0) != 0);
 	bool nodepwarnings = (SYS_GetCommandLineInt(syshandle, "ignore_deprecation_warnings", 1) != 0);
 	bool restrictAnimFPS = (gm.flag & GAME_RESTRICT_ANIM_UPDATES) != 0;
+	bool interpolateTransforms = (gm.flag & GAME_INTERPOLATE_TRANSFORMS) != 0;
+	m_headless = (SYS_GetCommandLineInt(syshandle, "headless", 0) != 0);
+	m_benchmarkFrames = SYS_GetCommandLineInt(syshandle, "benchmark_frames", 0);
+	m_benchmarkOutput = SYS_GetCommandLineString(syshandle, "benchmark_output", "");
 
 	const KX_KetsjiEngine::FlagType flags = (KX_KetsjiEngine::FlagType)
 		((fixed_framerate ? KX_KetsjiEngine::FIXED_FRAMERATE : 0) |
 		(frameRate ? KX_KetsjiEngine::SHOW_FRAMERATE : 0) |
 		(restrictAnimFPS ? KX_KetsjiEngine::RESTRICT_ANIMATION : 0) |
+		(interpolateTransforms ? KX_KetsjiEngine::INTERPOLATE_TRANSFORMS : 0) |
+		(m_headless ? KX_KetsjiEngine::HEADLESS : 0) |
 		(properties ? KX_KetsjiEngine::SHOW_DEBUG_PROPERTIES : 0) |
 		(profile ? KX_KetsjiEngine::SHOW_PROFILE : 0));
 
@@ -167,10 +182,12 @@ void LA_Launcher::InitEngine()
 	m_rasterizer->SetStereoMode(m_stereoMode);
 	m_rasterizer->SetEyeSeparation(m_startScene->gm.eyeseparation);
 
-	// Copy current anisotropic level to restore it at the game end.
-	m_savedData.anisotropic = m_rasterizer->GetAnisotropicFiltering();
-	// Copy current mipmap mode to restore at the game end.
-	m_savedData.mipmap = m_rasterizer->GetMipmapping();
+	if (!m_headless) {
+		// Copy current anisotropic level to restore it at the game end.
+		m_savedData.anisotropic = m_rasterizer->GetAnisotropicFiltering();
+		// Copy current mipmap mode to restore at the game end.
+		m_savedData.mipmap = m_rasterizer->GetMipmapping();
+	}
 
 	// Create the canvas, rasterizer and rendertools.
 	m_canvas = CreateCanvas(m_startScene);
@@ -198,8 +215,36 @@ void LA_Launcher::InitEngine()
 
 	// Create the inputdevices.
 	m_inputDevice = new DEV_InputDevice();
-	m_eventConsumer = new DEV_EventConsumer(m_system, m_inputDevice, m_canvas);
-	m_system->addEventConsumer(m_eventConsumer);
+	// Without GHOST system (headless) there are no window events.
+	if (m_system) {
+		m_eventConsumer = new DEV_EventConsumer(m_system, m_inputDevice, m_canvas);
+		m_system->addEventConsumer(m_eventConsumer);
+	}
+
+	/* The user inputs are still received by m_inputDevice during a replay,
+	 * only to quit the game or handle the window events. */
+	const std::string inputReplay = SYS_GetCommandLineString(syshandle, "input_replay", "");
+	const std::string inputRecord = SYS_GetCommandLineString(syshandle, "input_record", "");
+	if (!inputReplay.empty()) {
+		m_inputReplay = new DEV_InputReplay();
+		if (m_inputReplay->Load(inputReplay)) {
+			CM_Message("replaying inputs from '" << inputReplay << "'");
+		}
+		else {
+			delete m_inputReplay;
+			m_inputReplay = nullptr;
+		}
+	}
+	else if (!inputRecord.empty()) {
+		m_inputRecorder = new DEV_InputRecorder();
+		if (m_inputRecorder->Open(inputRecord)) {
+			CM_Message("recording inputs to '" << inputRecord << "'");
+		}
+		else {
+			delete m_inputRecorder;
+			m_inputRecorder = nullptr;
+		}
+	}
 
 	// Create a ketsjisystem (only needed for timing and stuff).
 	m_kxsystem = new LA_System();
@@ -211,7 +256,14 @@ void LA_Launcher::InitEngine()
 	KX_SetActiveEngine(m_ketsjiEngine);
 
 	// Set the devices.
-	m_ketsjiEngine->SetInputDevice(m_inputDevice);
+	if (m_inputReplay) {
+		m_ketsjiEngine->SetInputDevice(m_inputReplay);
+		m_ketsjiEngine->SetInputReplay(m_inputReplay);
+	}
+	else {
+		m_ketsjiEngine->SetInputDevice(m_inputDevice);
+		m_ketsjiEngine->SetInputRecorder(m_inputRecorder);
+	}
 	m_ketsjiEngine->SetCanvas(m_canvas);
 	m_ketsjiEngine->SetRasterizer(m_rasterizer);
 	m_ketsjiEngine->SetNetworkMessageManager(m_networkMessageManager);
@@ -235,7 +287,9 @@ void LA_Launcher::InitEngine()
 	// Set the global settings (carried over if restart/load new files).
 	m_ketsjiEngine->SetGlobalSettings(m_globalSettings);
 
-	m_rasterizer->Init(m_canvas);
+	if (!m_headless) {
+		m_rasterizer->Init(m_canvas);
+	}
 	InitCamera();
 
 #ifdef WITH_PYTHON
@@ -247,7 +301,7 @@ void LA_Launcher::InitEngine()
 	m_converter = new KX_BlenderConverter(m_maggie, m_ketsjiEngine);
 	m_ketsjiEngine->SetConverter(m_converter);
 
-	m_kxStartScene = new KX_Scene(m_inputDevice,
+	m_kxStartScene = new KX_Scene(m_ketsjiEngine->GetInputDevice(),
 		m_startSceneName,
 		m_startScene,
 		m_canvas,
@@ -309,11 +363,13 @@ void LA_Launcher::ExitEngine()
 		m_canvas->SetMouseState(RAS_ICanvas::MOUSE_NORMAL);
 	}
 
-	// Set anisotropic settign back to its original value.
-	m_rasterizer->SetAnisotropicFiltering(m_savedData.anisotropic);
+	if (!m_headless) {
+		// Set anisotropic settign back to its original value.
+		m_rasterizer->SetAnisotropicFiltering(m_savedData.anisotropic);
 
-	// Set mipmap setting back to its original value.
-	m_rasterizer->SetMipmapping(m_savedData.mipmap);
+		// Set mipmap setting back to its original value.
+		m_rasterizer->SetMipmapping(m_savedData.mipmap);
+	}
 
 	// Set vsync mode back to original value.
 	m_canvas->SetSwapInterval(m_savedData.vsync);
@@ -334,9 +390,18 @@ void LA_Launcher::ExitEngine()
 		delete m_inputDevice;
 		m_inputDevice = nullptr;
 	}
+	if (m_inputRecorder) {
+		delete m_inputRecorder;
+		m_inputRecorder = nullptr;
+	}
+	if (m_inputReplay) {
+		delete m_inputReplay;
+		m_inputReplay = nullptr;
+	}
 	if (m_eventConsumer) {
 		m_system->removeEventConsumer(m_eventConsumer);
 		delete m_eventConsumer;
+		m_eventConsumer = nullptr;
 	}
 	if (m_rasterizer) {
 		delete m_rasterizer;
@@ -382,12 +447,16 @@ void LA_Launcher::HandlePythonConsole()
 #endif
 
 	// Pop the console window for windows.
-	m_system->toggleConsole(1);
+	if (m_system) {
+		m_system->toggleConsole(1);
+	}
 
 	createPythonConsole();
 
 	// Hide the console window for windows.
-	m_system->toggleConsole(0);
+	if (m_system) {
+		m_system->toggleConsole(0);
+	}
 
 
 	/* As we show the console, the release events of the shortcut keys can be not handled by the engine.
@@ -423,6 +492,29 @@ void LA_Launcher::RenderEngine()
 	m_ketsjiEngine->Render();
 }
 
+void LA_Launcher::WaitNextLogicFrame()
+{
+	/* Without fixed framerate every call proceeds a logic frame,
+	 * with an external clock the time doesn't depend on the real time. */
+	if (!m_ketsjiEngine->GetFlag(KX_KetsjiEngine::FIXED_FRAMERATE) ||
+		m_ketsjiEngine->GetFlag(KX_KetsjiEngine::USE_EXTERNAL_CLOCK))
+	{
+		return;
+	}
+
+	const double timescale = m_ketsjiEngine->GetTimeScale();
+	if (timescale <= 0.0) {
+		return;
+	}
+
+	// The clock and frame times are scaled by the time scale.
+	const double delay = (m_ketsjiEngine->GetFrameTime() + timescale / m_ketsjiEngine->GetTicRate() -
+						  m_ketsjiEngine->GetClockTime()) / timescale;
+	if (delay > 0.0) {
+		PIL_sleep_ms((int)(delay * 1000.0));
+	}
+}
+
 #ifdef WITH_PYTHON
 
 bool LA_Launcher::GetPythonMainLoopCode(std::string& pythonCode, std::string& pythonFileName)
@@ -456,6 +548,12 @@ bool LA_Launcher::EngineNextFrame()
 	// Kick the engine.
 	bool renderFrame = m_ketsjiEngine->NextFrame();
 
+	/* The engine clears only the replay device, the live device used for the window events
+	 * and the exit key must be cleared at the same point of the frame. */
+	if (m_inputReplay) {
+		m_inputDevice->ClearInputs();
+	}
+
 	// First check if we want to exit.
 	m_exitRequested = m_ketsjiEngine->GetExitCode();
 	m_exitString = m_ketsjiEngine->GetExitString();
@@ -466,11 +564,18 @@ bool LA_Launcher::EngineNextFrame()
 		}
 	}
 
-	m_system->processEvents(false);
-	m_system->dispatchEvents();
+	if (m_system) {
+		m_system->processEvents(false);
+		m_system->dispatchEvents();
+	}
+
+	if (m_headless) {
+		WaitNextLogicFrame();
+	}
 
+	// The exit key can be hooked by the logic using the replayed inputs.
 	if (m_inputDevice->GetInput((SCA_IInputDevice::SCA_EnumInputs)m_ketsjiEngine->GetExitKey()).Find(SCA_InputEvent::ACTIVE) &&
-		!m_inputDevice->GetHookExitKey())
+		!m_ketsjiEngine->GetInputDevice()->GetHookExitKey())
 	{
 		m_inputDevice->ConvertEvent((SCA_IInputDevice::SCA_EnumInputs)m_ketsjiEngine->GetExitKey(), 0, 0);
 		m_exitRequested = KX_ExitRequest::BLENDER_ESC;
@@ -482,12 +587,52 @@ bool LA_Launcher::EngineNextFrame()
 		m_inputDevice->ConvertEvent(SCA_IInputDevice::WINQUIT, 0, 0);
 		m_exitRequested = KX_ExitRequest::OUTSIDE;
 	}
+	else if (m_inputReplay && m_inputReplay->IsFinished() && m_exitRequested == KX_ExitRequest::NO_REQUEST) {
+		m_exitRequested = KX_ExitRequest::QUIT_GAME;
+	}
 
 	return (m_exitRequested == KX_ExitRequest::NO_REQUEST);
 }
 
+void LA_Launcher::RunBenchmark()
+{
+	// The time is only advanced by the fixed time step to always process the same logic frames.
+	m_ketsjiEngine->SetFlag(KX_KetsjiEngine::USE_EXTERNAL_CLOCK, true);
+	const double timestep = m_ketsjiEngine->GetTimeScale() / m_ketsjiEngine->GetTicRate();
+	const double startTime = m_ketsjiEngine->GetClockTime();
+
+	CM_Message("Running benchmark for " << m_benchmarkFrames << " frames...");
+
+	m_ketsjiEngine->StartBenchmark();
+	for (int i = 1; i <= m_benchmarkFrames; ++i) {
+		m_ketsjiEngine->SetClockTime(startTime + i * timestep);
+		if (!EngineNextFrame()) {
+			CM_Warning("benchmark stopped at frame " << i);
+			break;
+		}
+	}
+
+	const KX_Benchmark *benchmark = m_ketsjiEngine->GetBenchmark();
+	if (m_benchmarkOutput.empty()) {
+		benchmark->Write(std::cout, m_maggie->name, timestep);
+	}
+	else if (benchmark->Write(m_benchmarkOutput, m_maggie->name, timestep)) {
+		CM_Message("Benchmark statistics written to '" << m_benchmarkOutput << "'");
+	}
+
+	// The benchmark run only once.
+	if (m_exitRequested == KX_ExitRequest::NO_REQUEST) {
+		m_exitRequested = KX_ExitRequest::QUIT_GAME;
+	}
+}
+
 void LA_Launcher::EngineMainLoop()
 {
+	if (m_benchmarkFrames > 0) {
+		RunBenchmark();
+		return;
+	}
+
 #ifdef WITH_PYTHON
 	std::string pythonCode;
 	std::string pythonFileName;
@@ -43,6 +43,8 @@ class KX_NetworkMessageManager;
 class RAS_ICanvas;
 class DEV_EventConsumer;
 class DEV_InputDevice;
+class DEV_InputRecorder;
+class DEV_InputReplay;
 class GHOST_ISystem;
 struct Scene;
 struct Main;
@@ -71,6 +73,10 @@ protected:
 	/// The game engine's input device abstraction.
 	DEV_InputDevice *m_inputDevice;
 	DEV_EventConsumer *m_eventConsumer;
+	/// Records the inputs of every logic frame in a file.
+	DEV_InputRecorder *m_inputRecorder;
+	/// Replays recorded inputs, used by the engine instead of m_inputDevice.
+	DEV_InputReplay *m_inputReplay;
 	/// The game engine's canvas abstraction.
 	RAS_ICanvas *m_canvas;
 	/// The rasterizer.
@@ -91,6 +97,14 @@ protected:
 	/// The render stereo mode passed in constructor.
 	RAS_Rasterizer::StereoMode m_stereoMode;
 
+	/// Run only the logic and physics, without window nor GPU context.
+	bool m_headless;
+
+	/// Number of frames to run in benchmark mode, 0 to run normally.
+	int m_benchmarkFrames;
+	/// File where the benchmark statistics are written, standard output if empty.
+	std::string m_benchmarkOutput;
+
 	/// argc and argv need to be passed on to python
 	int m_argc;
 	char **m_argv;
@@ -115,6 +129,15 @@ protected:
 
 	/// Execute engine render, overrided to render background.
 	virtual void RenderEngine();
+	/** Sleep until the next logic frame when nothing is rendered, instead of looping at full speed.
+	 * Used in headless mode to let several instances share the same machine.
+	 */
+	void WaitNextLogicFrame();
+
+	/** Run a fixed number of frames with a fixed time step independent of the real time
+	 * and write the time and memory statistics.
+	 */
+	void RunBenchmark();
 
 #ifdef WITH_PYTHON
 	/** Return true if the user use a valid python script for main loop and copy the python code
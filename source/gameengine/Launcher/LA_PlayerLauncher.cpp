@@ -128,7 +128,9 @@ void LA_PlayerLauncher::InitEngine()
 	BKE_sound_init(m_maggie);
 	LA_Launcher::InitEngine();
 
-	m_rasterizer->PrintHardwareInfo();
+	if (!m_headless) {
+		m_rasterizer->PrintHardwareInfo();
+	}
 }
 
 void LA_PlayerLauncher::ExitEngine()
@@ -139,7 +141,7 @@ void LA_PlayerLauncher::ExitEngine()
 
 bool LA_PlayerLauncher::EngineNextFrame()
 {
-	if (m_inputDevice->GetInput(SCA_IInputDevice::WINRESIZE).Find(SCA_InputEvent::ACTIVE)) {
+	if (m_mainWindow && m_inputDevice->GetInput(SCA_IInputDevice::WINRESIZE).Find(SCA_InputEvent::ACTIVE)) {
 		GHOST_Rect bnds;
 		m_mainWindow->getClientBounds(bnds);
 		m_canvas->Resize(bnds.getWidth(), bnds.getHeight());
@@ -21,6 +21,7 @@
 #endif
 
 #include "CM_Message.h"
+#include "CM_Memory.h"
 
 #include "CcdPhysicsController.h"
 #include "btBulletDynamicsCommon.h"
@@ -57,6 +58,7 @@ extern "C" {
     #include "BKE_object.h"
     #include "BKE_scene.h"
     #include "../depsgraph/DEG_depsgraph_query.h"
+	#include "BLI_hash_mm2a.h"
 }
 
 
@@ -75,7 +77,8 @@ BlenderBulletCharacterController::BlenderBulletCharacterController(CcdPhysicsCon
 	m_ctrl(ctrl),
 	m_motionState(motionState),
 	m_jumps(0),
-	m_maxJumps(1)
+	m_maxJumps(1),
+	m_batchFilterMask(0)
 {
 }
 
@@ -88,6 +91,34 @@ void BlenderBulletCharacterController::updateAction(btCollisionWorld *collisionW
 	m_motionState->setWorldTransform(getGhostObject()->getWorldTransform());
 }
 
+void BlenderBulletCharacterController::BeginBatchStep(btCollisionWorld *collisionWorld)
+{
+	if (onGround())
+		m_jumps = 0;
+
+	// The penetration recovery computes contacts with the dispatcher, which is not thread safe.
+	preStep(collisionWorld);
+
+	/* Other characters are moving in parallel, their transforms can't be read by the sweeps.
+	 * The penetration recovery above still pushes the characters apart. */
+	btBroadphaseProxy *proxy = m_ghostObject->getBroadphaseHandle();
+	m_batchFilterMask = proxy->m_collisionFilterMask;
+	proxy->m_collisionFilterMask &= ~CcdConstructionInfo::CharacterFilter;
+}
+
+void BlenderBulletCharacterController::BatchStep(btCollisionWorld *collisionWorld, btScalar dt)
+{
+	// Only the ghost object sweeps are thread safe, the world sweeps use the broadphase ray stack.
+	BLI_assert(m_useGhostObjectSweepTest);
+	playerStep(collisionWorld, dt);
+}
+
+void BlenderBulletCharacterController::EndBatchStep()
+{
+	m_ghostObject->getBroadphaseHandle()->m_collisionFilterMask = m_batchFilterMask;
+	m_motionState->setWorldTransform(getGhostObject()->getWorldTransform());
+}
+
 unsigned char BlenderBulletCharacterController::getMaxJumps() const
 {
 	return m_maxJumps;
@@ -633,10 +664,16 @@ static void DeleteBulletShape(btCollisionShape *shape, bool free)
 	if (shape->getShapeType() == SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE) {
 		/* If we use Bullet scaled shape (btScaledBvhTriangleMeshShape) we have to
 		 * free the child of the unscaled shape (btTriangleMeshShape) here.
+		 * A shared child is owned by its mesh data, only release the reference.
 		 */
-		btTriangleMeshShape *meshShape = ((btScaledBvhTriangleMeshShape *)shape)->getChildShape();
-		if (meshShape)
+		btBvhTriangleMeshShape *meshShape = ((btScaledBvhTriangleMeshShape *)shape)->getChildShape();
+		CcdShapeMeshData *meshData = CcdShapeMeshData::FromBvhShape(meshShape);
+		if (meshData)
+			meshData->ReleaseShared();
+		else if (meshShape) {
+			CM_MemoryRemove(CM_MEMORY_PHYSICS_SHAPE, CcdShapeMeshData::GetBvhShapeMemorySize(meshShape));
 			delete meshShape;
+		}
 	}
 	if (free) {
 		delete shape;
@@ -704,6 +741,34 @@ bool CcdPhysicsController::ReplaceControllerShape(btCollisionShape *newShape)
 	return true;
 }
 
+void CcdPhysicsController::SetMargin(float margin)
+{
+	if (!m_collisionShape) {
+		return;
+	}
+
+	if (m_collisionShape->getShapeType() == SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE) {
+		btScaledBvhTriangleMeshShape *scaledShape = (btScaledBvhTriangleMeshShape *)m_collisionShape;
+		btBvhTriangleMeshShape *meshShape = scaledShape->getChildShape();
+		CcdShapeMeshData *meshData = CcdShapeMeshData::FromBvhShape(meshShape);
+		if (meshData) {
+			// The child shape is shared with other objects, use the shared shape of the new margin.
+			if (meshShape->getMargin() != margin) {
+				btScaledBvhTriangleMeshShape *newShape = new btScaledBvhTriangleMeshShape(
+					meshData->GetBvhShape(margin), scaledShape->getLocalScaling());
+				newShape->setMargin(margin);
+				ReplaceControllerShape(newShape);
+			}
+			return;
+		}
+
+		// if the shape use a unscaled shape we have also to set the correct margin in it
+		meshShape->setMargin(margin);
+	}
+
+	m_collisionShape->setMargin(margin);
+}
+
 CcdPhysicsController::~CcdPhysicsController()
 {
 	//will be reference counted, due to sharing
@@ -1567,7 +1632,7 @@ void CcdPhysicsController::RemoveCompoundChild(PHY_IPhysicsController *child)
 				break;
 			}
 		}
-		delete childCtrl->m_bulletChildShape;
+		DeleteBulletShape(childCtrl->m_bulletChildShape, true);
 		childCtrl->m_bulletChildShape = nullptr;
 	}
 	// recompute inertia of parent
@@ -1768,6 +1833,189 @@ void DefaultMotionState::CalculateWorldTransformations()
 {
 }
 
+// Shared shape data
+std::multimap<unsigned int, CcdShapeMeshData *> CcdShapeMeshData::m_registry;
+CM_ThreadMutex CcdShapeMeshData::m_registryMutex;
+
+static unsigned int HashMeshData(PHY_ShapeType shapeType, const btAlignedObjectArray<btScalar>& vertexArray,
+								 const std::vector<int>& triFaceArray)
+{
+	BLI_HashMurmur2A mm2;
+	BLI_hash_mm2a_init(&mm2, 0);
+	BLI_hash_mm2a_add_int(&mm2, shapeType);
+	if (vertexArray.size() > 0) {
+		BLI_hash_mm2a_add(&mm2, (const unsigned char *)&vertexArray[0], vertexArray.size() * sizeof(btScalar));
+	}
+	if (!triFaceArray.empty()) {
+		BLI_hash_mm2a_add(&mm2, (const unsigned char *)triFaceArray.data(), triFaceArray.size() * sizeof(int));
+	}
+	return BLI_hash_mm2a_end(&mm2);
+}
+
+CcdShapeMeshData::CcdShapeMeshData(unsigned int hash, PHY_ShapeType shapeType, btAlignedObjectArray<btScalar>& vertexArray,
+								   std::vector<int>& triFaceArray)
+	:m_hash(hash),
+	m_shapeType(shapeType),
+	m_triangleIndexVertexArray(nullptr),
+	m_memorySize(0)
+{
+	// Bullet arrays can't be swapped, the vertices are copied.
+	m_vertexArray.copyFromArray(vertexArray);
+	vertexArray.clear();
+	m_triFaceArray.swap(triFaceArray);
+
+	if (m_shapeType == PHY_SHAPE_MESH) {
+		m_triangleIndexVertexArray = new btTriangleIndexVertexArray(
+		    m_triFaceArray.size() / 3,
+		    m_triFaceArray.data(),
+		    3 * sizeof(int),
+		    m_vertexArray.size() / 3,
+		    &m_vertexArray[0],
+		    3 * sizeof(btScalar));
+	}
+
+	m_memorySize = m_vertexArray.capacity() * sizeof(btScalar) + m_triFaceArray.capacity() * sizeof(int);
+	CM_MemoryAdd(CM_MEMORY_PHYSICS_SHAPE, m_memorySize);
+}
+
+CcdShapeMeshData::~CcdShapeMeshData()
+{
+	CM_MemoryRemove(CM_MEMORY_PHYSICS_SHAPE, m_memorySize);
+
+	// The first shape owns the BVH used by the others.
+	for (std::vector<btBvhTriangleMeshShape *>::reverse_iterator it = m_bvhShapes.rbegin(); it != m_bvhShapes.rend(); ++it) {
+		delete *it;
+	}
+	if (m_triangleIndexVertexArray) {
+		delete m_triangleIndexVertexArray;
+	}
+}
+
+bool CcdShapeMeshData::Equals(PHY_ShapeType shapeType, const btAlignedObjectArray<btScalar>& vertexArray,
+							  const std::vector<int>& triFaceArray) const
+{
+	if (m_shapeType != shapeType || m_vertexArray.size() != vertexArray.size() || m_triFaceArray != triFaceArray) {
+		return false;
+	}
+	return (vertexArray.size() == 0 ||
+			memcmp(&m_vertexArray[0], &vertexArray[0], vertexArray.size() * sizeof(btScalar)) == 0);
+}
+
+CcdShapeMeshData *CcdShapeMeshData::Acquire(PHY_ShapeType shapeType, btAlignedObjectArray<btScalar>& vertexArray,
+											std::vector<int>& triFaceArray)
+{
+	const unsigned int hash = HashMeshData(shapeType, vertexArray, triFaceArray);
+
+	m_registryMutex.Lock();
+
+	const std::pair<std::multimap<unsigned int, CcdShapeMeshData *>::iterator,
+					std::multimap<unsigned int, CcdShapeMeshData *>::iterator> range = m_registry.equal_range(hash);
+	for (std::multimap<unsigned int, CcdShapeMeshData *>::iterator it = range.first; it != range.second; ++it) {
+		CcdShapeMeshData *data = it->second;
+		if (data->Equals(shapeType, vertexArray, triFaceArray)) {
+			vertexArray.clear();
+			triFaceArray.clear();
+			data->AddRef();
+			m_registryMutex.Unlock();
+			return data;
+		}
+	}
+
+	CcdShapeMeshData *data = new CcdShapeMeshData(hash, shapeType, vertexArray, triFaceArray);
+	m_registry.insert(std::make_pair(hash, data));
+
+	m_registryMutex.Unlock();
+
+	return data;
+}
+
+void CcdShapeMeshData::ReleaseShared()
+{
+	m_registryMutex.Lock();
+
+	if (GetRefCount() == 1) {
+		const std::pair<std::multimap<unsigned int, CcdShapeMeshData *>::iterator,
+						std::multimap<unsigned int, CcdShapeMeshData *>::iterator> range = m_registry.equal_range(m_hash);
+		for (std::multimap<unsigned int, CcdShapeMeshData *>::iterator it = range.first; it != range.second; ++it) {
+			if (it->second == this) {
+				m_registry.erase(it);
+				break;
+			}
+		}
+	}
+	Release();
+
+	m_registryMutex.Unlock();
+}
+
+CcdShapeMeshData *CcdShapeMeshData::FromBvhShape(btCollisionShape *shape)
+{
+	return (shape) ? static_cast<CcdShapeMeshData *>(shape->getUserPointer()) : nullptr;
+}
+
+size_t CcdShapeMeshData::GetBvhShapeMemorySize(btBvhTriangleMeshShape *shape)
+{
+	btOptimizedBvh *bvh = shape->getOptimizedBvh();
+	return sizeof(btBvhTriangleMeshShape) + ((bvh) ? bvh->calculateSerializeBufferSize() : 0);
+}
+
+const btAlignedObjectArray<btScalar>& CcdShapeMeshData::GetVertexArray() const
+{
+	return m_vertexArray;
+}
+
+const std::vector<int>& CcdShapeMeshData::GetTriFaceArray() const
+{
+	return m_triFaceArray;
+}
+
+btStridingMeshInterface *CcdShapeMeshData::GetMeshInterface()
+{
+	return m_triangleIndexVertexArray;
+}
+
+btBvhTriangleMeshShape *CcdShapeMeshData::GetBvhShape(btScalar margin)
+{
+	if (!m_triangleIndexVertexArray) {
+		return nullptr;
+	}
+
+	m_registryMutex.Lock();
+
+	btBvhTriangleMeshShape *shape = nullptr;
+	for (btBvhTriangleMeshShape *bvhShape : m_bvhShapes) {
+		if (bvhShape->getMargin() == margin) {
+			shape = bvhShape;
+			break;
+		}
+	}
+
+	if (!shape) {
+		if (m_bvhShapes.empty()) {
+			shape = new btBvhTriangleMeshShape(m_triangleIndexVertexArray, true, true);
+		}
+		else {
+			// The margin doesn't change the BVH, use the one of the first shape.
+			shape = new btBvhTriangleMeshShape(m_triangleIndexVertexArray, true, false);
+			shape->setOptimizedBvh(m_bvhShapes.front()->getOptimizedBvh());
+		}
+		shape->setMargin(margin);
+		// Used by DeleteBulletShape to release the data instead of deleting the shape.
+		shape->setUserPointer(this);
+		m_bvhShapes.push_back(shape);
+
+		const size_t shapeSize = (m_bvhShapes.size() == 1) ? GetBvhShapeMemorySize(shape) : sizeof(btBvhTriangleMeshShape);
+		m_memorySize += shapeSize;
+		CM_MemoryAdd(CM_MEMORY_PHYSICS_SHAPE, shapeSize);
+	}
+
+	AddRef();
+
+	m_registryMutex.Unlock();
+
+	return shape;
+}
+
 // Shape constructor
 std::map<RAS_MeshObject *, CcdShapeConstructionInfo *> CcdShapeConstructionInfo::m_meshShapeMap;
 
@@ -1797,11 +2045,47 @@ void CcdShapeConstructionInfo::ProcessReplica()
 	m_triangleIndexVertexArray = nullptr;
 	m_forceReInstance = false;
 	m_shapeProxy = nullptr;
+	m_meshData = nullptr;
 	m_vertexArray.clear();
 	m_polygonIndexArray.clear();
 	m_triFaceArray.clear();
 	m_triFaceUVcoArray.clear();
 	m_shapeArray.clear();
+	// The copied size is accounted by the original shape info.
+	m_memorySize = 0;
+}
+
+void CcdShapeConstructionInfo::ShareMeshData()
+{
+	BLI_assert(!m_meshData);
+	m_meshData = CcdShapeMeshData::Acquire(m_shapeType, m_vertexArray, m_triFaceArray);
+	UpdateMemorySize();
+}
+
+void CcdShapeConstructionInfo::ReleaseMeshData()
+{
+	if (!m_meshData) {
+		return;
+	}
+
+	// Get back a private copy, the arrays are then free to be modified.
+	m_vertexArray.copyFromArray(m_meshData->GetVertexArray());
+	m_triFaceArray = m_meshData->GetTriFaceArray();
+
+	m_meshData->ReleaseShared();
+	m_meshData = nullptr;
+	UpdateMemorySize();
+}
+
+void CcdShapeConstructionInfo::UpdateMemorySize()
+{
+	const size_t size = m_vertexArray.capacity() * sizeof(btScalar) +
+		m_polygonIndexArray.capacity() * sizeof(int) +
+		m_triFaceArray.capacity() * sizeof(int) +
+		m_triFaceUVcoArray.capacity() * sizeof(UVco);
+
+	CM_MemoryUpdate(CM_MEMORY_PHYSICS_SHAPE, m_memorySize, size);
+	m_memorySize = size;
 }
 
 bool CcdShapeConstructionInfo::SetMesh(class KX_Scene *kxscene, RAS_MeshObject *meshobj, DerivedMesh *dm, bool polytope)
@@ -2105,6 +2389,11 @@ bool CcdShapeConstructionInfo::SetMesh(class KX_Scene *kxscene, RAS_MeshObject *
 		// triangle shape can be shared, store the mesh object in the map
 		m_meshShapeMap.insert(std::pair<RAS_MeshObject *, CcdShapeConstructionInfo *>(meshobj, this));
 	}
+
+	/* Identical geometry from other meshes or libraries shares the same arrays and BVH,
+	 * the arrays are never modified in place, SetMesh2 and UpdateMesh release them first. */
+	ShareMeshData();
+
 	return true;
 
 cleanup_empty_mesh:
@@ -2117,6 +2406,7 @@ cleanup_empty_mesh:
 	if (free_dm) {
 		dm->release(dm);
 	}
+	UpdateMemorySize();
 	return false;
 }
 
@@ -2124,6 +2414,8 @@ bool CcdShapeConstructionInfo::SetMesh2(RAS_MeshObject *meshobj, Object *ob, boo
 {
   int numpolys, numverts;
 
+  ReleaseMeshData();
+
   // assume no shape information
   // no support for dynamic change of shape yet
   BLI_assert(IsUnused());
@@ -2348,6 +2640,8 @@ bool CcdShapeConstructionInfo::SetMesh2(RAS_MeshObject *meshobj, Object *ob, boo
 		// triangle shape can be shared, store the mesh object in the map
 		m_meshShapeMap.insert(std::pair<RAS_MeshObject *, CcdShapeConstructionInfo *>(meshobj, this));
 	}
+
+	UpdateMemorySize();
 	return true;
 
 cleanup_empty_mesh:
@@ -2360,6 +2654,7 @@ cleanup_empty_mesh:
 	if (free_dm) {
 		dm->release(dm);
 	}
+	UpdateMemorySize();
 	return false;
 }
 
@@ -2392,6 +2687,9 @@ bool CcdShapeConstructionInfo::UpdateMesh(class KX_GameObject *gameobj)
 	if (m_shapeType != PHY_SHAPE_MESH)
 		return false;
 
+	// The arrays are rebuilt, stop sharing them.
+	ReleaseMeshData();
+
 	DerivedMesh *dm = CDDM_from_mesh(meshobj->GetOrigMesh());
 
 	// get the mesh from the object if not defined
@@ -2676,6 +2974,8 @@ bool CcdShapeConstructionInfo::UpdateMesh(class KX_GameObject *gameobj)
 		dm->needsFree = 1;
 		dm->release(dm);
 	}
+
+	UpdateMemorySize();
 	return true;
 }
 
@@ -2724,9 +3024,12 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin, b
 			break;
 
 		case PHY_SHAPE_POLYTOPE:
-			collisionShape = new btConvexHullShape(&m_vertexArray[0], m_vertexArray.size() / 3, 3 * sizeof(btScalar));
+		{
+			const btAlignedObjectArray<btScalar>& vertexArray = (m_meshData) ? m_meshData->GetVertexArray() : m_vertexArray;
+			collisionShape = new btConvexHullShape(&vertexArray[0], vertexArray.size() / 3, 3 * sizeof(btScalar));
 			collisionShape->setMargin(margin);
 			break;
+		}
 
 		case PHY_SHAPE_CAPSULE:
 			collisionShape = new btCapsuleShapeZ(m_radius, m_height);
@@ -2742,7 +3045,7 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin, b
 			// One possible optimization is to use directly the btBvhTriangleMeshShape when the scale is 1,1,1
 			// and btScaledBvhTriangleMeshShape otherwise.
 			if (useGimpact) {
-				if (!m_triangleIndexVertexArray || m_forceReInstance) {
+				if (!m_meshData && (!m_triangleIndexVertexArray || m_forceReInstance)) {
 					if (m_triangleIndexVertexArray)
 						delete m_triangleIndexVertexArray;
 
@@ -2756,13 +3059,18 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin, b
 					m_forceReInstance = false;
 				}
 
-				btGImpactMeshShape *gimpactShape = new btGImpactMeshShape(m_triangleIndexVertexArray);
+				btGImpactMeshShape *gimpactShape = new btGImpactMeshShape(GetMeshInterface());
 				gimpactShape->setMargin(margin);
 				gimpactShape->updateBound();
 				collisionShape = gimpactShape;
 			}
 			else {
-				if (!m_triangleIndexVertexArray || m_forceReInstance) {
+				// Welding modifies the triangles, it can't use the shared data.
+				if (m_meshData && m_weldingThreshold1 != 0.0f) {
+					ReleaseMeshData();
+				}
+
+				if (!m_meshData && (!m_triangleIndexVertexArray || m_forceReInstance)) {
 					///enable welding, only for the objects that need it (such as soft bodies)
 					if (0.0f != m_weldingThreshold1) {
 						btTriangleMesh *collisionMeshData = new btTriangleMesh(true, false);
@@ -2796,8 +3104,13 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin, b
 					m_forceReInstance = false;
 				}
 
-				btBvhTriangleMeshShape *unscaledShape = new btBvhTriangleMeshShape(m_triangleIndexVertexArray, true, useBvh);
-				unscaledShape->setMargin(margin);
+				// The BVH of shared data is built once for all the shapes.
+				btBvhTriangleMeshShape *unscaledShape = (m_meshData && useBvh) ? m_meshData->GetBvhShape(margin) : nullptr;
+				if (!unscaledShape) {
+					unscaledShape = new btBvhTriangleMeshShape(GetMeshInterface(), true, useBvh);
+					unscaledShape->setMargin(margin);
+					CM_MemoryAdd(CM_MEMORY_PHYSICS_SHAPE, CcdShapeMeshData::GetBvhShapeMemorySize(unscaledShape));
+				}
 				collisionShape = new btScaledBvhTriangleMeshShape(unscaledShape, btVector3(1.0f, 1.0f, 1.0f));
 				collisionShape->setMargin(margin);
 			}
@@ -2851,5 +3164,10 @@ CcdShapeConstructionInfo::~CcdShapeConstructionInfo()
 	if (m_shapeType == PHY_SHAPE_PROXY && m_shapeProxy != nullptr) {
 		m_shapeProxy->Release();
 	}
+	if (m_meshData) {
+		m_meshData->ReleaseShared();
+	}
+
+	CM_MemoryRemove(CM_MEMORY_PHYSICS_SHAPE, m_memorySize);
 }
 
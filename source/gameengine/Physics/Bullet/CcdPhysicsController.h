@@ -22,6 +22,7 @@
 #define __CCDPHYSICSCONTROLLER_H__
 
 #include "CM_RefCount.h"
+#include "CM_Thread.h"
 
 #include <vector>
 #include <map>
@@ -61,6 +62,59 @@ class btCollisionShape;
 #define CCD_BSB_COL_CL_SS   8 /* Cluster based soft vs soft */
 #define CCD_BSB_COL_VF_SS   16 /* Vertex/Face based soft vs soft */
 
+/** Triangle or convex hull data shared between all the shape infos with the same content,
+ * whatever the mesh, replica or library they come from. The data are registered by content hash
+ * and unregistered when the last shape info or Bullet shape using them is freed. The registry
+ * and the references are guarded by a mutex as the shapes are also created by the conversion threads.
+ */
+class CcdShapeMeshData : public CM_RefCount<CcdShapeMeshData>
+{
+private:
+	static std::multimap<unsigned int, CcdShapeMeshData *> m_registry;
+	static CM_ThreadMutex m_registryMutex;
+
+	unsigned int m_hash;
+	PHY_ShapeType m_shapeType;
+	btAlignedObjectArray<btScalar> m_vertexArray;
+	std::vector<int> m_triFaceArray;
+	btTriangleIndexVertexArray *m_triangleIndexVertexArray;
+	/** Triangle mesh shapes used as child of the scaled shapes, one per collision margin.
+	 * The BVH is built once by the first shape and shared by the others.
+	 */
+	std::vector<btBvhTriangleMeshShape *> m_bvhShapes;
+	/// The memory size of the arrays and BVH accounted in CM_MEMORY_PHYSICS_SHAPE.
+	size_t m_memorySize;
+
+	CcdShapeMeshData(unsigned int hash, PHY_ShapeType shapeType, btAlignedObjectArray<btScalar>& vertexArray,
+					 std::vector<int>& triFaceArray);
+
+	bool Equals(PHY_ShapeType shapeType, const btAlignedObjectArray<btScalar>& vertexArray,
+				const std::vector<int>& triFaceArray) const;
+
+public:
+	virtual ~CcdShapeMeshData();
+
+	/** Return the registered data equal to the arrays or register new data, in both cases
+	 * the arrays are emptied and a new reference is returned.
+	 */
+	static CcdShapeMeshData *Acquire(PHY_ShapeType shapeType, btAlignedObjectArray<btScalar>& vertexArray,
+									 std::vector<int>& triFaceArray);
+	/// Return the data owning a shape created by GetBvhShape or nullptr.
+	static CcdShapeMeshData *FromBvhShape(btCollisionShape *shape);
+	/// Return the memory size of a triangle mesh shape and its BVH.
+	static size_t GetBvhShapeMemorySize(btBvhTriangleMeshShape *shape);
+
+	const btAlignedObjectArray<btScalar>& GetVertexArray() const;
+	const std::vector<int>& GetTriFaceArray() const;
+	btStridingMeshInterface *GetMeshInterface();
+	/** Return the shared BVH triangle shape of a margin with a new reference to the data, the
+	 * reference must be released when the shape is no longer used.
+	 */
+	btBvhTriangleMeshShape *GetBvhShape(btScalar margin);
+	/// Release a reference to the data, unregister and free the data at the last reference.
+	void ReleaseShared();
+};
+
 // Shape contructor
 // It contains all the information needed to create a simple bullet shape at runtime
 class CcdShapeConstructionInfo : public CM_RefCount<CcdShapeConstructionInfo>
@@ -84,7 +138,9 @@ public:
 		m_triangleIndexVertexArray(nullptr),
 		m_forceReInstance(false),
 		m_weldingThreshold1(0.0f),
-		m_shapeProxy(nullptr)
+		m_shapeProxy(nullptr),
+		m_meshData(nullptr),
+		m_memorySize(0)
 	{
 		m_childTrans.setIdentity();
 	}
@@ -93,14 +149,14 @@ public:
 
 	bool IsUnused(void)
 	{
-		return (m_meshObject == nullptr && m_shapeArray.size() == 0 && m_shapeProxy == nullptr);
+		return (m_meshObject == nullptr && m_shapeArray.size() == 0 && m_shapeProxy == nullptr && m_meshData == nullptr);
 	}
 
 	void AddShape(CcdShapeConstructionInfo *shapeInfo);
 
 	btStridingMeshInterface *GetMeshInterface()
 	{
-		return m_triangleIndexVertexArray;
+		return (m_meshData) ? m_meshData->GetMeshInterface() : m_triangleIndexVertexArray;
 	}
 
 	CcdShapeConstructionInfo *GetChildShape(int i)
@@ -169,7 +225,8 @@ public:
 	btVector3 m_childScale;
 	void *m_userData;
 	/** Contains both vertex array for polytope shape and triangle array for concave mesh shape.
-	 * Each vertex is 3 consecutive values. In this case a triangle is made of 3 consecutive points
+	 * Each vertex is 3 consecutive values. In this case a triangle is made of 3 consecutive points.
+	 * Empty when the data are shared in m_meshData.
 	 */
 	btAlignedObjectArray<btScalar> m_vertexArray;
 	/** Contains the array of polygon index in the original mesh that correspond to shape triangles.
@@ -177,7 +234,7 @@ public:
 	 */
 	std::vector<int> m_polygonIndexArray;
 
-	/// Contains an array of triplets of face indices quads turn into 2 tris
+	/// Contains an array of triplets of face indices quads turn into 2 tris, empty when shared in m_meshData.
 	std::vector<int> m_triFaceArray;
 
 	/// Contains an array of pair of UV coordinate for each vertex of faces quads turn into 2 tris
@@ -201,6 +258,17 @@ protected:
 	float m_weldingThreshold1;
 	/// only used for PHY_SHAPE_PROXY, pointer to actual shape info
 	CcdShapeConstructionInfo *m_shapeProxy;
+	/// Vertex and triangle data shared by content with other shape infos.
+	CcdShapeMeshData *m_meshData;
+	/// The memory size of the private arrays accounted in CM_MEMORY_PHYSICS_SHAPE.
+	size_t m_memorySize;
+
+	/// Move the vertex and triangle arrays into the shared data registry.
+	void ShareMeshData();
+	/// Stop using the shared data before the arrays are rebuilt.
+	void ReleaseMeshData();
+	/// Update the accounted memory size with the capacity of the private arrays.
+	void UpdateMemorySize();
 };
 
 struct CcdConstructionInfo {
@@ -442,12 +510,22 @@ private:
 	btMotionState *m_motionState;
 	unsigned char m_jumps;
 	unsigned char m_maxJumps;
+	/// Broadphase filter mask of the ghost object restored by EndBatchStep().
+	short int m_batchFilterMask;
 
 public:
 	BlenderBulletCharacterController(CcdPhysicsController *ctrl, btMotionState *motionState, btPairCachingGhostObject *ghost, btConvexShape *shape, float stepHeight);
 
 	virtual void updateAction(btCollisionWorld *collisionWorld, btScalar dt);
 
+	/** Batched update, see CcdPhysicsEnvironment::UpdateCharacters().
+	 * BeginBatchStep and EndBatchStep must be called on the main thread,
+	 * BatchStep can be called from a worker thread between them.
+	 */
+	void BeginBatchStep(btCollisionWorld *collisionWorld);
+	void BatchStep(btCollisionWorld *collisionWorld, btScalar dt);
+	void EndBatchStep();
+
 	unsigned char getMaxJumps() const;
 
 	void setMaxJumps(unsigned char maxJumps);
@@ -731,15 +809,7 @@ public:
 	virtual void CalcXform()
 	{
 	}
-	virtual void SetMargin(float margin)
-	{
-		if (m_collisionShape) {
-			m_collisionShape->setMargin(margin);
-			// if the shape use a unscaled shape we have also to set the correct margin in it
-			if (m_collisionShape->getShapeType() == SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE)
-				((btScaledBvhTriangleMeshShape *)m_collisionShape)->getChildShape()->setMargin(margin);
-		}
-	}
+	virtual void SetMargin(float margin);
 	virtual float GetMargin() const
 	{
 		return (m_collisionShape) ? m_collisionShape->getMargin() : 0.0f;
@@ -53,11 +53,15 @@
 
 extern "C" {
 	#include "BLI_utildefines.h"
+	#include "BLI_task.h"
 	#include "BKE_object.h"
 }
 
 #define CCD_CONSTRAINT_DISABLE_LINKED_COLLISION 0x80
 
+// Minimum number of batched characters to step them on the task scheduler.
+#define CCD_PARALLEL_CHARACTERS 16
+
 #include "BulletDynamics/Vehicle/btRaycastVehicle.h"
 #include "BulletDynamics/Vehicle/btVehicleRaycaster.h"
 #include "BulletDynamics/Vehicle/btWheelInfo.h"
@@ -378,6 +382,28 @@ public:
 	virtual bool needBroadphaseCollision(btBroadphaseProxy *proxy0, btBroadphaseProxy *proxy1) const;
 };
 
+/// Action stepping all the batched character controllers of an environment.
+class CcdCharacterBatch : public btActionInterface
+{
+private:
+	CcdPhysicsEnvironment *m_physEnv;
+
+public:
+	CcdCharacterBatch(CcdPhysicsEnvironment *env)
+		:m_physEnv(env)
+	{
+	}
+
+	virtual void updateAction(btCollisionWorld *collisionWorld, btScalar deltaTimeStep)
+	{
+		m_physEnv->UpdateCharacters(collisionWorld, deltaTimeStep);
+	}
+
+	virtual void debugDraw(btIDebugDraw *debugDrawer)
+	{
+	}
+};
+
 
 void CcdPhysicsEnvironment::SetDebugDrawer(btIDebugDraw *debugDrawer)
 {
@@ -397,6 +423,7 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(bool useDbvtCulling, btDispatcher *
 	m_linearDeactivationThreshold(0.8f),
 	m_angularDeactivationThreshold(1.0f),
 	m_contactBreakingThreshold(0.02f),
+	m_characterBatch(nullptr),
 	m_solver(nullptr),
 	m_ownPairCache(nullptr),
 	m_filterCallback(nullptr),
@@ -485,7 +512,7 @@ void CcdPhysicsEnvironment::AddCcdPhysicsController(CcdPhysicsController *ctrl)
 				m_dynamicsWorld->addCollisionObject(obj, ctrl->GetCollisionFilterGroup(), ctrl->GetCollisionFilterMask());
 			}
 			if (ctrl->GetCharacterController()) {
-				m_dynamicsWorld->addAction(ctrl->GetCharacterController());
+				AddCharacter(static_cast<BlenderBulletCharacterController *>(ctrl->GetCharacterController()));
 			}
 		}
 	}
@@ -602,7 +629,7 @@ bool CcdPhysicsEnvironment::RemoveCcdPhysicsController(CcdPhysicsController *ctr
 			m_dynamicsWorld->removeCollisionObject(ctrl->GetCollisionObject());
 
 			if (ctrl->GetCharacterController()) {
-				m_dynamicsWorld->removeAction(ctrl->GetCharacterController());
+				RemoveCharacter(static_cast<BlenderBulletCharacterController *>(ctrl->GetCharacterController()));
 			}
 		}
 	}
@@ -992,6 +1019,101 @@ void CcdPhysicsEnvironment::SetUseEpa(bool epa)
 	//gUseEpa = epa;
 }
 
+void CcdPhysicsEnvironment::SetCharacterBatching(bool batching)
+{
+	if (batching == (m_characterBatch != nullptr)) {
+		return;
+	}
+
+	// Move the characters already in the world between their own actions and the batch.
+	std::vector<BlenderBulletCharacterController *> characters;
+	for (CcdPhysicsController *ctrl : m_controllers) {
+		btKinematicCharacterController *character = ctrl->GetCharacterController();
+		if (character && !ctrl->GetSoftBody()) {
+			characters.push_back(static_cast<BlenderBulletCharacterController *>(character));
+		}
+	}
+
+	for (BlenderBulletCharacterController *character : characters) {
+		RemoveCharacter(character);
+	}
+
+	if (batching) {
+		m_characterBatch = new CcdCharacterBatch(this);
+		m_dynamicsWorld->addAction(m_characterBatch);
+	}
+	else {
+		m_dynamicsWorld->removeAction(m_characterBatch);
+		delete m_characterBatch;
+		m_characterBatch = nullptr;
+	}
+
+	for (BlenderBulletCharacterController *character : characters) {
+		AddCharacter(character);
+	}
+}
+
+void CcdPhysicsEnvironment::AddCharacter(BlenderBulletCharacterController *character)
+{
+	if (m_characterBatch) {
+		m_batchedCharacters.push_back(character);
+	}
+	else {
+		m_dynamicsWorld->addAction(character);
+	}
+}
+
+void CcdPhysicsEnvironment::RemoveCharacter(BlenderBulletCharacterController *character)
+{
+	if (m_characterBatch) {
+		std::vector<BlenderBulletCharacterController *>::iterator it =
+			std::find(m_batchedCharacters.begin(), m_batchedCharacters.end(), character);
+		if (it != m_batchedCharacters.end()) {
+			// The order of the characters doesn't matter.
+			*it = m_batchedCharacters.back();
+			m_batchedCharacters.pop_back();
+		}
+	}
+	else {
+		m_dynamicsWorld->removeAction(character);
+	}
+}
+
+struct CcdCharacterTaskData
+{
+	BlenderBulletCharacterController **characters;
+	btCollisionWorld *collisionWorld;
+	btScalar timeStep;
+};
+
+static void CharacterStepTask(void *__restrict userdata, const int iter, const TaskParallelTLS *__restrict UNUSED(tls))
+{
+	CcdCharacterTaskData *data = static_cast<CcdCharacterTaskData *>(userdata);
+	data->characters[iter]->BatchStep(data->collisionWorld, data->timeStep);
+}
+
+void CcdPhysicsEnvironment::UpdateCharacters(btCollisionWorld *collisionWorld, btScalar timeStep)
+{
+	if (m_batchedCharacters.empty()) {
+		return;
+	}
+
+	for (BlenderBulletCharacterController *character : m_batchedCharacters) {
+		character->BeginBatchStep(collisionWorld);
+	}
+
+	CcdCharacterTaskData data = {m_batchedCharacters.data(), collisionWorld, timeStep};
+
+	TaskParallelSettings settings;
+	BLI_parallel_range_settings_defaults(&settings);
+	settings.use_threading = (m_batchedCharacters.size() >= CCD_PARALLEL_CHARACTERS);
+	BLI_task_parallel_range(0, m_batchedCharacters.size(), &data, CharacterStepTask, &settings);
+
+	for (BlenderBulletCharacterController *character : m_batchedCharacters) {
+		character->EndBatchStep();
+	}
+}
+
 void CcdPhysicsEnvironment::SetSolverType(int solverType)
 {
 	switch (solverType)
@@ -1303,6 +1425,15 @@ struct OcclusionBuffer {
 			}
 			return false;
 		}
+		// branch free so that the compiler can vectorize it
+		static inline bool ProcessSpan(btScalar *scan, int lo, int hi, btScalar v, btScalar dz)
+		{
+			for (int ix = lo; ix < hi; ++ix) {
+				const btScalar z = v + dz * (ix - lo);
+				scan[ix] = (scan[ix] < z) ? z : scan[ix];
+			}
+			return false;
+		}
 		static inline void Occlusion(bool &flag)
 		{
 			flag = true;
@@ -1314,11 +1445,35 @@ struct OcclusionBuffer {
 		{
 			return (q <= v);
 		}
+		static inline bool ProcessSpan(const btScalar *scan, int lo, int hi, btScalar v, btScalar dz)
+		{
+			for (int ix = lo; ix < hi; ++ix) {
+				if (scan[ix] <= v + dz * (ix - lo)) {
+					return true;
+				}
+			}
+			return false;
+		}
 		static inline void Occlusion(bool &flag)
 		{
 		}
 	};
 
+	// triangle in buffer coordinates
+	struct Triangle {
+		int x[3];
+		int y[3];
+		btScalar z[3];
+		// clamped bounds
+		int mix, mxx;
+		int miy, mxy;
+	};
+
+	// number of buffer rows written by one task
+	static const int BAND_ROWS = 16;
+	// occluders with less triangles are written on the calling thread
+	static const unsigned int PARALLEL_TRIANGLES = 256;
+
 	btScalar *m_buffer;
 	size_t m_bufferSize;
 	bool m_initialized;
@@ -1328,6 +1483,8 @@ struct OcclusionBuffer {
 	btScalar m_offsets[2];
 	btScalar m_wtc[16]; // world to clip transform
 	btScalar m_mtc[16]; // model to clip transform
+	// triangles of the current occluder waiting for flushOccluder()
+	std::vector<Triangle> m_triangles;
 	// constructor: size=largest dimension of the buffer.
 	// Buffer size depends on aspect ratio
 	OcclusionBuffer()
@@ -1520,44 +1677,76 @@ struct OcclusionBuffer {
 		}
 		return ni;
 	}
-	// write or check a triangle to buffer. a,b,c in device coordinates (-1,+1)
-	template <typename POLICY>
-	inline bool draw(const btVector4 &a,
-	                 const btVector4 &b,
-	                 const btVector4 &c,
-	                 const float face,
-	                 const btScalar minarea)
+	// convert a triangle in device coordinates (-1,+1) to buffer coordinates,
+	// return false if the triangle is back facing or too small
+	inline bool setup(const btVector4 &a,
+	                  const btVector4 &b,
+	                  const btVector4 &c,
+	                  const float face,
+	                  const btScalar minarea,
+	                  Triangle &tri) const
 	{
 		const btScalar a2 = btCross(b - a, c - a)[2];
 		if ((face * a2) < 0.0f || btFabs(a2) < minarea) {
 			return false;
 		}
-		// further down we are normally going to write to the Zbuffer, mark it so
-		POLICY::Occlusion(m_occlusion);
 
-		int x[3], y[3], ib = 1, ic = 2;
-		btScalar z[3];
-		x[0] = (int)(a.x() * m_scales[0] + m_offsets[0]);
-		y[0] = (int)(a.y() * m_scales[1] + m_offsets[1]);
-		z[0] = a.z();
+		int ib = 1, ic = 2;
+		tri.x[0] = (int)(a.x() * m_scales[0] + m_offsets[0]);
+		tri.y[0] = (int)(a.y() * m_scales[1] + m_offsets[1]);
+		tri.z[0] = a.z();
 		if (a2 < 0.f) {
 			// negative aire is possible with double face => must
 			// change the order of b and c otherwise the algorithm doesn't work
 			ib = 2;
 			ic = 1;
 		}
-		x[ib] = (int)(b.x() * m_scales[0] + m_offsets[0]);
-		x[ic] = (int)(c.x() * m_scales[0] + m_offsets[0]);
-		y[ib] = (int)(b.y() * m_scales[1] + m_offsets[1]);
-		y[ic] = (int)(c.y() * m_scales[1] + m_offsets[1]);
-		z[ib] = b.z();
-		z[ic] = c.z();
-		const int mix = btMax(0, btMin(x[0], btMin(x[1], x[2])));
-		const int mxx = btMin(m_sizes[0], 1 + btMax(x[0], btMax(x[1], x[2])));
-		const int miy = btMax(0, btMin(y[0], btMin(y[1], y[2])));
-		const int mxy = btMin(m_sizes[1], 1 + btMax(y[0], btMax(y[1], y[2])));
+		tri.x[ib] = (int)(b.x() * m_scales[0] + m_offsets[0]);
+		tri.x[ic] = (int)(c.x() * m_scales[0] + m_offsets[0]);
+		tri.y[ib] = (int)(b.y() * m_scales[1] + m_offsets[1]);
+		tri.y[ic] = (int)(c.y() * m_scales[1] + m_offsets[1]);
+		tri.z[ib] = b.z();
+		tri.z[ic] = c.z();
+		tri.mix = btMax(0, btMin(tri.x[0], btMin(tri.x[1], tri.x[2])));
+		tri.mxx = btMin(m_sizes[0], 1 + btMax(tri.x[0], btMax(tri.x[1], tri.x[2])));
+		tri.miy = btMax(0, btMin(tri.y[0], btMin(tri.y[1], tri.y[2])));
+		tri.mxy = btMin(m_sizes[1], 1 + btMax(tri.y[0], btMax(tri.y[1], tri.y[2])));
+		return true;
+	}
+	// true if the triangle is rasterized with the edge functions and can be split by rows
+	static inline bool isGeneral(const Triangle &tri)
+	{
+		return ((tri.mxx - tri.mix) > 1 && (tri.mxy - tri.miy) > 1);
+	}
+	// restrict [lo, hi) to the pixels where the edge function c + dx * (ix - mix) is positive
+	static inline void edgeSpan(int c, int dx, int mix, int &lo, int &hi)
+	{
+		if (dx > 0) {
+			if (c < 0) {
+				lo = btMax(lo, mix + (dx - 1 - c) / dx);
+			}
+		}
+		else if (c < 0) {
+			hi = lo;
+		}
+		else if (dx < 0) {
+			hi = btMin(hi, mix + c / -dx + 1);
+		}
+	}
+	// write or check a triangle to the buffer rows [rowMin, rowMax)
+	// degenerated triangles must be processed with all the rows
+	template <typename POLICY>
+	inline bool raster(const Triangle &tri, int rowMin, int rowMax)
+	{
+		int x[3] = {tri.x[0], tri.x[1], tri.x[2]};
+		int y[3] = {tri.y[0], tri.y[1], tri.y[2]};
+		btScalar z[3] = {tri.z[0], tri.z[1], tri.z[2]};
+		const int mix = tri.mix;
+		const int mxx = tri.mxx;
+		const int miy = btMax(tri.miy, rowMin);
+		const int mxy = btMin(tri.mxy, rowMax);
 		const int width = mxx - mix;
-		const int height = mxy - miy;
+		const int height = tri.mxy - tri.miy;
 		if ((width * height) <= 1) {
 			// degenerated in at most one single pixel
 			btScalar *scan = &m_buffer[miy * m_sizes[0] + mix];
@@ -1706,17 +1895,18 @@ struct OcclusionBuffer {
 			}
 		}
 		else {
-			// general case
+			// general case, the edge functions give the covered span of each row
+			// which is then processed in one linear loop
 			const int dx[] = {y[0] - y[1],
 				              y[1] - y[2],
 				              y[2] - y[0]};
-			const int dy[] = {x[1] - x[0] - dx[0] * width,
-				              x[2] - x[1] - dx[1] * width,
-				              x[0] - x[2] - dx[2] * width};
+			const int dy[] = {x[1] - x[0],
+				              x[2] - x[1],
+				              x[0] - x[2]};
 			const int a = x[2] * y[0] + x[0] * y[1] - x[2] * y[1] - x[0] * y[2] + x[1] * y[2] - x[1] * y[0];
 			const btScalar ia = 1 / (btScalar)a;
 			const btScalar dzx = ia * (y[2] * (z[1] - z[0]) + y[1] * (z[0] - z[2]) + y[0] * (z[2] - z[1]));
-			const btScalar dzy = ia * (x[2] * (z[0] - z[1]) + x[0] * (z[1] - z[2]) + x[1] * (z[2] - z[0])) - (dzx * width);
+			const btScalar dzy = ia * (x[2] * (z[0] - z[1]) + x[0] * (z[1] - z[2]) + x[1] * (z[2] - z[0]));
 			int c[] = {miy *x[1] + mix * y[0] - x[1] * y[0] - mix * y[1] + x[0] * y[1] - miy * x[0],
 				miy *x[2] + mix * y[1] - x[2] * y[1] - mix * y[2] + x[1] * y[2] - miy * x[1],
 				miy *x[0] + mix * y[2] - x[0] * y[2] - mix * y[0] + x[2] * y[0] - miy * x[2]};
@@ -1724,13 +1914,13 @@ struct OcclusionBuffer {
 			btScalar *scan = &m_buffer[miy * m_sizes[0]];
 
 			for (int iy = miy; iy < mxy; ++iy) {
-				for (int ix = mix; ix < mxx; ++ix) {
-					if ((c[0] >= 0) && (c[1] >= 0) && (c[2] >= 0)) {
-						if (POLICY::Process(scan[ix], v)) {
-							return true;
-						}
-					}
-					c[0] += dx[0]; c[1] += dx[1]; c[2] += dx[2]; v += dzx;
+				int lo = mix;
+				int hi = mxx;
+				edgeSpan(c[0], dx[0], mix, lo, hi);
+				edgeSpan(c[1], dx[1], mix, lo, hi);
+				edgeSpan(c[2], dx[2], mix, lo, hi);
+				if (lo < hi && POLICY::ProcessSpan(scan, lo, hi, v + dzx * (lo - mix), dzx)) {
+					return true;
 				}
 				c[0] += dy[0]; c[1] += dy[1]; c[2] += dy[2]; v += dzy;
 				scan += m_sizes[0];
@@ -1738,6 +1928,22 @@ struct OcclusionBuffer {
 		}
 		return false;
 	}
+	// write or check a triangle to buffer. a,b,c in device coordinates (-1,+1)
+	template <typename POLICY>
+	inline bool draw(const btVector4 &a,
+	                 const btVector4 &b,
+	                 const btVector4 &c,
+	                 const float face,
+	                 const btScalar minarea)
+	{
+		Triangle tri;
+		if (!setup(a, b, c, face, minarea, tri)) {
+			return false;
+		}
+		// further down we are normally going to write to the Zbuffer, mark it so
+		POLICY::Occlusion(m_occlusion);
+		return raster<POLICY>(tri, 0, m_sizes[1]);
+	}
 	// clip than write or check a polygon
 	template <const int NP, typename POLICY>
 	inline bool clipDraw(const btVector4 *p,
@@ -1755,6 +1961,22 @@ struct OcclusionBuffer {
 		}
 		return earlyexit;
 	}
+	// clip a polygon and queue its triangles for the next flushOccluder()
+	template <const int NP>
+	inline void clipAppend(const btVector4 *p, const float face)
+	{
+		btVector4 o[NP * 2];
+		int n = clip<NP>(p, o);
+		if (n) {
+			project(o, n);
+			Triangle tri;
+			for (int i = 2; i < n; ++i) {
+				if (setup(o[0], o[i - 1], o[i], face, btScalar(0.0f), tri)) {
+					m_triangles.push_back(tri);
+				}
+			}
+		}
+	}
 	// add a triangle (in model coordinate)
 	// face =  0.f if face is double side,
 	//      =  1.f if face is single sided and scale is positive
@@ -1768,7 +1990,7 @@ struct OcclusionBuffer {
 		transformM(a, p[0]);
 		transformM(b, p[1]);
 		transformM(c, p[2]);
-		clipDraw<3, WriteOCL>(p, face, btScalar(0.0f));
+		clipAppend<3>(p, face);
 	}
 	// add a quad (in model coordinate)
 	void appendOccluderM(const float *a,
@@ -1782,7 +2004,43 @@ struct OcclusionBuffer {
 		transformM(b, p[1]);
 		transformM(c, p[2]);
 		transformM(d, p[3]);
-		clipDraw<4, WriteOCL>(p, face, btScalar(0.0f));
+		clipAppend<4>(p, face);
+	}
+	// write the rows [iter * BAND_ROWS, (iter + 1) * BAND_ROWS) of the queued triangles
+	static void rasterBand(void *__restrict userdata, const int iter, const TaskParallelTLS *__restrict UNUSED(tls))
+	{
+		OcclusionBuffer *ocb = static_cast<OcclusionBuffer *>(userdata);
+		const int rowMin = iter * BAND_ROWS;
+		const int rowMax = btMin(rowMin + BAND_ROWS, ocb->m_sizes[1]);
+		for (const Triangle &tri : ocb->m_triangles) {
+			if (tri.miy < rowMax && tri.mxy > rowMin && isGeneral(tri)) {
+				ocb->raster<WriteOCL>(tri, rowMin, rowMax);
+			}
+		}
+	}
+	// write the triangles queued by appendOccluderM() to the buffer.
+	// Each band of rows is owned by one task, so the buffer is written without locks.
+	void flushOccluder()
+	{
+		if (m_triangles.empty()) {
+			return;
+		}
+		m_occlusion = true;
+
+		TaskParallelSettings settings;
+		BLI_parallel_range_settings_defaults(&settings);
+		settings.use_threading = (m_triangles.size() >= PARALLEL_TRIANGLES);
+		settings.min_iter_per_thread = 1;
+		BLI_task_parallel_range(0, (m_sizes[1] + BAND_ROWS - 1) / BAND_ROWS, this, rasterBand, &settings);
+
+		// the degenerated triangles can't be split by rows, the depth test is
+		// order independent so they are written after the bands
+		for (const Triangle &tri : m_triangles) {
+			if (!isGeneral(tri)) {
+				raster<WriteOCL>(tri, 0, m_sizes[1]);
+			}
+		}
+		m_triangles.clear();
 	}
 	// query occluder for a box (c=center, e=extend) in world coordinate
 	inline bool queryOccluderW(const btVector3 &c,
@@ -1891,6 +2149,7 @@ struct  DbvtCullingCallback : btDbvt::ICollide {
 						}
 					}
 				}
+				m_ocb->flushOccluder();
 			}
 		}
 		if (info)
@@ -1928,6 +2187,14 @@ bool CcdPhysicsEnvironment::CullingTest(PHY_CullingCallback callback, void *user
 	return true;
 }
 
+PHY_IGraphicController *CcdPhysicsEnvironment::CreateGraphicController(PHY_IMotionState *motionState)
+{
+	if (!m_cullingTree) {
+		return nullptr;
+	}
+	return new CcdGraphicController(this, motionState);
+}
+
 int CcdPhysicsEnvironment::GetNumContactPoints()
 {
 	return 0;
@@ -1995,6 +2262,9 @@ CcdPhysicsEnvironment::~CcdPhysicsEnvironment()
 	if (nullptr != m_ghostPairCallback)
 		delete m_ghostPairCallback;
 
+	if (nullptr != m_characterBatch)
+		delete m_characterBatch;
+
 	if (nullptr != m_collisionConfiguration)
 		delete m_collisionConfiguration;
 
@@ -2063,6 +2333,9 @@ void CcdPhysicsEnvironment::CallbackTriggers()
 	//walk over all overlapping pairs, and if one of the involved bodies is registered for trigger callback, perform callback
 	btDispatcher *dispatcher = m_dynamicsWorld->getDispatcher();
 	int numManifolds = dispatcher->getNumManifolds();
+	// Reserve all the contact data at once, the pointers given to the callback must stay valid.
+	m_collData.clear();
+	m_collData.reserve(numManifolds);
 	for (int i = 0; i < numManifolds; i++) {
 		bool colliding_ctrl0 = true;
 		btPersistentManifold *manifold = dispatcher->getManifoldByIndexInternal(i);
@@ -2099,7 +2372,8 @@ void CcdPhysicsEnvironment::CallbackTriggers()
 		}
 
 		if (usecallback) {
-			const CcdCollData *coll_data = new CcdCollData(manifold);
+			m_collData.emplace_back(manifold);
+			const CcdCollData *coll_data = &m_collData.back();
 
 			m_triggerCallbacks[PHY_OBJECT_RESPONSE](m_triggerCallbacksUserPtrs[PHY_OBJECT_RESPONSE],
 				colliding_ctrl0 ? ctrl0 : ctrl1, colliding_ctrl0 ? ctrl1 : ctrl0, coll_data);
@@ -2573,6 +2847,79 @@ PHY_IPhysicsController *CcdPhysicsEnvironment::CreateConeController(float conera
 	return sphereController;
 }
 
+struct SensorContactResultCallback : public btCollisionWorld::ContactResultCallback
+{
+	CcdPhysicsController *m_sensorCtrl;
+	PHY_ResponseCallback m_broadphaseCallback;
+	void *m_broadphaseUserData;
+	std::vector<PHY_IPhysicsController *>& m_controllers;
+
+	SensorContactResultCallback(CcdPhysicsController *sensorCtrl, PHY_ResponseCallback broadphaseCallback,
+	                            void *broadphaseUserData, std::vector<PHY_IPhysicsController *>& controllers)
+		:m_sensorCtrl(sensorCtrl),
+		m_broadphaseCallback(broadphaseCallback),
+		m_broadphaseUserData(broadphaseUserData),
+		m_controllers(controllers)
+	{
+		m_collisionFilterGroup = sensorCtrl->GetCollisionFilterGroup();
+		m_collisionFilterMask = sensorCtrl->GetCollisionFilterMask();
+	}
+
+	virtual ~SensorContactResultCallback()
+	{
+	}
+
+	// Same filtering as CcdOverlapFilterCallBack::needBroadphaseCollision for a sensor object.
+	virtual bool needsCollision(btBroadphaseProxy *proxy0) const
+	{
+		if (!ContactResultCallback::needsCollision(proxy0)) {
+			return false;
+		}
+
+		btCollisionObject *object = (btCollisionObject *)proxy0->m_clientObject;
+		CcdPhysicsController *objCtrl = static_cast<CcdPhysicsController *>(object->getUserPointer());
+		if (!objCtrl || objCtrl == m_sensorCtrl) {
+			return false;
+		}
+
+		KX_GameObject *kxObj0 = KX_GameObject::GetClientObject((KX_ClientObjectInfo *)m_sensorCtrl->GetNewClientInfo());
+		KX_GameObject *kxObj1 = KX_GameObject::GetClientObject((KX_ClientObjectInfo *)objCtrl->GetNewClientInfo());
+		if (kxObj0 && kxObj1 && !(kxObj0->CheckCollision(kxObj1) && kxObj1->CheckCollision(kxObj0))) {
+			return false;
+		}
+
+		if (m_broadphaseCallback) {
+			return m_broadphaseCallback(m_broadphaseUserData, m_sensorCtrl, objCtrl, nullptr);
+		}
+		return true;
+	}
+
+	virtual btScalar addSingleResult(btManifoldPoint& cp, const btCollisionObjectWrapper *colObj0Wrap, int partId0, int index0,
+	                                 const btCollisionObjectWrapper *colObj1Wrap, int partId1, int index1)
+	{
+		const btCollisionObject *object = colObj0Wrap->getCollisionObject();
+		if (object == m_sensorCtrl->GetCollisionObject()) {
+			object = colObj1Wrap->getCollisionObject();
+		}
+
+		// Several contact points are reported per object, only the last object is checked for duplicates.
+		PHY_IPhysicsController *ctrl = static_cast<CcdPhysicsController *>(object->getUserPointer());
+		if (m_controllers.empty() || m_controllers.back() != ctrl) {
+			m_controllers.push_back(ctrl);
+		}
+		return 0.0f;
+	}
+};
+
+void CcdPhysicsEnvironment::ContactTest(PHY_IPhysicsController *ctrl, std::vector<PHY_IPhysicsController *>& controllers)
+{
+	CcdPhysicsController *sensorCtrl = static_cast<CcdPhysicsController *>(ctrl);
+	SensorContactResultCallback callback(sensorCtrl, m_triggerCallbacks[PHY_BROADPH_RESPONSE],
+	                                     m_triggerCallbacksUserPtrs[PHY_BROADPH_RESPONSE], controllers);
+	// The query only visits the objects overlapping the bounding box of the sensor in the broadphase tree.
+	m_dynamicsWorld->contactTest(sensorCtrl->GetCollisionObject(), callback);
+}
+
 float CcdPhysicsEnvironment::getAppliedImpulse(int constraintid)
 {
 	// For soft body constraints
@@ -2658,11 +3005,12 @@ struct BlenderDebugDraw : public btIDebugDraw
 
 CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool visualizePhysics)
 {
-	CcdPhysicsEnvironment *ccdPhysEnv = new CcdPhysicsEnvironment(false);
+	CcdPhysicsEnvironment *ccdPhysEnv = new CcdPhysicsEnvironment((blenderscene->gm.flag & GAME_USE_CULLING) != 0);
 	ccdPhysEnv->SetDebugDrawer(new BlenderDebugDraw());
 	ccdPhysEnv->SetDeactivationLinearTreshold(blenderscene->gm.lineardeactthreshold);
 	ccdPhysEnv->SetDeactivationAngularTreshold(blenderscene->gm.angulardeactthreshold);
 	ccdPhysEnv->SetDeactivationTime(blenderscene->gm.deactivationtime);
+	ccdPhysEnv->SetCharacterBatching((blenderscene->gm.flag & GAME_BATCH_CHARACTERS) != 0);
 
 	if (visualizePhysics)
 		ccdPhysEnv->SetDebugMode(btIDebugDraw::DBG_DrawWireframe | btIDebugDraw::DBG_DrawAabb | btIDebugDraw::DBG_DrawContactPoints | btIDebugDraw::DBG_DrawText | btIDebugDraw::DBG_DrawConstraintLimits | btIDebugDraw::DBG_DrawConstraints);
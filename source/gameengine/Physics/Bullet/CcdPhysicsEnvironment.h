@@ -51,6 +51,26 @@ class btDynamicsWorld;
 class PHY_IVehicle;
 class CcdOverlapFilterCallBack;
 class CcdShapeConstructionInfo;
+class CcdCharacterBatch;
+class BlenderBulletCharacterController;
+
+class CcdCollData : public PHY_CollData
+{
+	const btPersistentManifold *m_manifoldPoint;
+public:
+	CcdCollData(const btPersistentManifold *manifoldPoint);
+	virtual ~CcdCollData();
+
+	virtual unsigned int GetNumContacts() const;
+	virtual MT_Vector3 GetLocalPointA(unsigned int index, bool first) const;
+	virtual MT_Vector3 GetLocalPointB(unsigned int index, bool first) const;
+	virtual MT_Vector3 GetWorldPoint(unsigned int index, bool first) const;
+	virtual MT_Vector3 GetNormal(unsigned int index, bool first) const;
+	virtual float GetCombinedFriction(unsigned int index, bool first) const;
+	virtual float GetCombinedRollingFriction(unsigned int index, bool first) const;
+	virtual float GetCombinedRestitution(unsigned int index, bool first) const;
+	virtual float GetAppliedImpulse(unsigned int index, bool first) const;
+};
 
 /** CcdPhysicsEnvironment is an experimental mainloop for physics simulation using optional continuous collision detection.
  * Physics Environment takes care of stepping the simulation and is a container for physics entities.
@@ -94,6 +114,11 @@ protected:
 	float m_angularDeactivationThreshold;
 	float m_contactBreakingThreshold;
 
+	/** Contact data of the collisions reported by the last step, kept until the next
+	 * step because the collision callbacks are processed by the logic in between.
+	 */
+	std::vector<CcdCollData> m_collData;
+
 	void ProcessFhSprings(double curTime, float timeStep);
 
 public:
@@ -125,6 +150,7 @@ public:
 	virtual void SetSolverDamping(float damping);
 	virtual void SetLinearAirDamping(float damping);
 	virtual void SetUseEpa(bool epa);
+	virtual void SetCharacterBatching(bool batching);
 
 	virtual int GetNumTimeSubSteps()
 	{
@@ -146,6 +172,12 @@ public:
 	static void StaticSimulationSubtickCallback(btDynamicsWorld *world, btScalar timeStep);
 	void SimulationSubtickCallback(btScalar timeStep);
 
+	/** Step all the batched character controllers, called by the character batch action.
+	 * The penetration recovery is done first for all the characters, then the sweeps
+	 * of the characters are run in parallel.
+	 */
+	void UpdateCharacters(btCollisionWorld *collisionWorld, btScalar timeStep);
+
 	virtual void DebugDrawWorld();
 //		virtual bool		proceedDeltaTimeOneStep(float timeStep);
 
@@ -189,6 +221,7 @@ public:
 	virtual PHY_IPhysicsController *RayTest(PHY_IRayCastFilterCallback &filterCallback, float fromX, float fromY, float fromZ, float toX, float toY, float toZ);
 	virtual bool CullingTest(PHY_CullingCallback callback, void *userData, const std::array<MT_Vector4, 6>& planes,
 							 int occlusionRes, const int *viewport, const MT_Matrix4x4& matrix);
+	virtual PHY_IGraphicController *CreateGraphicController(PHY_IMotionState *motionState);
 
 
 	//Methods for gamelogic collision/physics callbacks
@@ -200,6 +233,7 @@ public:
 	//These two methods are used *solely* to create controllers for Near/Radar sensor! Don't use for anything else
 	virtual PHY_IPhysicsController *CreateSphereController(float radius, const MT_Vector3& position);
 	virtual PHY_IPhysicsController *CreateConeController(float coneradius, float coneheight);
+	virtual void ContactTest(PHY_IPhysicsController *ctrl, std::vector<PHY_IPhysicsController *>& controllers);
 
 	virtual int GetNumContactPoints();
 
@@ -277,6 +311,14 @@ protected:
 
 	std::vector<WrapperVehicle *>    m_wrapperVehicles;
 
+	/// Action stepping the characters in one batch, nullptr when the characters are stepped separately.
+	CcdCharacterBatch *m_characterBatch;
+	/// Characters stepped by m_characterBatch.
+	std::vector<BlenderBulletCharacterController *> m_batchedCharacters;
+
+	void AddCharacter(BlenderBulletCharacterController *character);
+	void RemoveCharacter(BlenderBulletCharacterController *character);
+
 	/** use explicit btSoftRigidDynamicsWorld/btDiscreteDynamicsWorld* so that we have access to
 	 * btDiscreteDynamicsWorld::addRigidBody(body,filter,group)
 	 * so that we can set the body collision filter/group at the time of creation
@@ -299,22 +341,4 @@ protected:
 	virtual void ExportFile(const std::string& filename);
 };
 
-class CcdCollData : public PHY_CollData
-{
-	const btPersistentManifold *m_manifoldPoint;
-public:
-	CcdCollData(const btPersistentManifold *manifoldPoint);
-	virtual ~CcdCollData();
-
-	virtual unsigned int GetNumContacts() const;
-	virtual MT_Vector3 GetLocalPointA(unsigned int index, bool first) const;
-	virtual MT_Vector3 GetLocalPointB(unsigned int index, bool first) const;
-	virtual MT_Vector3 GetWorldPoint(unsigned int index, bool first) const;
-	virtual MT_Vector3 GetNormal(unsigned int index, bool first) const;
-	virtual float GetCombinedFriction(unsigned int index, bool first) const;
-	virtual float GetCombinedRollingFriction(unsigned int index, bool first) const;
-	virtual float GetCombinedRestitution(unsigned int index, bool first) const;
-	virtual float GetAppliedImpulse(unsigned int index, bool first) const;
-};
-
 #endif  /* __CCDPHYSICSENVIRONMENT_H__ */
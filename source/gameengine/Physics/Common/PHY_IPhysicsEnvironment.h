@@ -39,12 +39,14 @@
 #include "MT_Vector4.h"
 
 #include <array>
+#include <vector>
 
 class PHY_IConstraint;
 class PHY_IVehicle;
 class PHY_ICharacter;
 class RAS_MeshObject;
 class PHY_IPhysicsController;
+class PHY_IGraphicController;
 
 class RAS_MeshObject;
 struct DerivedMesh;
@@ -186,6 +188,10 @@ public:
 	virtual void SetUseEpa(bool epa)
 	{
 	}
+	/// step all the character controllers in one multithreaded pass
+	virtual void SetCharacterBatching(bool batching)
+	{
+	}
 
 	virtual void SetGravity(float x, float y, float z) = 0;
 	virtual void GetGravity(MT_Vector3& grav) = 0;
@@ -214,6 +220,10 @@ public:
 	// the near plane must be the first one and must always be present, it is used to get the direction of the view
 	virtual bool CullingTest(PHY_CullingCallback callback, void *userData, const std::array<MT_Vector4, 6>& planes,
 							 int occlusionRes, const int *viewport, const MT_Matrix4x4& matrix) = 0;
+	/** Create a graphic controller for the culling tree, the controller owns the motion state.
+	 * Return nullptr if the environment doesn't cull, the motion state is then left to the caller.
+	 */
+	virtual PHY_IGraphicController *CreateGraphicController(PHY_IMotionState *motionState) = 0;
 
 	// Methods for gamelogic collision/physics callbacks
 	virtual void AddSensor(PHY_IPhysicsController *ctrl) = 0;
@@ -224,6 +234,10 @@ public:
 	//These two methods are *solely* used to create controllers for sensor! Don't use for anything else
 	virtual PHY_IPhysicsController *CreateSphereController(float radius, const MT_Vector3& position) = 0;
 	virtual PHY_IPhysicsController *CreateConeController(float coneradius, float coneheight) = 0;
+	/** Find the controllers touching the shape of a sensor controller which is not registered
+	 * in the physics world, the pairs are filtered as in the broadphase of the sensor controllers.
+	 */
+	virtual void ContactTest(PHY_IPhysicsController *ctrl, std::vector<PHY_IPhysicsController *>& controllers) = 0;
 
 	virtual void ExportFile(const std::string& filename)
 	{
@@ -87,6 +87,10 @@ public:
 	{
 		return false;
 	}
+	virtual PHY_IGraphicController *CreateGraphicController(PHY_IMotionState *motionState)
+	{
+		return nullptr;
+	}
 
 	//gamelogic callbacks
 	virtual void AddSensor(PHY_IPhysicsController *ctrl)
@@ -114,6 +118,9 @@ public:
 	{
 		return nullptr;
 	}
+	virtual void ContactTest(PHY_IPhysicsController *ctrl, std::vector<PHY_IPhysicsController *>& controllers)
+	{
+	}
 
 	virtual void MergeEnvironment(PHY_IPhysicsEnvironment *other_env)
 	{
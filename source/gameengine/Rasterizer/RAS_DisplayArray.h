@@ -143,6 +143,8 @@ public:
 		for (unsigned int i = 0; i < size; ++i) {
 			m_vertexPtrs[i] = (RAS_ITexVert *)&m_vertexes[i];
 		}
+
+		UpdateMemorySize(m_vertexes.capacity() * sizeof(Vertex));
 	}
 };
 
@@ -27,12 +27,15 @@
 #include "RAS_DisplayArray.h"
 #include "RAS_MeshObject.h"
 
+#include "CM_Memory.h"
+
 #include "GPU_glew.h"
 
 RAS_IDisplayArray::RAS_IDisplayArray(PrimitiveType type, const RAS_TexVertFormat& format)
 	:m_type(type),
 	m_modifiedFlag(NONE_MODIFIED),
-	m_format(format)
+	m_format(format),
+	m_memorySize(0)
 {
 }
 
@@ -41,12 +44,25 @@ RAS_IDisplayArray::RAS_IDisplayArray(const RAS_IDisplayArray& other)
 	m_modifiedFlag(other.m_modifiedFlag),
 	m_format(other.m_format),
 	m_vertexInfos(other.m_vertexInfos),
-	m_indices(other.m_indices)
+	m_indices(other.m_indices),
+	m_memorySize(0)
 {
 }
 
 RAS_IDisplayArray::~RAS_IDisplayArray()
 {
+	CM_MemoryRemove(CM_MEMORY_DISPLAY_ARRAY, m_memorySize);
+}
+
+void RAS_IDisplayArray::UpdateMemorySize(size_t vertexSize)
+{
+	const size_t size = vertexSize +
+		m_vertexInfos.capacity() * sizeof(RAS_TexVertInfo) +
+		m_vertexPtrs.capacity() * sizeof(RAS_ITexVert *) +
+		m_indices.capacity() * sizeof(unsigned int);
+
+	CM_MemoryUpdate(CM_MEMORY_DISPLAY_ARRAY, m_memorySize, size);
+	m_memorySize = size;
 }
 
 #define NEW_DISPLAY_ARRAY_UV(vertformat, uv, color, primtype) \
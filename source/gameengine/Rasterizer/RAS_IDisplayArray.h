@@ -59,9 +59,14 @@ protected:
 	std::vector<RAS_ITexVert *> m_vertexPtrs;
 	/// The indices used for rendering.
 	std::vector<unsigned int> m_indices;
+	/// The memory size of the arrays accounted in CM_MEMORY_DISPLAY_ARRAY.
+	size_t m_memorySize;
 
 	RAS_IDisplayArray(const RAS_IDisplayArray& other);
 
+	/// Update the accounted memory size with the capacity of the arrays, vertexSize is the capacity of the vertex array.
+	void UpdateMemorySize(size_t vertexSize);
+
 public:
 	RAS_IDisplayArray(PrimitiveType type, const RAS_TexVertFormat& format);
 	virtual ~RAS_IDisplayArray();
@@ -182,17 +182,6 @@ RAS_OpenGLRasterizer::~RAS_OpenGLRasterizer()
 {
 }
 
-unsigned short RAS_OpenGLRasterizer::GetNumLights() const
-{
-	int numlights = 0;
-	glGetIntegerv(GL_MAX_LIGHTS, (GLint *)&numlights);
-
-	if (numlights > 8) {
-		return 8;
-	}
-	return numlights;
-}
-
 void RAS_OpenGLRasterizer::Enable(RAS_Rasterizer::EnableBit bit)
 {
 	glEnable(openGLEnableBitEnums[bit]);
@@ -268,7 +257,10 @@ void RAS_OpenGLRasterizer::SetColorMask(bool r, bool g, bool b, bool a)
 
 void RAS_OpenGLRasterizer::DrawOverlayPlane()
 {
-	m_screenPlane.Render();
+	if (!m_screenPlane) {
+		m_screenPlane.reset(new ScreenPlane());
+	}
+	m_screenPlane->Render();
 }
 
 void RAS_OpenGLRasterizer::SetViewport(int x, int y, int width, int height)
@@ -58,8 +58,8 @@ private:
 		void Render();
 	};
 
-	/// Class used to render a screen plane.
-	ScreenPlane m_screenPlane;
+	/// Class used to render a screen plane, created at the first use to not require a GPU context before.
+	std::unique_ptr<ScreenPlane> m_screenPlane;
 
 	RAS_Rasterizer *m_rasterizer;
 
@@ -67,8 +67,6 @@ public:
 	RAS_OpenGLRasterizer(RAS_Rasterizer *rasterizer);
 	virtual ~RAS_OpenGLRasterizer();
 
-	unsigned short GetNumLights() const;
-
 	void Enable(RAS_Rasterizer::EnableBit bit);
 	void Disable(RAS_Rasterizer::EnableBit bit);
 
@@ -38,23 +38,27 @@
 static CM_ThreadMutex scheduleMutex;
 static CM_ThreadMutex transformMutex;
 
-SG_Node::SG_Node(void *clientobj, void *clientinfo, SG_Callbacks& callbacks)
+SG_Node::SG_Node(void *clientobj, void *clientinfo, SG_Callbacks& callbacks,
+				 const std::shared_ptr<SG_TransformStore>& transformStore)
 	:SG_QList(),
 	m_SGclientObject(clientobj),
 	m_SGclientInfo(clientinfo),
 	m_callbacks(callbacks),
 	m_SGparent(nullptr),
-	m_localPosition(0.0f, 0.0f, 0.0f),
-	m_localRotation(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f),
-	m_localScaling(1.0f, 1.0f, 1.0f),
-	m_worldPosition(0.0f, 0.0f, 0.0f),
-	m_worldRotation(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f),
-	m_worldScaling(1.0f, 1.0f, 1.0f),
+	m_transformStore(transformStore),
+	m_hasPrevWorldTransform(false),
 	m_parent_relation(nullptr),
 	m_familly(new SG_Familly()),
 	m_modified(true),
 	m_dirty(DIRTY_NONE)
 {
+	m_transform = m_transformStore->Allocate();
+	m_transform.LocalPosition().setValue(0.0f, 0.0f, 0.0f);
+	m_transform.LocalRotation().setIdentity();
+	m_transform.LocalScaling().setValue(1.0f, 1.0f, 1.0f);
+	m_transform.WorldPosition().setValue(0.0f, 0.0f, 0.0f);
+	m_transform.WorldRotation().setIdentity();
+	m_transform.WorldScaling().setValue(1.0f, 1.0f, 1.0f);
 }
 
 SG_Node::SG_Node(const SG_Node & other)
@@ -64,16 +68,20 @@ SG_Node::SG_Node(const SG_Node & other)
 	m_callbacks(other.m_callbacks),
 	m_children(other.m_children),
 	m_SGparent(other.m_SGparent),
-	m_localPosition(other.m_localPosition),
-	m_localRotation(other.m_localRotation),
-	m_localScaling(other.m_localScaling),
-	m_worldPosition(other.m_worldPosition),
-	m_worldRotation(other.m_worldRotation),
-	m_worldScaling(other.m_worldScaling),
+	m_transformStore(other.m_transformStore),
+	// The replica starts at its current transform, nothing to interpolate from.
+	m_hasPrevWorldTransform(false),
 	m_parent_relation(other.m_parent_relation->NewCopy()),
 	m_familly(new SG_Familly()),
 	m_dirty(DIRTY_NONE)
 {
+	m_transform = m_transformStore->Allocate();
+	m_transform.LocalPosition() = other.m_transform.LocalPosition();
+	m_transform.LocalRotation() = other.m_transform.LocalRotation();
+	m_transform.LocalScaling() = other.m_transform.LocalScaling();
+	m_transform.WorldPosition() = other.m_transform.WorldPosition();
+	m_transform.WorldRotation() = other.m_transform.WorldRotation();
+	m_transform.WorldScaling() = other.m_transform.WorldScaling();
 }
 
 SG_Node::~SG_Node()
@@ -83,6 +91,8 @@ SG_Node::~SG_Node()
 	for (contit = m_SGcontrollers.begin(); contit != m_SGcontrollers.end(); ++contit) {
 		delete (*contit);
 	}
+
+	m_transformStore->Free(m_transform);
 }
 
 SG_Node *SG_Node::GetSGReplica()
@@ -445,14 +455,14 @@ bool SG_Node::UpdateSpatialData(const SG_Node *parent, double time, bool& parent
 void SG_Node::RelativeTranslate(const MT_Vector3& trans, const SG_Node *parent, bool local)
 {
 	if (local) {
-		m_localPosition += m_localRotation * trans;
+		m_transform.LocalPosition() += m_transform.LocalRotation() * trans;
 	}
 	else {
 		if (parent) {
-			m_localPosition += trans * parent->GetWorldOrientation();
+			m_transform.LocalPosition() += trans * parent->GetWorldOrientation();
 		}
 		else {
-			m_localPosition += trans;
+			m_transform.LocalPosition() += trans;
 		}
 	}
 	SetModified();
@@ -460,13 +470,13 @@ void SG_Node::RelativeTranslate(const MT_Vector3& trans, const SG_Node *parent,
 
 void SG_Node::SetLocalPosition(const MT_Vector3& trans)
 {
-	m_localPosition = trans;
+	m_transform.LocalPosition() = trans;
 	SetModified();
 }
 
 void SG_Node::SetWorldPosition(const MT_Vector3& trans)
 {
-	m_worldPosition = trans;
+	m_transform.WorldPosition() = trans;
 }
 
 /**
@@ -478,7 +488,7 @@ void SG_Node::SetWorldPosition(const MT_Vector3& trans)
  */
 void SG_Node::RelativeRotate(const MT_Matrix3x3& rot, bool local)
 {
-	m_localRotation = m_localRotation * (
+	m_transform.LocalRotation() = m_transform.LocalRotation() * (
 		local ?
 		rot
 		:
@@ -488,87 +498,110 @@ void SG_Node::RelativeRotate(const MT_Matrix3x3& rot, bool local)
 
 void SG_Node::SetLocalOrientation(const MT_Matrix3x3& rot)
 {
-	m_localRotation = rot;
+	m_transform.LocalRotation() = rot;
 	SetModified();
 }
 
 void SG_Node::SetLocalOrientation(const float *rot)
 {
-	m_localRotation.setValue(rot);
+	m_transform.LocalRotation().setValue(rot);
 	SetModified();
 }
 
 void SG_Node::SetWorldOrientation(const MT_Matrix3x3& rot)
 {
-	m_worldRotation = rot;
+	m_transform.WorldRotation() = rot;
 }
 
 void SG_Node::RelativeScale(const MT_Vector3& scale)
 {
-	m_localScaling = m_localScaling * scale;
+	m_transform.LocalScaling() = m_transform.LocalScaling() * scale;
 	SetModified();
 }
 
 void SG_Node::SetLocalScale(const MT_Vector3& scale)
 {
-	m_localScaling = scale;
+	m_transform.LocalScaling() = scale;
 	SetModified();
 }
 
 void SG_Node::SetWorldScale(const MT_Vector3& scale)
 {
-	m_worldScaling = scale;
+	m_transform.WorldScaling() = scale;
 }
 
 const MT_Vector3& SG_Node::GetLocalPosition() const
 {
-	return m_localPosition;
+	return m_transform.LocalPosition();
 }
 
 const MT_Matrix3x3& SG_Node::GetLocalOrientation() const
 {
-	return m_localRotation;
+	return m_transform.LocalRotation();
 }
 
 const MT_Vector3& SG_Node::GetLocalScale() const
 {
-	return m_localScaling;
+	return m_transform.LocalScaling();
 }
 
 const MT_Vector3& SG_Node::GetWorldPosition() const
 {
-	return m_worldPosition;
+	return m_transform.WorldPosition();
 }
 
 const MT_Matrix3x3& SG_Node::GetWorldOrientation() const
 {
-	return m_worldRotation;
+	return m_transform.WorldRotation();
 }
 
 const MT_Vector3& SG_Node::GetWorldScaling() const
 {
-	return m_worldScaling;
+	return m_transform.WorldScaling();
 }
 
 void SG_Node::SetWorldFromLocalTransform()
 {
-	m_worldPosition = m_localPosition;
-	m_worldScaling = m_localScaling;
-	m_worldRotation = m_localRotation;
+	m_transform.WorldPosition() = m_transform.LocalPosition();
+	m_transform.WorldScaling() = m_transform.LocalScaling();
+	m_transform.WorldRotation() = m_transform.LocalRotation();
 }
 
 MT_Transform SG_Node::GetWorldTransform() const
 {
-	return MT_Transform(m_worldPosition,
-	                    m_worldRotation.scaled(
-							m_worldScaling[0], m_worldScaling[1], m_worldScaling[2]));
+	const MT_Vector3& scaling = m_transform.WorldScaling();
+	return MT_Transform(m_transform.WorldPosition(),
+	                    m_transform.WorldRotation().scaled(scaling[0], scaling[1], scaling[2]));
 }
 
 MT_Transform SG_Node::GetLocalTransform() const
 {
-	return MT_Transform(m_localPosition,
-	                    m_localRotation.scaled(
-							m_localScaling[0], m_localScaling[1], m_localScaling[2]));
+	const MT_Vector3& scaling = m_transform.LocalScaling();
+	return MT_Transform(m_transform.LocalPosition(),
+	                    m_transform.LocalRotation().scaled(scaling[0], scaling[1], scaling[2]));
+}
+
+void SG_Node::SavePreviousWorldTransform()
+{
+	m_prevWorldPosition = m_transform.WorldPosition();
+	m_prevWorldRotation = m_transform.WorldRotation().getRotation();
+	m_prevWorldScaling = m_transform.WorldScaling();
+	m_hasPrevWorldTransform = true;
+}
+
+void SG_Node::GetInterpolatedWorldTransform(MT_Scalar factor, MT_Vector3& position, MT_Matrix3x3& rotation,
+											MT_Vector3& scaling) const
+{
+	if (!m_hasPrevWorldTransform || factor >= 1.0f) {
+		position = m_transform.WorldPosition();
+		rotation = m_transform.WorldRotation();
+		scaling = m_transform.WorldScaling();
+		return;
+	}
+
+	position = MT_lerp(m_prevWorldPosition, m_transform.WorldPosition(), factor);
+	rotation.setRotation(m_prevWorldRotation.slerp(m_transform.WorldRotation().getRotation(), factor));
+	scaling = MT_lerp(m_prevWorldScaling, m_transform.WorldScaling(), factor);
 }
 
 bool SG_Node::ComputeWorldTransforms(const SG_Node *parent, bool& parentUpdated)
@@ -34,6 +34,7 @@
 
 #include "SG_QList.h"
 #include "SG_ParentRelation.h"
+#include "SG_TransformStore.h"
 
 #include "MT_Transform.h"
 
@@ -115,7 +116,8 @@ public:
 		DIRTY_CULLING = (1 << 1)
 	};
 
-	SG_Node(void *clientobj, void *clientinfo, SG_Callbacks& callbacks);
+	SG_Node(void *clientobj, void *clientinfo, SG_Callbacks& callbacks,
+			const std::shared_ptr<SG_TransformStore>& transformStore);
 	SG_Node(const SG_Node & other);
 	virtual ~SG_Node();
 
@@ -339,6 +341,14 @@ public:
 	MT_Transform GetWorldTransform() const;
 	MT_Transform GetLocalTransform() const;
 
+	/// Store the current world transform as the transform of the previous logic frame.
+	void SavePreviousWorldTransform();
+	/** Blend the world transforms of the previous and current logic frames.
+	 * \param factor 0 for the previous transform, 1 for the current transform.
+	 */
+	void GetInterpolatedWorldTransform(MT_Scalar factor, MT_Vector3& position, MT_Matrix3x3& rotation,
+									   MT_Vector3& scaling) const;
+
 	bool ComputeWorldTransforms(const SG_Node *parent, bool& parentUpdated);
 
 	const std::shared_ptr<SG_Familly>& GetFamilly() const;
@@ -386,13 +396,16 @@ private:
 	 */
 	SG_Node *m_SGparent;
 
-	MT_Vector3 m_localPosition;
-	MT_Matrix3x3 m_localRotation;
-	MT_Vector3 m_localScaling;
+	/// Store of the scene the node was created in, shared by its replicas.
+	std::shared_ptr<SG_TransformStore> m_transformStore;
+	/// Local and world transforms, stored contiguously with the transforms of the other nodes.
+	SG_TransformStore::Slot m_transform;
 
-	MT_Vector3 m_worldPosition;
-	MT_Matrix3x3 m_worldRotation;
-	MT_Vector3 m_worldScaling;
+	/// World transform of the previous logic frame, used for render interpolation.
+	MT_Vector3 m_prevWorldPosition;
+	MT_Quaternion m_prevWorldRotation;
+	MT_Vector3 m_prevWorldScaling;
+	bool m_hasPrevWorldTransform;
 
 	std::unique_ptr<SG_ParentRelation> m_parent_relation;
 
@@ -0,0 +1,94 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/SceneGraph/SG_TransformStore.cpp
+ *  \ingroup bgesg
+ */
+
+#include "SG_TransformStore.h"
+
+#include <algorithm>
+#include <functional>
+
+SG_TransformStore::SG_TransformStore()
+	:m_lastBlockUsed(SG_TRANSFORM_BLOCK_SIZE),
+	m_numSlots(0)
+{
+}
+
+SG_TransformStore::~SG_TransformStore()
+{
+	for (Block *block : m_blocks) {
+		delete block;
+	}
+}
+
+SG_TransformStore::Slot SG_TransformStore::Allocate()
+{
+	m_lock.Lock();
+
+	Slot slot;
+	if (!m_freeSlots.empty()) {
+		std::pop_heap(m_freeSlots.begin(), m_freeSlots.end(), std::greater<unsigned int>());
+		const unsigned int number = m_freeSlots.back();
+		m_freeSlots.pop_back();
+
+		slot.m_block = m_blocks[number / SG_TRANSFORM_BLOCK_SIZE];
+		slot.m_index = number % SG_TRANSFORM_BLOCK_SIZE;
+	}
+	else {
+		if (m_lastBlockUsed == SG_TRANSFORM_BLOCK_SIZE) {
+			Block *block = new Block();
+			block->m_first = m_blocks.size() * SG_TRANSFORM_BLOCK_SIZE;
+			m_blocks.push_back(block);
+			m_lastBlockUsed = 0;
+		}
+		slot.m_block = m_blocks.back();
+		slot.m_index = m_lastBlockUsed++;
+	}
+	++m_numSlots;
+
+	m_lock.Unlock();
+
+	return slot;
+}
+
+void SG_TransformStore::Free(const Slot& slot)
+{
+	m_lock.Lock();
+
+	if (--m_numSlots == 0) {
+		// No more nodes, release the memory of the blocks.
+		for (Block *block : m_blocks) {
+			delete block;
+		}
+		m_blocks.clear();
+		m_freeSlots.clear();
+		m_lastBlockUsed = SG_TRANSFORM_BLOCK_SIZE;
+	}
+	else {
+		m_freeSlots.push_back(slot.m_block->m_first + slot.m_index);
+		std::push_heap(m_freeSlots.begin(), m_freeSlots.end(), std::greater<unsigned int>());
+	}
+
+	m_lock.Unlock();
+}
@@ -0,0 +1,121 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file SG_TransformStore.h
+ *  \ingroup bgesg
+ */
+
+#ifndef __SG_TRANSFORMSTORE_H__
+#define __SG_TRANSFORMSTORE_H__
+
+#include "MT_Vector3.h"
+#include "MT_Matrix3x3.h"
+
+#include "CM_Thread.h"
+
+#include <vector>
+
+/// Number of transforms per block of the store.
+#define SG_TRANSFORM_BLOCK_SIZE 256
+
+/** Local and world transforms of the scene graph nodes stored as structure of arrays.
+ * Each scene owns a store, the nodes keep a shared reference to it as they can outlive
+ * their scene when merged into another one by LibLoad.
+ * The transforms are allocated in fixed size blocks which are never moved, a node keeps
+ * the slot of its transform for its whole life. The lowest free slot is always allocated
+ * first, the live transforms stay packed at the front of the store and the nodes allocated
+ * together, as the objects of a converted scene or a replicated hierarchy, use contiguous slots.
+ */
+class SG_TransformStore
+{
+public:
+	struct Block
+	{
+		/// Number of the first slot of the block in the store.
+		unsigned int m_first;
+
+		MT_Vector3 m_localPosition[SG_TRANSFORM_BLOCK_SIZE];
+		MT_Matrix3x3 m_localRotation[SG_TRANSFORM_BLOCK_SIZE];
+		MT_Vector3 m_localScaling[SG_TRANSFORM_BLOCK_SIZE];
+
+		MT_Vector3 m_worldPosition[SG_TRANSFORM_BLOCK_SIZE];
+		MT_Matrix3x3 m_worldRotation[SG_TRANSFORM_BLOCK_SIZE];
+		MT_Vector3 m_worldScaling[SG_TRANSFORM_BLOCK_SIZE];
+	};
+
+	/// Transform of a node in the store.
+	struct Slot
+	{
+		Block *m_block;
+		unsigned int m_index;
+
+		inline MT_Vector3& LocalPosition() const
+		{
+			return m_block->m_localPosition[m_index];
+		}
+		inline MT_Matrix3x3& LocalRotation() const
+		{
+			return m_block->m_localRotation[m_index];
+		}
+		inline MT_Vector3& LocalScaling() const
+		{
+			return m_block->m_localScaling[m_index];
+		}
+		inline MT_Vector3& WorldPosition() const
+		{
+			return m_block->m_worldPosition[m_index];
+		}
+		inline MT_Matrix3x3& WorldRotation() const
+		{
+			return m_block->m_worldRotation[m_index];
+		}
+		inline MT_Vector3& WorldScaling() const
+		{
+			return m_block->m_worldScaling[m_index];
+		}
+	};
+
+private:
+	std::vector<Block *> m_blocks;
+	/// Min heap of the numbers of the freed slots, reused before the unused slots of the last block.
+	std::vector<unsigned int> m_freeSlots;
+	/// Number of slots ever used in the last block.
+	unsigned int m_lastBlockUsed;
+	/// Number of allocated slots.
+	unsigned int m_numSlots;
+
+	/// The nodes of a scene being converted by LibLoad are created in a worker thread.
+	CM_ThreadSpinLock m_lock;
+
+public:
+	SG_TransformStore();
+	~SG_TransformStore();
+
+	SG_TransformStore(const SG_TransformStore& other) = delete;
+
+	/// Allocate the uninitialized transform of a node.
+	Slot Allocate();
+	/// Release the transform of a node, the blocks are freed once all the slots are released.
+	void Free(const Slot& slot);
+};
+
+#endif  // __SG_TRANSFORMSTORE_H__
@@ -48,6 +48,8 @@ extern "C" {
 
 #include "Exception.h"
 
+#include "CM_Memory.h"
+
 #if (defined(WIN32) || defined(WIN64))
 #define strcasecmp	_stricmp
 #endif
@@ -80,6 +82,7 @@ ImageBase::~ImageBase (void)
 	// release image
 	if (m_image)
 		MEM_freeN(m_image);
+	CM_MemoryRemove(CM_MEMORY_VIDEO, m_imgSize * sizeof(unsigned int));
 }
 
 
@@ -248,6 +251,7 @@ void ImageBase::init (short width, short height)
 		if (newSize > m_imgSize)
 		{
 			// set new buffer size
+			CM_MemoryUpdate(CM_MEMORY_VIDEO, m_imgSize * sizeof(unsigned int), newSize * sizeof(unsigned int));
 			m_imgSize = newSize;
 			// release previous and create new buffer
 			if (m_image)
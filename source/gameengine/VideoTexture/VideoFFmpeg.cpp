@@ -48,6 +48,7 @@
 
 #include "VideoFFmpeg.h"
 #include "Exception.h"
+#include "CM_Memory.h"
 
 
 // default framerate
@@ -66,7 +67,8 @@ m_frame(nullptr), m_frameDeinterlaced(nullptr), m_frameRGB(nullptr), m_imgConver
 m_deinterlace(false), m_preseek(0),	m_videoStream(-1), m_baseFrameRate(25.0),
 m_lastFrame(-1),  m_eof(false), m_externTime(false), m_curPosition(-1), m_startTime(0), 
 m_captWidth(0), m_captHeight(0), m_captRate(0.f), m_isImage(false),
-m_isThreaded(false), m_isStreaming(false), m_stopThread(false), m_cacheStarted(false)
+m_isThreaded(false), m_isStreaming(false), m_stopThread(false), m_cacheStarted(false),
+m_cacheMemorySize(0)
 {
 	// set video format
 	m_format = RGB24;
@@ -467,6 +469,9 @@ bool VideoFFmpeg::startCache()
 			CachePacket *packet = new CachePacket();
 			BLI_addtail(&m_packetCacheFree, packet);
 		}
+		m_cacheMemorySize = CACHE_FRAME_SIZE * avpicture_get_size((m_format == RGBA32) ? AV_PIX_FMT_RGBA : AV_PIX_FMT_RGB24,
+		                                                          m_codecCtx->width, m_codecCtx->height);
+		CM_MemoryAdd(CM_MEMORY_VIDEO, m_cacheMemorySize);
 		BLI_threadpool_init(&m_thread, cacheThread, 1);
 		BLI_threadpool_insert(&m_thread, this);
 		m_cacheStarted = true;
@@ -508,6 +513,8 @@ void VideoFFmpeg::stopCache()
 			BLI_remlink(&m_packetCacheFree, packet);
 			delete packet;
 		}
+		CM_MemoryRemove(CM_MEMORY_VIDEO, m_cacheMemorySize);
+		m_cacheMemorySize = 0;
 		m_cacheStarted = false;
 	}
 }
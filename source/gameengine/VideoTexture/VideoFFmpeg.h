@@ -198,6 +198,7 @@ private:
 
 	bool m_stopThread;
 	bool m_cacheStarted;
+	size_t m_cacheMemorySize;	// size of the cached frames accounted in CM_MEMORY_VIDEO
 	ListBase m_thread;
 	ListBase m_frameCacheBase;	// list of frames that are ready
 	ListBase m_frameCacheFree;	// list of frames that are unused